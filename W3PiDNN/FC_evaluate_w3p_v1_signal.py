@@ -23,6 +23,7 @@ Pass different arguments in the form --some-setup arg1='"string_val"' args2=floa
 )
 parser.add_argument('-i', '--input', required=True,          help='Input training directory, e.g. trainings/w3pDNN_v1'  )
 parser.add_argument('-n', '--maxN' , default=-1   , type=int, help='Max entries on which running the inference'  )
+parser.add_argument('-w', '--weights', default=None,           help='Plain-text weights of the model (FC_export_hls_v1.py --text): score the triplets natively in the RDataFrame instead of with Keras')
 
 args = parser.parse_args()
 
@@ -35,17 +36,23 @@ time python3 FC_evaluate_w3p_v1_signal.py \
 time python3 FC_evaluate_w3p_v1_signal.py \
   --input prunings/w3pDNN_v20_p1 \
   --maxN 10000
+
+time python3 FC_evaluate_w3p_v1_signal.py \
+  --input   trainings/w3pDNN_v20 \
+  --weights trainings/w3pDNN_v20/weights.txt \
+  --maxN 10000
 '''
 
 start_time = time.time()
 
 # ----- Load trained model -----
-# Load model
+# Load model (the native engine reads its weights when adding the scores)
 model_name = args.input
-my_model = tf.keras.models.load_model(model_name)
+if args.weights is None:
+    my_model = tf.keras.models.load_model(model_name)
 
-# Print a summary of the loaded model
-my_model.summary()
+    # Print a summary of the loaded model
+    my_model.summary()
 model_time = time.time()
 
 # ----- Evaluate on a sample -----
@@ -84,55 +91,48 @@ frame = frame.Define('myrow', 'rdfentry_')
 print('Prepared RDF entries:', frame.Count().GetValue())
 prepareRDF_time = time.time()
 
-# Transform in Pandas DF to run inference 
-frame_numpyzed = frame.AsNumpy()
-print('Numpyzed RDF')
-numpyze_time = time.time()
+if args.weights is not None:
+    # Add scores to the RDF, computed in the event loop
+    frame = add_dnn_scores(frame, args.weights)
+    print('Added native predictions to RDF')
+    numpyze_time = pandasDF_time = predictions_time = time.time()
+else:
+    # Transform in Pandas DF to run inference 
+    frame_numpyzed = frame.AsNumpy()
+    print('Numpyzed RDF')
+    numpyze_time = time.time()
 
-pdframe = pd.DataFrame.from_dict(frame_numpyzed)
-print('Transformed into PandasDF')
-pandasDF_time = time.time()
+    pdframe = pd.DataFrame.from_dict(frame_numpyzed)
+    print('Transformed into PandasDF')
+    pandasDF_time = time.time()
 
-# Loop on each event to get NN scores for each triplet for each event
-all_predictions_map = {}
-for index, event in pdframe.iterrows():
+    # Loop on each event to get NN scores for each triplet for each event
+    all_predictions_map = {}
+    for index, event in pdframe.iterrows():
 
-    # Get inputs to evaluate NN from each triplet
-    inputs = get_triplets_inputs(event)
+        # Get inputs to evaluate NN from each triplet
+        inputs = get_triplets_inputs(event)
 
-    # Get precions for each triplet
-    predictions = []
-    for inp in inputs:
-        predictions.append( my_model(inp) )
+        # Get precions for each triplet
+        predictions = []
+        for inp in inputs:
+            predictions.append( my_model(inp) )
 
-    predictions = np.concatenate(predictions).reshape((len(predictions),))
+        predictions = np.concatenate(predictions).reshape((len(predictions),))
 
-    all_predictions_map[event.myrow] = predictions
+        all_predictions_map[event.myrow] = predictions
 
-print('Predictions computed')
-predictions_time = time.time()
+    print('Predictions computed')
+    predictions_time = time.time()
 
-# ----- Evaluate targets -----
-# Targets:
-#  - Gen matching efficiency for signal
-#  - Estimate of background rejection efficiency (target should be around 1e-9)
+    # ----- Evaluate targets -----
+    # Targets:
+    #  - Gen matching efficiency for signal
+    #  - Estimate of background rejection efficiency (target should be around 1e-9)
 
-# Define to ROOT a map with the scores
-scoremap_snippet = '''
-std::map<int, std::vector<float>> scoremap;
-{}
-'''.format(
-    '\n'.join([
-            'scoremap.insert({%s,{%s}});' % (
-                str(key), ','.join([str(pred) for pred in all_predictions_map[key]])
-            ) for key in list(all_predictions_map.keys())
-        ])
-    )
-ROOT.gInterpreter.ProcessLine(scoremap_snippet)
-
-# Add scores to the RDF
-frame = frame.Define('triplet_scores', 'scoremap[myrow];')
-print('Added predictions to RDF')
+    # Add scores to the RDF (CSR buffers read without copy)
+    frame = add_triplet_scores(frame, list(all_predictions_map.keys()), list(all_predictions_map.values()))
+    print('Added predictions to RDF')
 add_predictions_time = time.time()
 
 # add size of triplets
@@ -0,0 +1,146 @@
+# General imports
+import os
+import sys ; sys.path.append(os.getcwd())
+import argparse
+import ast
+import random
+
+# Parse arguments
+parser = argparse.ArgumentParser('Export a trained w3pDNN model to the C++ header of the HLS DNN inference kernel.\n\
+The Normalization layer and the Dense layers (Dropout layers are skipped) are written as float constants,\n\
+converted to ap_fixed by the kernel and used as they are by the float reference.'
+)
+parser.add_argument('-i', '--input'   , default=None                                      , help='Input training directory, e.g. trainings/w3pDNN_v1'          )
+parser.add_argument('-s', '--setup'   , default='config/setup_v1.py'                      , help='Setup with the FEATURES list used in the training'           )
+parser.add_argument('-o', '--output'  , default='../W3Pi_HLS/dnn_inference/src/dnn_weights.h', help='Output C++ header'                                   )
+parser.add_argument('-r', '--random'  , default=None      , nargs='+', type=int           , help='No model: untrained placeholder with these hidden neurons'  )
+parser.add_argument('-t', '--text'    , default=None                                      , help='Also write the plain-text weights of the CPU engine (utils/DenseInference.h)')
+parser.add_argument(      '--seed'    , default=2023      , type=int                      , help='Seed of the placeholder weights'                              )
+args = parser.parse_args()
+
+# Example commands
+'''
+python3 FC_export_hls_v1.py \
+  --input  trainings/w3pDNN_v20 \
+  --setup  config/setup_v1.py \
+  --output ../W3Pi_HLS/dnn_inference/src/dnn_weights.h \
+  --text   trainings/w3pDNN_v20/weights.txt
+
+python3 FC_export_hls_v1.py \
+  --random 37 35 30 25 30 35
+'''
+
+assert (args.input is None) != (args.random is None), "Give either a training directory (--input) or placeholder neurons (--random)"
+
+# ----- Features -----
+# Read OUT_BRANCHES and FEATURES from the setup without importing it (no keras needed)
+def read_features(setup):
+  tree = ast.parse(open(setup).read())
+  scope = {}
+  for node in tree.body:
+    if isinstance(node, ast.Assign) and any(isinstance(t, ast.Name) and t.id in ('OUT_BRANCHES', 'FEATURES') for t in node.targets):
+      exec(compile(ast.Module(body=[node], type_ignores=[]), setup, 'exec'), scope)
+  return list(scope['FEATURES'])
+
+features = read_features(args.setup)
+
+# ----- Layers -----
+# layers: list of (weights[nin][nout], biases[nout]); mean/variance of the Normalization layer
+if args.input is not None:
+  import numpy as np
+  import tensorflow as tf
+
+  model = tf.keras.models.load_model(args.input)
+  model.summary()
+
+  mean, variance, layers = None, None, []
+  for layer in model.layers:
+    if isinstance(layer, tf.keras.layers.Normalization):
+      mean     = np.asarray(layer.mean    ).reshape(-1).tolist()
+      variance = np.asarray(layer.variance).reshape(-1).tolist()
+    elif isinstance(layer, tf.keras.layers.Dense):
+      w, b = layer.get_weights()
+      activation = layer.get_config()['activation']
+      layers.append((w.tolist(), b.tolist(), activation))
+    elif isinstance(layer, tf.keras.layers.Dropout):
+      continue
+    else:
+      sys.exit('Unsupported layer {} ({})'.format(layer.name, type(layer).__name__))
+
+  assert mean is not None, "No Normalization layer in the model"
+  assert all(a == 'relu' for _, _, a in layers[:-1]) and layers[-1][2] == 'sigmoid', "Expected ReLU hidden layers and a sigmoid output"
+  assert len(mean) == len(features), "The model has {} inputs, the setup {} features".format(len(mean), len(features))
+  source = 'model ' + args.input
+else:
+  # Untrained placeholder: glorot uniform weights, zero biases, and typical mean/std of the
+  # features (to keep the activations in range, also for the pdgId that the trained models
+  # do not normalize), only meant to build and test the kernel
+  rng = random.Random(args.seed)
+  sizes = [len(features)] + args.random + [1]
+  layers = []
+  for nin, nout in zip(sizes[:-1], sizes[1:]):
+    limit = (6.0 / (nin + nout)) ** 0.5
+    w = [[rng.uniform(-limit, limit) for o in range(nout)] for i in range(nin)]
+    layers.append((w, [0.0]*nout, 'relu' if nout > 1 else 'sigmoid'))
+  TYPICAL = { # prefix or name: (mean, std)
+    'pi0_pt': (30., 15.), 'pi1_pt': (20., 10.), 'pi2_pt': (12., 6.), 'iso': (0.3, 0.4), 'dR_': (1.0, 0.6),
+    'm_': (40., 20.), 'pt_': (30., 15.), 'dVz_': (0., 0.5), 'triplet_pt': (40., 20.), 'triplet_maxdR': (1.5, 0.7),
+    'triplet_mindR': (0.5, 0.3), 'triplet_maxdVz': (0.3, 0.4), 'triplet_mass': (70., 20.), 'pdgId': (0., 150.),
+  }
+  def typical(name):
+    for key, value in TYPICAL.items():
+      if name == key or key in name: return value
+    return (0., 1.)
+  mean     = [typical(f)[0]    for f in features]
+  variance = [typical(f)[1]**2 for f in features]
+  source = 'UNTRAINED PLACEHOLDER (--random {}, seed {}): export a trained model with --input'.format(' '.join(map(str, args.random)), args.seed)
+
+# Keras Normalization: (x - mean) / max(sqrt(variance), epsilon)
+scale = [1.0 / max(v**0.5, 1e-7) for v in variance]
+sizes = [len(features)] + [len(b) for _, b, _ in layers]
+
+# ----- Write the header -----
+def values(v, per_line=8):
+  v = ['{:.9g}'.format(float(x)) for x in v]
+  return ',\n'.join('    ' + ', '.join(v[i:i+per_line]) for i in range(0, len(v), per_line))
+
+with open(args.output, 'w') as out:
+  out.write('#ifndef DNN_WEIGHTS_H\n#define DNN_WEIGHTS_H\n\n')
+  out.write('// Generated by W3PiDNN/FC_export_hls_v1.py from the {}\n'.format(source))
+  out.write('// Features of {}\n\n'.format(args.setup))
+  out.write('#define DNN_NFEATURES {}\n'.format(len(features)))
+  out.write('#define DNN_NLAYERS {}\n\n'.format(len(layers)))
+  out.write('// Input features, in the order of the training\n')
+  out.write('static const char * const DNN_FEATURE_NAMES[DNN_NFEATURES] = {\n')
+  out.write(',\n'.join('    "{}"'.format(f) for f in features) + '\n};\n\n')
+  out.write('// Inputs, then outputs of each dense layer (ReLU, sigmoid for the last one)\n')
+  out.write('static constexpr int DNN_SIZES[DNN_NLAYERS+1] = {{{}}};\n\n'.format(', '.join(map(str, sizes))))
+  out.write('// Normalization layer: (x - mean) * scale\n')
+  out.write('template<typename T> struct DnnNorm { static const T mean[DNN_NFEATURES]; static const T scale[DNN_NFEATURES]; };\n')
+  out.write('template<typename T> const T DnnNorm<T>::mean[DNN_NFEATURES] = {{\n{}\n}};\n'.format(values(mean)))
+  out.write('template<typename T> const T DnnNorm<T>::scale[DNN_NFEATURES] = {{\n{}\n}};\n\n'.format(values(scale)))
+  out.write('// Dense layers: w[i*NOUT + o] from input i to output o, b[o]\n')
+  out.write('template<typename T, int L> struct DnnLayer;\n')
+  for l, (w, b, _) in enumerate(layers):
+    nin, nout = sizes[l], sizes[l+1]
+    out.write('template<typename T> struct DnnLayer<T, {0}> {{ static const T w[{1}*{2}]; static const T b[{2}]; }};\n'.format(l, nin, nout))
+    out.write('template<typename T> const T DnnLayer<T, {}>::w[{}*{}] = {{\n{}\n}};\n'.format(l, nin, nout, values([x for row in w for x in row])))
+    out.write('template<typename T> const T DnnLayer<T, {}>::b[{}] = {{\n{}\n}};\n'.format(l, nout, values(b)))
+  out.write('\n#endif\n')
+
+print('Written {}: {} features, layers {}'.format(args.output, len(features), ' '.join(map(str, sizes))))
+
+# ----- Plain-text weights -----
+# features <n> <names>, normalization <mean> <scale>, then per layer: dense <nin> <nout> <activation> <w[i][o]> <b>
+def plain(v, per_line=8):
+  v = ['{:.9g}'.format(float(x)) for x in v]
+  return '\n'.join(' '.join(v[i:i+per_line]) for i in range(0, len(v), per_line))
+
+if args.text is not None:
+  with open(args.text, 'w') as out:
+    out.write('# w3pDNN dense network exported by FC_export_hls_v1.py from the {}\n'.format(source))
+    out.write('features {} {}\n'.format(len(features), ' '.join(features)))
+    out.write('normalization\n{}\n{}\n'.format(plain(mean), plain(scale)))
+    for l, (w, b, activation) in enumerate(layers):
+      out.write('dense {} {} {}\n{}\n{}\n'.format(sizes[l], sizes[l+1], activation, plain([x for row in w for x in row]), plain(b)))
+  print('Written {}'.format(args.text))
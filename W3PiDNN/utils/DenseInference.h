@@ -0,0 +1,394 @@
+// ------------------------------------------------
+// Batched CPU inference of the w3pDNN (FCModel: Normalization, Dense layers)
+//
+// The network is read from the plain-text weights written by FC_export_hls_v1.py --text
+// and scores a batch of triplets at once: the (normalized) features of the batch are split
+// in blocks of BLOCK triplets, and each block goes through all the layers while it stays in
+// cache. Each dense layer is a small GEMM (block x nin) * (nin x nout), computed by tiles of
+// MR triplets x NR outputs kept in registers (AVX2/FMA when the CPU has them, plain loops
+// otherwise), the weights being padded to a multiple of NR outputs.
+//
+// - w3pdnn::DenseNetwork::predict(features, n, scores): n x nfeatures features in the order
+//   of features(), n scores
+// - dnn_load(name) and dnn_triplet_scores(triplet_idxs, L1Puppi_...): scores of all the
+//   triplets of an event, to be used in an RDataFrame Define (the features are computed
+//   from the candidates as in config/setup_v1.py, by name)
+// Compile with -DDENSE_INFERENCE_NO_ROOT to use the network without ROOT.
+
+#ifndef DENSE_INFERENCE_H
+#define DENSE_INFERENCE_H
+
+// ------------------------------------------------
+// General includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DENSE_INFERENCE_X86 1
+#else
+#define DENSE_INFERENCE_X86 0
+#endif
+
+namespace w3pdnn {
+
+    // Triplets per block, rows x columns of the register tiles
+    static constexpr int BLOCK = 256;
+    static constexpr int MR = 4;
+    static constexpr int NR = 16;
+
+    enum Activation { LINEAR, RELU, SIGMOID };
+
+    // ------------------------------------------------
+    // Dense layer, weights padded to ldw = nout rounded up to NR (zero weights and biases)
+    struct DenseLayer {
+        int nin = 0, nout = 0, ldw = 0;
+        Activation activation = LINEAR;
+        std::vector<float> w;   // w[i*ldw + o]
+        std::vector<float> b;   // b[o], ldw entries
+    };
+
+    // ------------------------------------------------
+    // out[r][o] = act(sum_i in[r][i] * w[i][o] + b[o]) for the rows r < nrows (multiple of MR)
+    inline void dense_tiles_scalar(const DenseLayer & l, const float * in, int ldin, float * out, int ldout, int nrows)
+    {
+        for (int r0 = 0; r0 < nrows; r0 += MR)
+            for (int c0 = 0; c0 < l.ldw; c0 += NR)
+            {
+                float acc[MR][NR];
+                for (int r = 0; r < MR; r++)
+                    for (int c = 0; c < NR; c++) acc[r][c] = l.b[c0 + c];
+                for (int i = 0; i < l.nin; i++)
+                {
+                    const float * wi = &l.w[size_t(i) * l.ldw + c0];
+                    for (int r = 0; r < MR; r++)
+                    {
+                        float x = in[size_t(r0 + r) * ldin + i];
+                        for (int c = 0; c < NR; c++) acc[r][c] += x * wi[c];
+                    }
+                }
+                for (int r = 0; r < MR; r++)
+                    for (int c = 0; c < NR; c++)
+                        out[size_t(r0 + r) * ldout + c0 + c] = (l.activation == RELU && acc[r][c] < 0) ? 0.f : acc[r][c];
+            }
+    }
+
+#if DENSE_INFERENCE_X86
+    __attribute__((target("avx2,fma")))
+    inline void dense_tiles_avx2(const DenseLayer & l, const float * in, int ldin, float * out, int ldout, int nrows)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        for (int r0 = 0; r0 < nrows; r0 += MR)
+            for (int c0 = 0; c0 < l.ldw; c0 += NR)
+            {
+                __m256 b0 = _mm256_loadu_ps(&l.b[c0]), b1 = _mm256_loadu_ps(&l.b[c0 + 8]);
+                __m256 acc[MR][2];
+                for (int r = 0; r < MR; r++) { acc[r][0] = b0; acc[r][1] = b1; }
+                const float * x = in + size_t(r0) * ldin;
+                for (int i = 0; i < l.nin; i++)
+                {
+                    const float * wi = &l.w[size_t(i) * l.ldw + c0];
+                    __m256 w0 = _mm256_loadu_ps(wi), w1 = _mm256_loadu_ps(wi + 8);
+                    for (int r = 0; r < MR; r++)
+                    {
+                        __m256 xr = _mm256_broadcast_ss(x + size_t(r) * ldin + i);
+                        acc[r][0] = _mm256_fmadd_ps(xr, w0, acc[r][0]);
+                        acc[r][1] = _mm256_fmadd_ps(xr, w1, acc[r][1]);
+                    }
+                }
+                for (int r = 0; r < MR; r++)
+                {
+                    if (l.activation == RELU) { acc[r][0] = _mm256_max_ps(acc[r][0], zero); acc[r][1] = _mm256_max_ps(acc[r][1], zero); }
+                    _mm256_storeu_ps(out + size_t(r0 + r) * ldout + c0, acc[r][0]);
+                    _mm256_storeu_ps(out + size_t(r0 + r) * ldout + c0 + 8, acc[r][1]);
+                }
+            }
+    }
+
+    inline bool has_avx2_fma()
+    {
+        static const bool ok = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        return ok;
+    }
+#endif
+
+    // ------------------------------------------------
+    // Network: normalization (x - mean) * scale, then the dense layers
+    class DenseNetwork {
+      public:
+        // Read the weights written by FC_export_hls_v1.py --text
+        bool load(const std::string & name)
+        {
+            std::ifstream file(name);
+            if (!file) { std::cerr << "DenseNetwork: cannot open " << name << std::endl; return false; }
+            std::stringstream in;
+            for (std::string line; std::getline(file, line); )
+                if (line.empty() || line[0] != '#') in << line << '\n';
+
+            features_.clear(); layers_.clear();
+            std::string key;
+            int nfeatures = 0;
+            if (!(in >> key >> nfeatures) || key != "features" || nfeatures <= 0) return error(name, "features");
+            features_.resize(nfeatures);
+            mean_.resize(nfeatures); scale_.resize(nfeatures);
+            for (auto & f : features_) in >> f;
+            if (!(in >> key) || key != "normalization") return error(name, "normalization");
+            for (auto & m : mean_) in >> m;
+            for (auto & s : scale_) in >> s;
+
+            int nin = nfeatures;
+            while (in >> key)
+            {
+                DenseLayer l;
+                std::string activation;
+                if (key != "dense" || !(in >> l.nin >> l.nout >> activation) || l.nin != nin || l.nout <= 0) return error(name, "dense layer");
+                if      (activation == "relu")    l.activation = RELU;
+                else if (activation == "sigmoid") l.activation = SIGMOID;
+                else if (activation == "linear")  l.activation = LINEAR;
+                else return error(name, "activation " + activation);
+                l.ldw = (l.nout + NR - 1) / NR * NR;
+                l.w.assign(size_t(l.nin) * l.ldw, 0.f);
+                l.b.assign(l.ldw, 0.f);
+                for (int i = 0; i < l.nin; i++)
+                    for (int o = 0; o < l.nout; o++) in >> l.w[size_t(i) * l.ldw + o];
+                for (int o = 0; o < l.nout; o++) in >> l.b[o];
+                if (!in) return error(name, "weights");
+                layers_.push_back(l);
+                nin = l.nout;
+            }
+            if (layers_.empty() || layers_.back().nout != 1) return error(name, "output layer");
+            for (size_t l = 0; l + 1 < layers_.size(); l++)
+                if (layers_[l].activation == SIGMOID) return error(name, "hidden layer activation");
+
+            ldmax_ = (nfeatures + NR - 1) / NR * NR;
+            for (const auto & l : layers_) ldmax_ = std::max(ldmax_, l.ldw);
+            return true;
+        }
+
+        bool good() const { return !layers_.empty(); }
+        int nfeatures() const { return features_.size(); }
+        const std::vector<std::string> & features() const { return features_; }
+        const std::vector<DenseLayer> & layers() const { return layers_; }
+
+        // Buffers of predict, one per thread
+        struct Workspace {
+            std::vector<float> a, b;
+        };
+
+        // scores[t] for the n triplets of features (n x nfeatures(), row-major)
+        void predict(const float * features, size_t n, float * scores, Workspace & ws, bool simd = true) const
+        {
+            ws.a.resize(size_t(BLOCK) * ldmax_);
+            ws.b.resize(size_t(BLOCK) * ldmax_);
+            const int nf = nfeatures();
+            for (size_t t0 = 0; t0 < n; t0 += BLOCK)
+            {
+                const int nrows = std::min<size_t>(BLOCK, n - t0);
+                const int ntiles = (nrows + MR - 1) / MR * MR;
+
+                // Normalized features, zero padding
+                float * in = ws.a.data();
+                for (int r = 0; r < ntiles; r++)
+                    for (int i = 0; i < ldmax_; i++)
+                        in[size_t(r) * ldmax_ + i] = (r < nrows && i < nf) ? (features[(t0 + r) * nf + i] - mean_[i]) * scale_[i] : 0.f;
+
+                // Dense layers on the block
+                float * out = ws.b.data();
+                for (const auto & l : layers_)
+                {
+#if DENSE_INFERENCE_X86
+                    if (simd && has_avx2_fma()) dense_tiles_avx2(l, in, ldmax_, out, ldmax_, ntiles);
+                    else
+#endif
+                    dense_tiles_scalar(l, in, ldmax_, out, ldmax_, ntiles);
+                    std::swap(in, out);
+                }
+
+                const bool sigmoid = (layers_.back().activation == SIGMOID);
+                for (int r = 0; r < nrows; r++)
+                {
+                    float x = in[size_t(r) * ldmax_];
+                    scores[t0 + r] = sigmoid ? 1.f / (1.f + std::exp(-x)) : x;
+                }
+            }
+        }
+
+        void predict(const float * features, size_t n, float * scores) const
+        {
+            thread_local Workspace ws;
+            predict(features, n, scores, ws);
+        }
+
+        // One triplet at a time, without blocking nor tiles (to check predict)
+        float predict_one(const float * features) const
+        {
+            std::vector<float> x(nfeatures()), y;
+            for (int i = 0; i < nfeatures(); i++) x[i] = (features[i] - mean_[i]) * scale_[i];
+            for (const auto & l : layers_)
+            {
+                y.assign(l.nout, 0.f);
+                for (int o = 0; o < l.nout; o++)
+                {
+                    float sum = l.b[o];
+                    for (int i = 0; i < l.nin; i++) sum += x[i] * l.w[size_t(i) * l.ldw + o];
+                    y[o] = (l.activation == RELU && sum < 0) ? 0.f : (l.activation == SIGMOID ? 1.f / (1.f + std::exp(-sum)) : sum);
+                }
+                x.swap(y);
+            }
+            return x[0];
+        }
+
+      private:
+        bool error(const std::string & name, const std::string & what)
+        {
+            std::cerr << "DenseNetwork: bad " << what << " in " << name << std::endl;
+            layers_.clear();
+            return false;
+        }
+
+        std::vector<std::string> features_;
+        std::vector<float> mean_, scale_;
+        std::vector<DenseLayer> layers_;
+        int ldmax_ = 0;  // row stride of the blocks
+    };
+
+    // ------------------------------------------------
+    // Features of config/setup_v1.py: pi{0,1,2}_<var>, <var>_{01,02,12} or triplet_<var>
+    enum Var { PT, ETA, PHI, MASS, VZ, CHARGE, PDGID, ISO, DETA, DPHI, DR, M, PAIR_PT, DVZ,
+               TRIPLET_MASS, TRIPLET_PT, TRIPLET_MAXDR, TRIPLET_MINDR, TRIPLET_MAXDVZ, UNKNOWN };
+    struct Feature {
+        Var var;
+        int index; // pion (0-2) or pair (0: 01, 1: 02, 2: 12)
+    };
+
+    inline Feature parse_feature(const std::string & name)
+    {
+        static const char * pion_vars[] = {"pt", "eta", "phi", "mass", "vz", "charge", "pdgId", "iso"};
+        static const char * pair_vars[] = {"dEta", "dPhi", "dR", "m", "pt", "dVz"};
+        static const char * pairs[] = {"01", "02", "12"};
+        static const char * triplet_vars[] = {"triplet_mass", "triplet_pt", "triplet_maxdR", "triplet_mindR", "triplet_maxdVz"};
+        for (int p = 0; p < 3; p++)
+            for (int v = 0; v < 8; v++)
+                if (name == "pi" + std::to_string(p) + "_" + pion_vars[v]) return Feature{Var(PT + v), p};
+        for (int p = 0; p < 3; p++)
+            for (int v = 0; v < 6; v++)
+                if (name == std::string(pair_vars[v]) + "_" + pairs[p]) return Feature{Var(DETA + v), p};
+        for (int v = 0; v < 5; v++)
+            if (name == triplet_vars[v]) return Feature{Var(TRIPLET_MASS + v), 0};
+        return Feature{UNKNOWN, 0};
+    }
+
+} // namespace w3pdnn
+
+#ifndef DENSE_INFERENCE_NO_ROOT
+
+#include <ROOT/RVec.hxx>
+#include <Math/Vector4D.h>
+#include <Math/VectorUtil.h>
+
+// ------------------------------------------------
+// Network of the RDataFrame Defines
+inline w3pdnn::DenseNetwork & dnn_network()
+{
+    static w3pdnn::DenseNetwork network;
+    return network;
+}
+
+// Load the weights (before running the event loop)
+inline bool dnn_load(const std::string & name)
+{
+    w3pdnn::DenseNetwork & network = dnn_network();
+    if (!network.load(name)) return false;
+    for (const auto & f : network.features())
+        if (w3pdnn::parse_feature(f).var == w3pdnn::UNKNOWN)
+        {
+            std::cerr << "dnn_load: unknown feature " << f << std::endl;
+            return false;
+        }
+    return true;
+}
+
+// ------------------------------------------------
+// Scores of all the triplets of an event (triplet_idxs of add_all_triplet_idxs_from_pivot),
+// with the features of each triplet computed as in config/setup_v1.py
+template<typename Triplets>
+ROOT::VecOps::RVec<float> dnn_triplet_scores(const Triplets & triplet_idxs,
+                                             const ROOT::VecOps::RVec<float> & L1Puppi_pt, const ROOT::VecOps::RVec<float> & L1Puppi_eta,
+                                             const ROOT::VecOps::RVec<float> & L1Puppi_phi, const ROOT::VecOps::RVec<float> & L1Puppi_mass,
+                                             const ROOT::VecOps::RVec<float> & L1Puppi_vz, const ROOT::VecOps::RVec<int> & L1Puppi_charge,
+                                             const ROOT::VecOps::RVec<int> & L1Puppi_pdgId, const ROOT::VecOps::RVec<float> & L1Puppi_iso)
+{
+    using namespace w3pdnn;
+    const DenseNetwork & network = dnn_network();
+    static thread_local std::vector<Feature> parsed;
+    if (parsed.size() != network.features().size())
+    {
+        parsed.clear();
+        for (const auto & f : network.features()) parsed.push_back(parse_feature(f));
+    }
+
+    // Features of the triplets of the event, in one batch
+    const size_t n = triplet_idxs.size();
+    const int nf = network.nfeatures();
+    static thread_local std::vector<float> features;
+    features.resize(n * nf);
+    static const int first[3] = {0, 0, 1}, second[3] = {1, 2, 2};
+    for (size_t t = 0; t < n; t++)
+    {
+        const int idx[3] = {triplet_idxs[t].idx0, triplet_idxs[t].idx1, triplet_idxs[t].idx2};
+        ROOT::Math::PtEtaPhiMVector v[3];
+        for (int p = 0; p < 3; p++) v[p] = ROOT::Math::PtEtaPhiMVector(L1Puppi_pt[idx[p]], L1Puppi_eta[idx[p]], L1Puppi_phi[idx[p]], L1Puppi_mass[idx[p]]);
+        float dr[3], dvz[3];
+        for (int p = 0; p < 3; p++)
+        {
+            dr[p] = ROOT::Math::VectorUtil::DeltaR(v[first[p]], v[second[p]]);
+            dvz[p] = L1Puppi_vz[idx[first[p]]] - L1Puppi_vz[idx[second[p]]];
+        }
+        const auto triplet = v[0] + v[1] + v[2];
+
+        float * x = &features[t * nf];
+        for (int i = 0; i < nf; i++)
+        {
+            const Feature & f = parsed[i];
+            const int j = idx[f.index], a = idx[first[f.index]], b = idx[second[f.index]];
+            switch (f.var)
+            {
+                case PT:             x[i] = L1Puppi_pt[j]; break;
+                case ETA:            x[i] = L1Puppi_eta[j]; break;
+                case PHI:            x[i] = L1Puppi_phi[j]; break;
+                case MASS:           x[i] = L1Puppi_mass[j]; break;
+                case VZ:             x[i] = L1Puppi_vz[j]; break;
+                case CHARGE:         x[i] = L1Puppi_charge[j]; break;
+                case PDGID:          x[i] = L1Puppi_pdgId[j]; break;
+                case ISO:            x[i] = L1Puppi_iso[j]; break;
+                case DETA:           x[i] = L1Puppi_eta[a] - L1Puppi_eta[b]; break;
+                case DPHI:           x[i] = L1Puppi_phi[a] - L1Puppi_phi[b]; break;
+                case DR:             x[i] = dr[f.index]; break;
+                case M:              x[i] = (v[first[f.index]] + v[second[f.index]]).M(); break;
+                case PAIR_PT:        x[i] = (v[first[f.index]] + v[second[f.index]]).Pt(); break;
+                case DVZ:            x[i] = dvz[f.index]; break;
+                case TRIPLET_MASS:   x[i] = triplet.M(); break;
+                case TRIPLET_PT:     x[i] = triplet.Pt(); break;
+                case TRIPLET_MAXDR:  x[i] = std::max(dr[0], std::max(dr[1], dr[2])); break;
+                case TRIPLET_MINDR:  x[i] = std::min(dr[0], std::min(dr[1], dr[2])); break;
+                case TRIPLET_MAXDVZ: x[i] = std::max(dvz[0], std::max(dvz[1], dvz[2])); break;
+                case UNKNOWN:        x[i] = 0; break;
+            }
+        }
+    }
+
+    ROOT::VecOps::RVec<float> scores(n);
+    network.predict(features.data(), n, scores.data());
+    return scores;
+}
+
+#endif
+
+#endif
@@ -220,6 +220,46 @@ def prepare_inference_df (df):
 
     return df
 
+# Add the NN score of each triplet of triplet_idxs, computed natively in the event loop by the
+# batched CPU engine of utils/DenseInference.h, with the plain-text weights exported by
+# FC_export_hls_v1.py --text
+def add_dnn_scores (df, weights):
+
+    ROOT.gInterpreter.ProcessLine('#include "utils/DenseInference.h"')
+    if not ROOT.dnn_load(weights):
+        raise RuntimeError('Cannot load the DNN weights from {}'.format(weights))
+
+    df = df.Define('triplet_scores', 'dnn_triplet_scores(triplet_idxs, L1Puppi_pt, L1Puppi_eta, L1Puppi_phi, L1Puppi_mass, L1Puppi_vz, L1Puppi_charge, L1Puppi_pdgId, L1Puppi_iso)')
+    return df
+
+# Add the NN scores computed outside of the event loop, predictions[i] being the scores of the
+# triplets of entry rows[i] (rdfentry_): the scores are packed in one float32 buffer with the
+# offsets of each entry (CSR layout) and read without copy by utils/ScoreStore.h, instead of
+# being compiled into a C++ map. There is one store: the RDataFrames read the scores of the last call
+_score_buffers = [] # keep the buffers alive while the RDataFrames use them
+def add_triplet_scores (df, rows, predictions):
+
+    ROOT.gInterpreter.ProcessLine('#include "utils/ScoreStore.h"')
+
+    rows = np.asarray(rows, dtype=np.int64)
+    order = np.argsort(rows, kind='stable')
+    counts = np.array([len(predictions[i]) for i in order], dtype=np.int64)
+    if rows.size:
+        scores = np.concatenate([np.asarray(predictions[i], dtype=np.float32).reshape(-1) for i in order])
+    else:
+        scores = np.zeros(0, dtype=np.float32)
+
+    nentries = int(rows.max()) + 1 if rows.size else 0
+    offsets = np.zeros(nentries + 1, dtype=np.int64)
+    offsets[rows[order] + 1] = counts
+    np.cumsum(offsets, out=offsets)
+
+    _score_buffers.append((scores, offsets))
+    ROOT.score_store().set(scores, offsets, nentries)
+
+    df = df.Define('triplet_scores', 'scores_for(rdfentry_)')
+    return df
+
 # Prepare df with exact selections used by Pietro
 #  - pdgId 211 || 11
 #  - pT 18, 15, 12
@@ -0,0 +1,53 @@
+// ------------------------------------------------
+// Triplet scores computed outside of the event loop (e.g. by Keras), attached to an RDataFrame
+//
+// The scores of all the entries are one contiguous float buffer, with per-entry offsets
+// (CSR layout): the scores of entry e are scores[offsets[e]] ... scores[offsets[e+1]-1], the
+// entries without scores having an empty range. Both buffers are owned by the caller (numpy
+// arrays passed from python without copy, see add_triplet_scores in RootDF_utils.py) and
+// must stay alive while the RDataFrame runs.
+//
+// - score_store().set(scores, offsets, nentries): attach the buffers
+// - scores_for(rdfentry_): RVec<float> view (no copy) on the scores of an entry, for a Define
+
+#ifndef SCORE_STORE_H
+#define SCORE_STORE_H
+
+// ------------------------------------------------
+// General includes
+#include <cstdint>
+#include <ROOT/RVec.hxx>
+
+class ScoreStore {
+  public:
+    void set(const float * scores, const std::int64_t * offsets, std::uint64_t nentries)
+    {
+        scores_ = scores;
+        offsets_ = offsets;
+        nentries_ = nentries;
+    }
+
+    std::uint64_t nentries() const { return nentries_; }
+
+    // View on the scores of entry (empty if the entry has none)
+    ROOT::VecOps::RVec<float> scores_for(std::uint64_t entry) const
+    {
+        if (entry >= nentries_ || offsets_[entry + 1] == offsets_[entry]) return ROOT::VecOps::RVec<float>();
+        return ROOT::VecOps::RVec<float>(const_cast<float *>(scores_ + offsets_[entry]), offsets_[entry + 1] - offsets_[entry]);
+    }
+
+  private:
+    const float * scores_ = nullptr;
+    const std::int64_t * offsets_ = nullptr;  // nentries_ + 1 offsets
+    std::uint64_t nentries_ = 0;
+};
+
+inline ScoreStore & score_store()
+{
+    static ScoreStore store;
+    return store;
+}
+
+inline ROOT::VecOps::RVec<float> scores_for(std::uint64_t entry) { return score_store().scores_for(entry); }
+
+#endif
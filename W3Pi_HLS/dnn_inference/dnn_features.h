@@ -0,0 +1,20 @@
+#ifndef DNN_FEATURES_H
+#define DNN_FEATURES_H
+
+#include "src/dnn_inference.h"
+#include "../utils/puppi_soa.h"
+
+/**************************************************
+ * Input features of the triplet DNN, computed on the host in float
+ *
+ * The features of a triplet are the branches of W3PiDNN/config/setup_v1.py named in
+ * DNN_FEATURE_NAMES, computed from the candidates of the event as in the ntuples: physical
+ * units from the hardware LSBs (vz in cm), L1Puppi_mass of 0.005005 for electrons and
+ * 0.129883 otherwise, pdgId and charge from the particle ID, and the isolation of
+ * add_isolation (W3PiDNN/utils/RootDF_utils.h) over all the candidates of the event.
+ **************************************************/
+
+// Features of the triplet t (indexes in the npuppi candidates of soa), in the order of DNN_FEATURE_NAMES
+void dnn_features_ref(unsigned int npuppi, const PuppiEventSoA<NPUPPI_MAX> & soa, const Triplet & t, float features[DNN_NFEATURES]);
+
+#endif
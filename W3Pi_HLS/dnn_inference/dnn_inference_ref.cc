@@ -0,0 +1,156 @@
+#include "src/dnn_inference.h"
+#include "src/dnn_layers.h"
+#include "dnn_features.h"
+#ifndef DENSE_INFERENCE_NO_ROOT
+#define DENSE_INFERENCE_NO_ROOT
+#endif
+#include "../../W3PiDNN/utils/DenseInference.h"   // feature names, shared with the RDataFrame scoring
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+void dnn_inference_ref(const float features[NTRIPLETS_MAX][DNN_NFEATURES], const bool masked_triplets[NTRIPLETS_MAX], float scores[NTRIPLETS_MAX])
+{
+    for (int i = 0; i < NTRIPLETS_MAX; i++)
+        scores[i] = masked_triplets[i] ? 0.f : dnn_score<DnnFloatTypes, 1>(features[i]);
+}
+
+namespace {
+
+    // Physical quantities of a candidate, as in the ntuples
+    struct Pion {
+        float pt, eta, phi, vz, mass, iso;
+        int charge, pdgId;
+    };
+
+    // Four-vector (px, py, pz, E)
+    struct P4 {
+        double px, py, pz, e;
+        P4 operator+(const P4 & o) const { return P4{px + o.px, py + o.py, pz + o.pz, e + o.e}; }
+        double pt() const { return std::sqrt(px*px + py*py); }
+        double m() const { double m2 = e*e - px*px - py*py - pz*pz; return m2 > 0 ? std::sqrt(m2) : 0; }
+    };
+    P4 p4(const Pion & p)
+    {
+        double px = p.pt * std::cos(p.phi), py = p.pt * std::sin(p.phi), pz = p.pt * std::sinh(p.eta);
+        return P4{px, py, pz, std::sqrt(px*px + py*py + pz*pz + double(p.mass)*p.mass)};
+    }
+
+    // get_dR of RootDF_utils.h
+    float delta_phi(float phi1, float phi2)
+    {
+        float dphi = phi2 - phi1;
+        if (dphi > M_PI) dphi -= 2.0*M_PI;
+        else if (dphi <= -M_PI) dphi += 2.0*M_PI;
+        return dphi;
+    }
+    float delta_r(const Pion & a, const Pion & b)
+    {
+        float deta = b.eta - a.eta, dphi = delta_phi(a.phi, b.phi);
+        return std::sqrt(dphi*dphi + deta*deta);
+    }
+
+    Pion pion(const PuppiEventSoA<NPUPPI_MAX> & soa, unsigned int i)
+    {
+        // pdgId and charge of the Puppi::PID, in the order H0, Gamma, HMinus, HPlus, EMinus, EPlus, MuMinus, MuPlus
+        static const int pdgIds[8] = {130, 22, -211, 211, 11, -11, 13, -13};
+        static const int charges[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+        Pion p;
+        p.pt = soa.pt[i] * 0.25f;
+        p.eta = soa.eta[i] * Puppi::ETAPHI_LSB;
+        p.phi = soa.phi[i] * Puppi::ETAPHI_LSB;
+        p.vz = soa.z0[i] * 0.05f;
+        p.pdgId = pdgIds[soa.id[i] & 7];
+        p.charge = charges[soa.id[i] & 7];
+        p.mass = (std::abs(p.pdgId) == 11) ? 0.005005f : 0.129883f;
+        p.iso = 0;
+        return p;
+    }
+
+    // add_isolation of RootDF_utils.h, for candidate i
+    float isolation(const PuppiEventSoA<NPUPPI_MAX> & soa, unsigned int npuppi, unsigned int i, const Pion & seed)
+    {
+        float sum_pt = 0;
+        for (unsigned int j = 0; j < npuppi; j++)
+        {
+            if (j == i) continue;
+            Pion other = pion(soa, j);
+            float dr = delta_r(seed, other);
+            if (dr > 0.01 && dr < 0.25) sum_pt += other.pt;
+        }
+        return sum_pt / seed.pt;
+    }
+
+} // namespace
+
+void dnn_features_ref(unsigned int npuppi, const PuppiEventSoA<NPUPPI_MAX> & soa, const Triplet & t, float features[DNN_NFEATURES])
+{
+    using namespace w3pdnn;
+    static const struct Features {
+        Feature f[DNN_NFEATURES];
+        Features()
+        {
+            for (int i = 0; i < DNN_NFEATURES; i++)
+            {
+                f[i] = parse_feature(DNN_FEATURE_NAMES[i]);
+                if (f[i].var == UNKNOWN)
+                {
+                    fprintf(stderr, "dnn_features_ref: unknown feature %s\n", DNN_FEATURE_NAMES[i]);
+                    abort();
+                }
+            }
+        }
+    } parsed;
+
+    // Pions, pairs (01, 02, 12) and triplet
+    const unsigned int idx[3] = {(unsigned int) t.idx0.to_int(), (unsigned int) t.idx1.to_int(), (unsigned int) t.idx2.to_int()};
+    static const int first[3] = {0, 0, 1}, second[3] = {1, 2, 2};
+    Pion pi[3];
+    P4 v[3];
+    for (int p = 0; p < 3; p++)
+    {
+        pi[p] = pion(soa, idx[p]);
+        pi[p].iso = isolation(soa, npuppi, idx[p], pi[p]);
+        v[p] = p4(pi[p]);
+    }
+    float dr[3], dvz[3];
+    for (int p = 0; p < 3; p++)
+    {
+        dr[p] = delta_r(pi[first[p]], pi[second[p]]);
+        dvz[p] = pi[first[p]].vz - pi[second[p]].vz;
+    }
+    P4 triplet = v[0] + v[1] + v[2];
+
+    for (int i = 0; i < DNN_NFEATURES; i++)
+    {
+        const Feature & f = parsed.f[i];
+        const Pion & p = pi[f.index];
+        const Pion & a = pi[first[f.index]], & b = pi[second[f.index]];
+        float x = 0;
+        switch (f.var)
+        {
+            case PT:             x = p.pt; break;
+            case ETA:            x = p.eta; break;
+            case PHI:            x = p.phi; break;
+            case MASS:           x = p.mass; break;
+            case VZ:             x = p.vz; break;
+            case CHARGE:         x = p.charge; break;
+            case PDGID:          x = p.pdgId; break;
+            case ISO:            x = p.iso; break;
+            case DETA:           x = a.eta - b.eta; break;
+            case DPHI:           x = a.phi - b.phi; break; // not wrapped, as in the ntuples
+            case DR:             x = dr[f.index]; break;
+            case M:              x = (v[first[f.index]] + v[second[f.index]]).m(); break;
+            case PAIR_PT:        x = (v[first[f.index]] + v[second[f.index]]).pt(); break;
+            case DVZ:            x = dvz[f.index]; break;
+            case TRIPLET_MASS:   x = triplet.m(); break;
+            case TRIPLET_PT:     x = triplet.pt(); break;
+            case TRIPLET_MAXDR:  x = std::max(dr[0], std::max(dr[1], dr[2])); break;
+            case TRIPLET_MINDR:  x = std::min(dr[0], std::min(dr[1], dr[2])); break;
+            case TRIPLET_MAXDVZ: x = std::max(dvz[0], std::max(dvz[1], dvz[2])); break;
+            case UNKNOWN:        break;
+        }
+        features[i] = x;
+    }
+}
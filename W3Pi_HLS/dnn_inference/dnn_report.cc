@@ -0,0 +1,135 @@
+// Latency/resources and accuracy report of the DNN inference kernel (src/dnn_inference.h)
+//
+// Usage:
+//   dnn_report [-c clock_ns] [-b budget_ns] [-d dsp] [-n nevents] [file1.dump ...]
+//
+//  - for each reuse factor, the cycle-count model gives the latency of one triplet, the
+//    interval and latency of an event (NTRIPLETS_MAX triplets) and the multipliers, and the
+//    largest reuse factor with an event interval within the budget (default: 150 ns, one
+//    event every 6 bunch crossings) and at most dsp multipliers (default: 6840, xcvu9p) is
+//    reported
+//  - the triplets of the first nevents of the dump files (default: the bundled PU200 dump,
+//    run from the data directory) are scored by the kernel and by the float reference: the
+//    kernel must be within DNN_TOLERANCE of the reference, and the fixed-point network must
+//    give the same scores for all the reuse factors
+#include "src/dnn_inference.h"
+#include "src/dnn_layers.h"
+#include "dnn_features.h"
+#include "../event_processor/ref_workspace.h"
+#include "../utils/dump_reader.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// Largest difference allowed between the fixed-point and the float scores
+#define DNN_TOLERANCE 0.02
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [-c clock_ns] [-b budget_ns] [-d dsp] [-n nevents] [file1.dump ...]\n", name);
+}
+
+// Score with REUSE and compare with the kernel (DNN_REUSE)
+template<int REUSE>
+bool check_reuse(const dnn_input_t features[DNN_NFEATURES], const dnn_score_t & score)
+{
+    bool ok = (dnn_score<DnnFixedTypes, REUSE>(features) == score);
+    if (!ok) printf("Score mismatch with REUSE = %d\n", REUSE);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    float clock_ns = 2.777, budget_ns = 150;
+    int dsp = 6840;
+    unsigned int nevents = 101;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-c") && i+1 < argc) clock_ns = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-b") && i+1 < argc) budget_ns = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-d") && i+1 < argc) dsp = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i+1 < argc) nevents = atoi(argv[++i]);
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU200.dump"};
+
+    // Cycle-count model
+    printf("DNN inference: %d features, layers", DNN_NFEATURES);
+    for (int l = 1; l <= DNN_NLAYERS; l++) printf(" %d", DNN_SIZES[l]);
+    printf(", %d triplets per event, clock %.3f ns, interval budget %.1f ns (%d cycles), %d DSP\n",
+           NTRIPLETS_MAX, clock_ns, budget_ns, int(budget_ns / clock_ns), dsp);
+    printf("%6s %6s %8s %10s %9s %11s %8s %8s\n", "REUSE", "depth", "latency", "latency_ns", "interval", "interval_ns", "mult", "adders");
+    int best = -1;
+    static const int reuses[] = {1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 24, 32};
+    for (int reuse : reuses)
+    {
+        DnnCost c = dnn_cost(reuse);
+        printf("%6d %6d %8d %10.1f %9d %11.1f %8d %8d%s\n", c.reuse, c.depth, c.latency, c.latency_ns(clock_ns), c.interval,
+               c.interval_ns(clock_ns), c.multipliers, c.adders, reuse == DNN_REUSE ? "  <-- DNN_REUSE" : "");
+        if (c.interval_ns(clock_ns) <= budget_ns && c.multipliers <= dsp) best = reuse;
+    }
+    if (best > 0) printf("Largest reuse factor within the budget: %d (%d multipliers)\n", best, dnn_cost(best).multipliers);
+    else printf("No reuse factor within the budget\n");
+
+    // Accuracy and reuse factors on the dump files
+    RefWorkspace ws;
+    unsigned int ntriplets = 0, nfailed = 0;
+    bool ok_reuse = true;
+    double sumdiff = 0;
+    float maxdiff = 0;
+    for (const std::string & inname : innames)
+    {
+        DumpReader in(inname);
+        if (!in.good()) { printf("Cannot open %s\n", inname.c_str()); return 1; }
+        for (unsigned int ievt = 0; ievt < nevents && ievt < in.size(); ++ievt)
+        {
+            DumpEvent event = in.event(ievt);
+            unsigned int npuppi = std::min<unsigned int>(event.npuppi(), NPUPPI_MAX);
+            if (npuppi < 3) continue;
+
+            Puppi * puppi = ws.load(event.data, npuppi);
+            Puppi pivot;
+            Triplet triplets[NTRIPLETS_MAX];
+            bool masked_triplets[NTRIPLETS_MAX];
+            event_processor_ref(npuppi, puppi, pivot, triplets, masked_triplets, ws);
+
+            float features[NTRIPLETS_MAX][DNN_NFEATURES] = {};
+            dnn_input_t features_hw[NTRIPLETS_MAX][DNN_NFEATURES];
+            for (int i = 0; i < NTRIPLETS_MAX; i++)
+            {
+                if (!masked_triplets[i]) dnn_features_ref(npuppi, ws.soa, triplets[i], features[i]);
+                for (int f = 0; f < DNN_NFEATURES; f++) features_hw[i][f] = features[i][f];
+            }
+
+            dnn_score_t scores[NTRIPLETS_MAX];
+            float scores_ref[NTRIPLETS_MAX];
+            dnn_inference(features_hw, masked_triplets, scores);
+            dnn_inference_ref(features, masked_triplets, scores_ref);
+
+            for (int i = 0; i < NTRIPLETS_MAX; i++)
+            {
+                if (masked_triplets[i]) continue;
+                float diff = std::abs(scores[i].to_float() - scores_ref[i]);
+                sumdiff += diff;
+                maxdiff = std::max(maxdiff, diff);
+                nfailed += (diff > DNN_TOLERANCE);
+                ntriplets++;
+                ok_reuse = check_reuse<1>(features_hw[i], scores[i]) && check_reuse<2>(features_hw[i], scores[i]) &&
+                           check_reuse<3>(features_hw[i], scores[i]) && check_reuse<8>(features_hw[i], scores[i]) && ok_reuse;
+            }
+        }
+    }
+
+    printf("Scores vs float reference: %u triplets, mean |diff| = %.5f, max |diff| = %.5f, %u above the tolerance %.3f\n",
+           ntriplets, ntriplets ? sumdiff / ntriplets : 0., maxdiff, nfailed, DNN_TOLERANCE);
+    printf("Fixed-point scores with REUSE = 1, 2, 3, 8 vs DNN_REUSE = %d: %s\n", DNN_REUSE, ok_reuse ? "identical" : "MISMATCH");
+    return (ok_reuse && !nfailed) ? 0 : 1;
+}
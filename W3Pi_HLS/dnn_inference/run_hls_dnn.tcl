@@ -0,0 +1,15 @@
+open_project -reset proj_dnn
+set_top dnn_inference
+add_files src/dnn_inference.cc
+add_files -tb dnn_inference_ref.cc
+add_files -tb ../event_processor/event_processor_ref.cc
+add_files -tb testbench.cc
+add_files -tb ../data/Puppi_w3p_PU200.dump
+
+open_solution -reset "solution"
+set_part {xcvu9p-flga2577-2-e}
+create_clock -period 2.777
+
+csim_design
+#csynth_design
+exit
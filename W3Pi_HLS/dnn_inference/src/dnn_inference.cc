@@ -0,0 +1,19 @@
+#include "dnn_inference.h"
+#include "dnn_layers.h"
+#include "../../utils/stage_stats.h"
+#include <algorithm>
+
+void dnn_inference(const dnn_input_t features[NTRIPLETS_MAX][DNN_NFEATURES], const bool masked_triplets[NTRIPLETS_MAX], dnn_score_t scores[NTRIPLETS_MAX])
+{
+    #pragma HLS ARRAY_PARTITION variable=features complete dim=2
+    #pragma HLS ARRAY_PARTITION variable=masked_triplets complete
+
+    // One triplet every DNN_REUSE clock cycles
+    LOOP_DNN_TRIPLETS: for (int i = 0; i < NTRIPLETS_MAX; i++)
+    {
+        #pragma HLS PIPELINE II=DNN_REUSE
+        dnn_score_t score = dnn_score<DnnFixedTypes, DNN_REUSE>(features[i]);
+        scores[i] = masked_triplets[i] ? dnn_score_t(0) : score;
+    }
+    W3P_STATS_COUNT("hls.dnn_scored", std::count(masked_triplets, masked_triplets + NTRIPLETS_MAX, false));
+}
@@ -0,0 +1,100 @@
+#ifndef DNN_INFERENCE_H
+#define DNN_INFERENCE_H
+
+#include "../../event_processor/src/event_processor.h"
+#include "dnn_weights.h"
+
+/**************************************************
+ * Fixed-point inference of the triplet DNN (W3PiDNN/config/FCModel.py)
+ *
+ * Normalization layer, then the dense layers of dnn_weights.h (ReLU, sigmoid output),
+ * exported from the trained Keras model by W3PiDNN/FC_export_hls_v1.py. The NTRIPLETS_MAX
+ * triplets of event_processor are scored one after the other in a loop pipelined with
+ * II = DNN_REUSE; the masked triplets get a score of 0.
+ *
+ * DNN_REUSE is the reuse factor of the multipliers: each dense layer of NIN x NOUT weights
+ * instantiates ceil(NIN*NOUT/DNN_REUSE) multipliers, each used DNN_REUSE times per triplet.
+ * The sums are exact in the accumulator type, so the scores do not depend on DNN_REUSE.
+ * DnnModel<REUSE> (or dnn_cost() at run time) estimates the latency and the multipliers of
+ * a given setting (see dnn_report.cc); the stage depths are estimates at the 2.777 ns clock
+ * of run_hls_dnn.tcl, to be updated from the csynth reports.
+ *
+ * The input features are computed on the host from the candidates of the triplets, in the
+ * order of DNN_FEATURE_NAMES (dnn_features_ref in dnn_inference_ref.cc).
+ **************************************************/
+
+#ifndef DNN_REUSE
+#define DNN_REUSE 1
+#endif
+
+// Data types
+typedef w3p_fixed<18,10,AP_RND,AP_SAT> dnn_input_t;     // input features
+typedef w3p_fixed<24,10,AP_RND,AP_SAT> dnn_norm_t;      // normalized features, mean and scale
+typedef w3p_fixed<18,8,AP_RND,AP_SAT> dnn_data_t;       // outputs of the hidden layers
+typedef w3p_fixed<16,4,AP_RND,AP_SAT> dnn_weight_t;     // weights and biases
+typedef w3p_fixed<44,16> dnn_accum_t;                   // sums of the dense layers (exact)
+typedef w3p_fixed<10,4,AP_RND,AP_SAT> dnn_sigmoid_in_t; // index of the sigmoid table, [-8,8) in steps of 1/64
+typedef w3p_ufixed<10,0> dnn_score_t;                   // output score
+
+// Pipeline depths (clock cycles)
+#define DNN_DEPTH_NORM 3     // subtraction, multiplication (DSP) and rounding
+#define DNN_DEPTH_MULT 3     // multiplication (DSP)
+#define DNN_ADDERS_DEPTH 2   // adder tree levels per clock cycle
+#define DNN_DEPTH_ACT 1      // ReLU (comparison) or sigmoid (table)
+
+struct DnnCost {
+    int reuse;
+    int depth;         // latency of one triplet
+    int interval;      // clock cycles between two events (NTRIPLETS_MAX triplets, II = reuse)
+    int latency;       // total latency of an event [clock cycles]
+    int multipliers;   // weights multipliers (DSP)
+    int adders;        // adders of the products to the partial sums
+
+    float latency_ns(float clock_ns) const { return latency * clock_ns; }
+    float interval_ns(float clock_ns) const { return interval * clock_ns; }
+};
+
+// Levels of a balanced adder tree with n inputs
+constexpr int dnn_adder_levels(int n) { return n <= 1 ? 0 : 1 + dnn_adder_levels((n+1)/2); }
+
+// Multipliers of a NIN x NOUT dense layer with reuse factor reuse
+constexpr int dnn_layer_multipliers(int nin, int nout, int reuse) { return (nin*nout + reuse - 1) / reuse; }
+
+// Each output sums ceil(nin/reuse) products (and the bias or the previous partial sum) per
+// multiplier use, the reuse partial sums are chained
+constexpr int dnn_layer_depth(int nin, int reuse)
+{
+    return DNN_DEPTH_MULT + (dnn_adder_levels((nin + reuse - 1) / reuse + 1) + DNN_ADDERS_DEPTH - 1) / DNN_ADDERS_DEPTH
+         + (reuse - 1) + DNN_DEPTH_ACT;
+}
+
+constexpr DnnCost dnn_cost(int reuse)
+{
+    DnnCost c{};
+    c.reuse = reuse;
+    c.depth = DNN_DEPTH_NORM;
+    for (int l = 0; l < DNN_NLAYERS; l++)
+    {
+        c.depth += dnn_layer_depth(DNN_SIZES[l], reuse);
+        c.multipliers += dnn_layer_multipliers(DNN_SIZES[l], DNN_SIZES[l+1], reuse);
+        c.adders += dnn_layer_multipliers(DNN_SIZES[l], DNN_SIZES[l+1], reuse);
+    }
+    c.interval = NTRIPLETS_MAX * reuse;
+    c.latency = c.depth + (NTRIPLETS_MAX - 1) * reuse;
+    return c;
+}
+
+template<int REUSE>
+struct DnnModel {
+    static_assert(REUSE >= 1, "REUSE must be at least 1");
+    static constexpr DnnCost cost = dnn_cost(REUSE);
+    static constexpr int LATENCY = cost.latency;
+};
+
+// HLS kernel
+void dnn_inference(const dnn_input_t features[NTRIPLETS_MAX][DNN_NFEATURES], const bool masked_triplets[NTRIPLETS_MAX], dnn_score_t scores[NTRIPLETS_MAX]);
+
+// Float reference (same network, float arithmetic, exact sigmoid)
+void dnn_inference_ref(const float features[NTRIPLETS_MAX][DNN_NFEATURES], const bool masked_triplets[NTRIPLETS_MAX], float scores[NTRIPLETS_MAX]);
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef DNN_LAYERS_H
+#define DNN_LAYERS_H
+
+#include "dnn_inference.h"
+#include <cmath>
+
+/**************************************************
+ * Layers of the triplet DNN, templated on the arithmetic
+ *
+ *  - DnnFixedTypes: types of dnn_inference.h, ReLU with saturation to dnn_data_t and
+ *    sigmoid from a compile-time table of 1024 entries over [-8,8)
+ *  - DnnFloatTypes: float everywhere, exact sigmoid (float reference)
+ *
+ * dnn_score<Types,REUSE>(features) runs the whole network on one triplet. In the dense
+ * layers the weights are split in REUSE blocks: iteration r of LOOP_DENSE_REUSE multiplies
+ * the weights k = m*REUSE + r, so that each of the ceil(NIN*NOUT/REUSE) multipliers reads
+ * its own block of REUSE weights.
+ **************************************************/
+
+namespace dnn {
+
+    // exp(x) by its Taylor series (converged to double precision for |x| <= 8)
+    constexpr double exp_series(double x) {
+        double term = 1, sum = 1;
+        for (int n = 1; n <= 60; ++n) {
+            term *= x / n;
+            sum += term;
+        }
+        return sum;
+    }
+    constexpr double sigmoid(double x) { return x >= 0 ? 1 / (1 + 1 / exp_series(x)) : 1 / (1 + exp_series(-x)); }
+
+    // Raw dnn_score_t bits of the sigmoid of x = (i - N/2) / 64
+    static constexpr int SIGMOID_N = 1024;
+    struct SigmoidTable {
+        uint16_t v[SIGMOID_N];
+    };
+    constexpr SigmoidTable makeSigmoidTable() {
+        SigmoidTable t{};
+        for (int i = 0; i < SIGMOID_N; ++i) {
+            int raw = int(sigmoid((i - SIGMOID_N/2) / 64.) * 1024 + 0.5);
+            t.v[i] = raw > 1023 ? 1023 : raw;
+        }
+        return t;
+    }
+
+} // namespace
+
+struct DnnFixedTypes {
+    typedef dnn_input_t input_t;
+    typedef dnn_norm_t norm_t;
+    typedef dnn_data_t data_t;
+    typedef dnn_weight_t weight_t;
+    typedef dnn_accum_t accum_t;
+    typedef dnn_score_t score_t;
+
+    static data_t relu(const accum_t & x) { return x > 0 ? data_t(x) : data_t(0); }
+    static score_t sigmoid(const accum_t & x)
+    {
+        static constexpr dnn::SigmoidTable table = dnn::makeSigmoidTable();
+        dnn_sigmoid_in_t xs = x;
+        score_t s;
+        s(9,0) = table.v[(xs * 64).to_int() + dnn::SIGMOID_N/2];
+        return s;
+    }
+};
+
+struct DnnFloatTypes {
+    typedef float input_t;
+    typedef float norm_t;
+    typedef float data_t;
+    typedef float weight_t;
+    typedef float accum_t;
+    typedef float score_t;
+
+    static data_t relu(accum_t x) { return x > 0 ? x : 0; }
+    static score_t sigmoid(accum_t x) { return 1 / (1 + std::exp(-x)); }
+};
+
+// out = in . w + b, with ceil(NIN*NOUT/REUSE) multipliers each used REUSE times
+template<typename Types, int NIN, int NOUT, int REUSE, typename TIN>
+void dnn_dense(const TIN in[NIN], typename Types::accum_t out[NOUT], const typename Types::weight_t w[NIN*NOUT], const typename Types::weight_t b[NOUT])
+{
+    static constexpr int NMULT = (NIN*NOUT + REUSE - 1) / REUSE;
+    #pragma HLS ARRAY_PARTITION variable=w block factor=NMULT
+    #pragma HLS ARRAY_PARTITION variable=b complete
+    #pragma HLS ALLOCATION operation instances=mul limit=NMULT
+
+    LOOP_DENSE_BIAS: for (int o = 0; o < NOUT; o++)
+    {
+        #pragma HLS UNROLL
+        out[o] = b[o];
+    }
+
+    LOOP_DENSE_REUSE: for (int r = 0; r < REUSE; r++)
+    {
+        LOOP_DENSE_MULT: for (int m = 0; m < NMULT; m++)
+        {
+            #pragma HLS UNROLL
+            int k = m * REUSE + r;
+            if (k < NIN*NOUT) out[k % NOUT] += in[k / NOUT] * w[k];
+        }
+    }
+}
+
+// Dense layer L and the following ones, on the outputs of layer L-1 (or the normalized features)
+template<typename Types, int L, int REUSE>
+struct DnnForward {
+    template<typename TIN>
+    static typename Types::score_t run(const TIN in[DNN_SIZES[L]])
+    {
+        typedef DnnLayer<typename Types::weight_t, L> layer;
+        typename Types::accum_t acc[DNN_SIZES[L+1]];
+        typename Types::data_t out[DNN_SIZES[L+1]];
+        #pragma HLS ARRAY_PARTITION variable=acc complete
+        #pragma HLS ARRAY_PARTITION variable=out complete
+
+        dnn_dense<Types, DNN_SIZES[L], DNN_SIZES[L+1], REUSE>(in, acc, layer::w, layer::b);
+        LOOP_DENSE_RELU: for (int o = 0; o < DNN_SIZES[L+1]; o++)
+        {
+            #pragma HLS UNROLL
+            out[o] = Types::relu(acc[o]);
+        }
+        return DnnForward<Types, L+1, REUSE>::run(out);
+    }
+};
+
+// Output layer, one neuron with sigmoid activation
+template<typename Types, int REUSE>
+struct DnnForward<Types, DNN_NLAYERS-1, REUSE> {
+    static_assert(DNN_SIZES[DNN_NLAYERS] == 1, "The DNN must have a single output");
+
+    template<typename TIN>
+    static typename Types::score_t run(const TIN in[DNN_SIZES[DNN_NLAYERS-1]])
+    {
+        typedef DnnLayer<typename Types::weight_t, DNN_NLAYERS-1> layer;
+        typename Types::accum_t acc[1];
+        dnn_dense<Types, DNN_SIZES[DNN_NLAYERS-1], 1, REUSE>(in, acc, layer::w, layer::b);
+        return Types::sigmoid(acc[0]);
+    }
+};
+
+// Score of one triplet
+template<typename Types, int REUSE>
+typename Types::score_t dnn_score(const typename Types::input_t features[DNN_NFEATURES])
+{
+    typedef DnnNorm<typename Types::norm_t> norm;
+    typename Types::norm_t x[DNN_NFEATURES];
+    #pragma HLS ARRAY_PARTITION variable=x complete
+
+    LOOP_DNN_NORM: for (int i = 0; i < DNN_NFEATURES; i++)
+    {
+        #pragma HLS UNROLL
+        x[i] = (features[i] - norm::mean[i]) * norm::scale[i];
+    }
+    return DnnForward<Types, 0, REUSE>::run(x);
+}
+
+#endif
@@ -0,0 +1,850 @@
+#ifndef DNN_WEIGHTS_H
+#define DNN_WEIGHTS_H
+
+// Generated by W3PiDNN/FC_export_hls_v1.py from the UNTRAINED PLACEHOLDER (--random 37 35 30 25 30 35, seed 2023): export a trained model with --input
+// Features of config/setup_v1.py
+
+#define DNN_NFEATURES 24
+#define DNN_NLAYERS 7
+
+// Input features, in the order of the training
+static const char * const DNN_FEATURE_NAMES[DNN_NFEATURES] = {
+    "pi0_pt",
+    "pi1_pt",
+    "pi2_pt",
+    "pi0_pdgId",
+    "pi1_pdgId",
+    "pi2_pdgId",
+    "pi0_iso",
+    "pi1_iso",
+    "pi2_iso",
+    "dR_01",
+    "dR_02",
+    "dR_12",
+    "m_01",
+    "m_02",
+    "m_12",
+    "pt_01",
+    "pt_02",
+    "pt_12",
+    "dVz_01",
+    "dVz_02",
+    "dVz_12",
+    "triplet_pt",
+    "triplet_maxdR",
+    "triplet_maxdVz"
+};
+
+// Inputs, then outputs of each dense layer (ReLU, sigmoid for the last one)
+static constexpr int DNN_SIZES[DNN_NLAYERS+1] = {24, 37, 35, 30, 25, 30, 35, 1};
+
+// Normalization layer: (x - mean) * scale
+template<typename T> struct DnnNorm { static const T mean[DNN_NFEATURES]; static const T scale[DNN_NFEATURES]; };
+template<typename T> const T DnnNorm<T>::mean[DNN_NFEATURES] = {
+    30, 20, 12, 0, 0, 0, 0.3, 0.3,
+    0.3, 1, 1, 1, 40, 40, 40, 30,
+    30, 30, 0, 0, 0, 40, 1.5, 0.3
+};
+template<typename T> const T DnnNorm<T>::scale[DNN_NFEATURES] = {
+    0.0666666667, 0.1, 0.166666667, 0.00666666667, 0.00666666667, 0.00666666667, 2.5, 2.5,
+    2.5, 1.66666667, 1.66666667, 1.66666667, 0.05, 0.05, 0.05, 0.0666666667,
+    0.0666666667, 0.0666666667, 2, 2, 2, 0.05, 1.42857143, 2.5
+};
+
+// Dense layers: w[i*NOUT + o] from input i to output o, b[o]
+template<typename T, int L> struct DnnLayer;
+template<typename T> struct DnnLayer<T, 0> { static const T w[24*37]; static const T b[37]; };
+template<typename T> const T DnnLayer<T, 0>::w[24*37] = {
+    -0.0734372285, 0.295975518, 0.215659495, -0.112728978, 0.0445508964, -0.102094223, -0.2508701, -0.23592151,
+    -0.123334846, 0.123436055, 0.13696915, -0.124723567, -0.167686021, 0.299664002, -0.202796997, -0.302924158,
+    -0.0859033526, 0.0772514511, 0.128596544, 0.177068471, -0.188290346, 0.295662696, 0.251297248, 0.0198746591,
+    0.00177922505, -0.26599966, 0.286971519, -0.00095265842, 0.183824071, 0.0455101272, 0.151224651, 0.085983986,
+    0.21486301, 0.0507345553, -0.270227923, 0.303884764, -0.0125050847, -0.186153293, 0.0829104063, 0.0203130866,
+    0.24715206, 0.233462743, 0.199084832, 0.136012952, 0.047208589, -0.278421296, -0.0158301901, 0.25724018,
+    -0.258571332, 0.245769622, 0.235065717, 0.0472251371, -0.116390075, -0.113576039, 0.196227901, -0.213754757,
+    0.141461966, -0.264942176, -0.0896232276, 0.196572292, -0.222857898, -0.0959925404, 0.0920767256, -0.300614766,
+    -0.201400516, 0.205435719, -0.312762743, -0.224091267, -0.187983562, 0.089425709, -0.156006446, 0.305695114,
+    0.125777859, -0.0474866899, 0.13980173, 0.121598417, -0.258395752, 0.143836684, 0.09520534, 0.218239578,
+    0.169538311, -0.240154518, -0.271087495, 0.245039634, -0.00650887823, 0.292971621, 0.0495854388, 0.239776102,
+    -0.296064742, 0.227505498, 0.0547592097, -0.18761035, 0.225937773, -0.192296837, 0.217161119, -0.26979317,
+    -0.145549398, -0.201332788, -0.183291667, 0.0628981903, -0.286684481, -0.283364247, 0.254564658, -0.0616569894,
+    0.127211286, 0.0567302593, -0.104545029, 0.12528672, 0.0993471663, -0.237643032, 0.223162499, 0.0538790122,
+    0.0076396962, -0.139331613, -0.288493359, 0.0111328684, -0.0877819291, -0.134258822, -0.214944033, 0.0246498211,
+    -0.263206498, -0.167719114, -0.227421446, -0.17335601, 0.098823562, 0.231539564, 0.0299508617, 0.0572666053,
+    -0.28363369, 0.060214071, 0.117906855, 0.232026489, -0.0464950229, 0.20048961, 0.126126317, -0.245382798,
+    0.0482643304, -0.288580773, -0.0654440785, 0.105137978, 0.224908467, 0.202310799, 0.26518244, -0.229588973,
+    0.0438471811, 0.141258718, 0.11449272, 0.11624711, 0.0741483431, 0.0982658237, -0.29213945, 0.00291415146,
+    -0.260560307, 0.261226335, -0.031631815, -0.202217551, 0.235716886, -0.253958288, -0.287629885, 0.155618632,
+    -0.296919448, -0.0893978208, -0.00383076984, 0.0172586088, 0.0715379366, 0.27204878, -0.0632448049, 0.290073683,
+    -0.00457586522, 0.16236995, -0.128095726, -0.2235776, 0.0431578562, -0.118613641, 0.0981199289, 0.165777885,
+    0.00977375961, 0.283191372, -0.0377410654, 0.298853563, 0.10024537, 0.195528989, 0.161911543, -0.273979311,
+    0.0977253784, 0.187674659, -0.152958641, -0.306285536, -0.132797729, 0.109582209, -0.309703525, -0.259875323,
+    0.148031921, -0.169304329, -0.268438944, 0.255072302, -0.154105222, 0.180354918, -0.109550662, 0.224449922,
+    -0.0624082668, 0.031528594, -0.275132999, -0.0997099729, 0.153583046, -0.255090056, 0.116070742, -0.301870534,
+    0.247463502, -0.033414734, -0.0742172485, -0.144644345, 0.157596816, 0.0835272524, -0.25650867, -0.24154518,
+    -0.265553609, -0.242214262, -0.204087918, 0.220170553, 0.0336467565, -0.181138373, -0.0747962979, 0.0629414199,
+    -0.0321598334, 0.233185918, -0.137699734, -0.184037556, -0.0960766578, -0.087538751, -0.221000105, 0.124524373,
+    -0.168089005, -0.00273964264, -0.143127734, -0.147446202, -0.137565151, 0.0282235171, 0.0689798381, 0.217038136,
+    0.228974429, 0.243833248, -0.219220104, -0.0905157519, 0.264215832, -0.251368884, -0.209474344, 0.0804814506,
+    -0.149950574, -0.0776500744, -0.22983878, -0.247180958, -0.0803022388, -0.221723352, -0.162858032, -0.184542088,
+    -0.0195923608, 0.271901744, -0.0050236187, -0.0989427361, 0.288238371, -0.0361174815, -0.307439847, -0.0988745654,
+    0.259182167, 0.164939783, 0.279330179, -0.222531681, -0.159806031, 0.0575532355, -0.230619954, -0.15127332,
+    -0.302828492, -0.232406229, -0.217003798, -0.0113362099, -0.0952414729, 0.0715175985, 0.294663322, -0.0113626529,
+    0.262733222, 0.0311132854, -0.203959061, 0.163083407, 0.0981043833, 0.299802872, -0.164819917, 0.255448912,
+    -0.276777503, -0.182332754, 0.197075224, -0.249981109, 0.0592417927, -0.132402852, 0.0627261146, -0.235532269,
+    0.267596874, 0.155127579, 0.137644638, 0.155899786, -0.261265034, -0.189128962, 0.250893199, 0.0516976578,
+    -0.0418060501, -0.220307802, -0.254154377, 0.183771988, -0.0306702885, 0.109175687, 0.0628700458, -0.0388063526,
+    -0.292641507, -0.0307922165, 0.0326694574, 0.265311585, 0.029154383, -0.0872872144, -0.129951954, 0.254126719,
+    -0.011279655, 0.0539395125, 0.208787307, 0.00647511732, -0.160056999, -0.28498531, 0.207266244, -0.229972747,
+    -0.0744290986, 0.0426939473, -0.0641753642, -0.100900871, 0.0651955941, 0.234627801, 0.207653597, -0.124077997,
+    0.267462351, 0.3016139, 0.224468978, -0.0331219914, 0.11413414, -0.303023707, -0.178885131, 0.0415684929,
+    -0.00468684116, 0.0269678198, 0.144903046, -0.106991108, -0.0250767603, -0.0926002003, -0.0506172097, -0.109604892,
+    0.176598333, 0.102181747, 0.210066976, -0.158635542, -0.15873383, -0.107170393, 0.216093407, 0.021933547,
+    0.0956226664, 0.146388372, 0.276642813, -0.287457822, 0.142024081, -0.190827446, 0.262249657, 0.10653252,
+    -0.242143852, -0.0842920145, 0.122786359, 0.00206103156, 0.19991657, 0.223960934, -0.277279219, 0.253794329,
+    -0.178185674, 0.095904658, -0.221259879, 0.129451608, -0.234415548, 0.227837772, 0.121493098, -0.0606964922,
+    -0.198128834, 0.253552443, 0.0623767182, -0.115573928, -0.221743641, 0.0233079773, 0.115829323, 0.266600847,
+    -0.216644873, 0.144551893, 0.176296262, 0.056586771, 0.0756134555, 0.268947066, -0.285168311, -0.250808891,
+    -0.302413369, -0.228020491, 0.179656283, 0.272693677, -0.0196414312, 0.117466749, -0.0444082539, -0.124541876,
+    -0.243082633, -0.0982085131, 0.0120823701, -0.175840589, 0.0289597757, 0.0376537937, -0.145476652, 0.293331116,
+    -0.0472741, 0.0587867272, 0.311029911, -0.305314729, 0.0642042967, 0.214093282, -0.291288837, 0.0345796281,
+    0.227262235, 0.108687779, 0.25831438, 0.115442245, 0.0123406995, -0.127478748, -0.017914656, -0.0461050046,
+    -0.0756849652, 0.0612744147, 0.235031508, 0.271965858, 0.0291794583, -0.118681858, 0.312406833, 0.114184564,
+    0.0875928204, 0.164769279, -0.143288374, -0.0818510808, 0.0699373268, -0.00944464605, 0.155381949, 0.194893038,
+    -0.249969704, -0.160399118, -0.281789921, -0.229092113, -0.12187424, -0.0606014816, 0.126381016, 0.126382255,
+    -0.0299507854, -0.0902301512, 0.136304005, -0.114251163, 0.038019685, -0.0978345135, -0.185715128, 0.0812071595,
+    0.0565998607, 0.162734018, 0.126817803, -0.0849413604, -0.256177222, 0.171271365, -0.0397420172, 0.277148313,
+    -0.307111283, -0.206587502, 0.14247888, 0.174891469, -0.248838911, -0.068488043, -0.104559771, -0.00678684173,
+    0.285192922, 0.175180282, 0.306076795, -0.154680255, 0.203052772, 0.250555796, 0.18139489, 0.151881057,
+    0.152066811, 0.274970492, 0.303644492, -0.0864001097, -0.199557126, 0.0181628213, 0.0779905982, 0.146009992,
+    -0.0890678138, 0.0792019567, -0.250904957, 0.0555330311, 0.309115394, -0.308294667, -0.0566998289, 0.214854369,
+    0.288263626, 0.294750024, 0.101165513, 0.0897587784, 0.232193546, -0.106604287, -0.109460558, 0.266408693,
+    0.229682639, 0.124130854, 0.154452717, -0.227006285, 0.281920454, 0.192703006, -0.0887239352, 0.0701475607,
+    -0.0591411591, -0.0158448342, 0.1886869, -0.260292193, -0.121017833, -0.122855809, -0.168258731, 0.268360153,
+    -0.168234183, 0.142325162, 0.107077692, -0.297863171, -0.23754577, -0.278665769, -0.265594459, 0.19673777,
+    0.247406414, 0.139211637, 0.177051666, -0.0138110189, 0.0800759603, 0.254984703, -0.245676378, -0.0083535861,
+    -0.203885563, 0.047519857, -0.267477506, -0.177768182, -0.0624473575, -0.23158233, 0.201098732, -0.129654315,
+    0.0861470051, -0.011442323, -0.258036039, 0.0285710236, -0.0478938174, 0.140999296, 0.0633783212, 0.235565784,
+    -0.234985015, -0.136533175, 0.182811684, 0.0221847191, 0.26669431, -0.111472537, -0.237470316, -0.215993032,
+    0.270369877, 0.180033582, 0.302492855, -0.107009614, -0.142137288, -0.0316471132, 0.220452763, -0.299480048,
+    -0.0443313767, 0.234499277, -0.171027123, -0.0875207886, -0.141372847, -0.20156823, -0.0788825196, -0.0829493716,
+    0.0729641776, -0.150064061, 0.293054249, 0.163806849, 0.159921438, -0.20722343, -0.00318570901, -0.261785309,
+    0.253368669, -0.234734523, 0.212941885, 0.00532205122, 0.0431836725, 0.158410585, 0.294548835, 0.146373287,
+    0.133755187, -0.0395138368, -0.0863517161, -0.0119996161, 0.308203176, 0.202450827, 0.173462169, -0.227214102,
+    -0.0147230178, -0.16082056, -0.0175509944, 0.168977595, 0.157088336, -0.309983489, 0.274593155, -0.136824533,
+    0.192602235, -0.187801903, -0.161886462, 0.167331726, 0.0304200407, 0.200980896, 0.0394211032, 0.108203175,
+    -0.0907433806, -0.21482551, 0.212758503, 0.0589139173, -0.24404069, 0.129981823, -0.183576084, 0.0222027624,
+    0.0192513649, -0.242348822, 0.255585661, -0.192555874, 0.0644704564, 0.0444090561, -0.18182174, 0.283085441,
+    -0.2241144, -0.00664144224, -0.0859768306, -0.0482483473, 0.20404121, 0.192097567, 0.158992647, -0.0241101649,
+    0.170300048, 0.145846543, -0.261031674, 0.110055115, 0.129981486, -0.0776604794, -0.279508648, 0.0399549925,
+    -0.307384994, -0.300679075, -0.0266248208, 0.169689715, -0.18857205, -0.170686205, 0.279105845, -0.238079194,
+    0.111581024, 0.0560054104, 0.280423929, -0.241943516, 0.216641836, 0.0443233078, -0.129521429, -0.224317222,
+    -0.249999578, 0.02522041, 0.0588210834, -0.0441886919, 0.179543283, 0.114111284, -0.277109015, -0.0693978906,
+    -0.128769009, 0.112184679, -0.0445709088, 0.143746648, 0.210999219, 0.0909409236, -0.302134652, -0.0166162942,
+    -0.0533630681, 0.226146503, -0.174809469, 0.168218187, -0.275553051, 0.211169275, -0.215979469, -0.215902644,
+    0.0632132282, 0.128727433, 0.157498361, 0.169515367, -0.0886003477, -0.30037333, -0.0466982841, 0.177839853,
+    -0.056762816, 0.225241654, 0.313410627, 0.285911904, 0.113819898, -0.155433338, 0.252132267, 0.278913586,
+    -0.0499933267, -0.166562879, 0.181337084, -0.100653669, -0.155515469, 0.292082099, -0.111979386, 0.0869626098,
+    0.285681154, 0.196185563, 0.308920109, -0.227887357, 0.152960387, -0.0517426597, -0.113066498, -0.254246284,
+    -0.0548625001, 0.277218826, -0.122031743, 0.00917153302, 0.286345678, 0.109992628, 0.258495379, 0.139763639,
+    0.17505153, -0.209356643, 0.0366551721, 0.0743324622, -0.134887994, 0.0576454163, -0.244973273, 0.0247943916,
+    -0.250295127, 0.0834470353, -0.0235013461, -0.0250658536, -0.253887659, -0.0983477705, 0.165840424, 0.266089262,
+    0.100035832, -0.0835266503, -0.0768987177, 0.0322245182, -0.194638407, -0.0616164158, 0.0305962911, -0.20844714,
+    0.16747549, -0.14260177, 0.00150624521, 0.104497531, 0.0156629611, -0.211671411, -0.285695981, -0.232629062,
+    0.289023068, 0.219336984, -0.141330846, -0.289676964, 0.0186670359, 0.244077175, 0.13251533, 0.291616505,
+    -0.269407253, 0.139281025, -0.0844399278, 0.047334631, -0.0706274144, 0.0714544314, -0.0926262244, 0.027421195,
+    -0.249582342, -0.0306889404, -0.150881019, -0.000809720454, -0.132398458, 0.294343892, 0.0809302724, -0.082631317,
+    0.110765842, 0.151773006, -0.0988456804, -0.240839377, 0.0609486103, -0.255258943, -0.175160252, -0.163426095,
+    0.171248163, -0.217513128, 0.133210194, 0.194119385, 0.307380947, -0.0892680691, -0.154176815, -0.0887058099,
+    -0.0410583922, -0.281733037, -0.256146941, -0.226979757, -0.303668362, 0.238516575, -0.214084756, 0.212099601,
+    -0.0910567407, -0.0639357937, -0.209426691, -0.293858328, 0.243120797, 0.223807725, 0.0988181704, -0.249050692,
+    -0.220191651, 0.296935799, -0.155528205, 0.292193188, 0.0691132344, -0.142034012, -0.280937386, 0.0678600524,
+    0.299884956, 0.0948151187, 0.279630846, 0.119177985, -0.114894052, 0.301289694, 0.0857163683, -0.106698195,
+    0.19864398, 0.160907316, -0.0340428386, 0.195604684, -0.00154417316, 0.0283661825, -0.184547949, -0.238958104,
+    0.0824778792, -0.198961139, 0.0806912082, 0.114229687, -0.153392607, 0.217619739, 0.194780206, -0.194417684,
+    0.311275915, 0.188798658, 0.0346807629, 0.156308072, -0.285835854, -0.130465334, 0.20960251, -0.19060114,
+    0.207069219, -0.236692516, 0.0931754206, 0.0918293328, 0.131590915, -0.186775203, 0.258393995, 0.0752210764,
+    0.241798219, 0.0893684618, 0.000740146458, -0.0128974714, 0.298244587, 0.180043448, 0.104994888, 0.232539983,
+    -0.310970811, -0.0752762697, -0.180922435, -0.241281201, 0.294042596, -0.046602703, -0.104946121, 0.263718614
+};
+template<typename T> const T DnnLayer<T, 0>::b[37] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0
+};
+template<typename T> struct DnnLayer<T, 1> { static const T w[37*35]; static const T b[35]; };
+template<typename T> const T DnnLayer<T, 1>::w[37*35] = {
+    -0.0297750587, 0.140747813, 0.27883603, 0.213085377, 0.103567197, -0.13272646, 0.222657446, 0.273490489,
+    0.173339008, 0.0272052995, 0.189515941, -0.034865136, -0.242553172, 0.1855414, -0.140475617, 0.175028728,
+    -0.162641688, 0.0792349666, 0.227351179, 0.175402135, 0.248256557, 0.00827484104, -0.241877563, 0.0844727489,
+    0.16211341, 0.141619952, 0.173318579, 0.260209969, 0.217588609, -0.115000384, -0.260305216, 0.151806651,
+    -0.264948211, -0.122920048, -0.134882067, 0.263297887, -0.00327287372, -0.135129575, 0.123813189, -0.0967567818,
+    -0.270030544, 0.172983438, 0.000619582443, 0.272703257, -0.157994219, -0.163836727, -0.276704058, -0.253190811,
+    0.27793661, -0.284630957, -0.198204772, 0.060524389, -0.13168834, -0.107132689, -0.235199208, 0.21540631,
+    -0.136284263, -0.0752788012, -0.0427628007, 0.156198707, -0.250941208, 0.0628077722, 0.241475824, 0.0813197534,
+    -0.168432072, -0.0589092877, 0.0301632606, 0.178644344, -0.0943375317, -0.207753476, 0.184895866, -0.218490057,
+    0.238437417, 0.0172940944, -0.148373563, 0.0116868141, 0.134823326, 0.249861456, 0.169613592, -0.120366761,
+    -0.0571223553, 0.0969313922, -0.158718009, -0.21481819, 0.283180677, -0.0168790807, 0.147750517, 0.10238017,
+    -0.279645633, 0.271623882, 0.189708407, -0.12866938, -0.214619361, 0.107155093, -0.21958038, 0.260434678,
+    -0.0269592556, -0.0139934474, 0.123729271, -0.28437973, 0.279230706, -0.186946522, 0.16619558, -0.00963076983,
+    -0.149991038, -0.140283401, 0.19573484, -0.244443003, 0.209859939, -0.274070829, 0.146642411, -0.221126439,
+    -0.267362484, 0.0112999872, 0.0867894376, -0.207513128, -0.0555115362, -0.0717730162, -0.248032223, -0.266563643,
+    -0.126067204, 0.117604011, 0.233444046, -0.0244212967, -0.143289031, -0.148995994, -0.0899901898, 0.197490955,
+    -0.096860942, -0.0471295578, -0.114985571, 0.115109019, 0.0990338857, -0.282623449, -0.0118466498, -0.162531236,
+    -0.0996640856, -0.119761423, -0.0686464021, -0.196452313, -0.207751771, -0.169318964, 0.0386224903, 0.0878104886,
+    -0.240978261, 0.0931581328, 0.0300253575, -0.0473931264, 0.07519463, -0.246140135, -0.0554070029, 0.177536952,
+    0.198130203, 0.209082082, -0.0373946656, -0.203791225, 0.134401391, -0.271023345, 0.0717556867, -0.139931914,
+    0.150523974, 0.0626121569, -0.195257566, -0.0323113503, 0.176188768, 0.0517598771, 0.0231424615, -0.0271316063,
+    0.0102252271, -0.110348884, 0.142651445, 0.00554229015, 0.257342155, 0.149317493, -0.0117298604, -0.271469001,
+    -0.0894839099, -0.0353445738, 0.0925357365, -0.0162834344, -0.171475977, 0.152080967, 0.0457022976, 0.002959259,
+    0.0438435015, 0.206014455, -0.135172734, 0.192325976, -0.0483376546, 0.271868079, 0.113043612, -0.106936236,
+    0.00485462738, 0.267244549, 0.033431914, -0.0456306709, -0.244833102, 0.0977976426, 0.136989472, -0.112870804,
+    -0.103855953, 0.110427959, 0.0885042008, -0.0264704099, 0.285957427, -0.269751137, -0.265121128, -0.264064962,
+    0.211851255, -0.22295407, 0.18477272, -0.0107877286, -0.227278994, -0.155391676, -0.0379468177, 0.270494847,
+    -0.0607556438, -0.276000552, -0.205004568, 0.00072669265, 0.159467868, 0.0135589629, 0.0770831879, 0.255763487,
+    -0.0637689379, 0.228268751, 0.0484050903, -0.166455682, -0.274960297, 0.262071021, 0.192142336, -0.104057645,
+    -0.266028361, -0.175942002, 0.18060547, 0.200764941, 0.045685918, -0.0355354203, 0.110905086, 0.113097254,
+    0.246699148, 0.249442396, -0.268238966, 0.0437976948, -0.223033348, 0.0820475529, -0.116845089, 0.0445632678,
+    0.149566249, 0.279113571, -0.00267754209, 0.0254366904, 0.0377359835, 0.277321734, 0.161611769, 0.0955177511,
+    0.125822873, 0.167074375, -0.139215586, -0.261191358, -0.0527580336, 0.0661803046, -0.0372188987, -0.157145733,
+    0.0468125491, 0.196998441, 0.0484024552, 0.0294210786, -0.046255601, 0.280482569, -0.236640971, 0.241714928,
+    0.262807205, -0.267380798, -0.150401767, -0.138519089, 0.200848439, 0.0431794265, 0.180679074, -0.0555324843,
+    0.223169914, -0.216063097, -0.0680860731, 0.14398179, 0.156983602, -0.084851038, 0.221882543, 0.0664446881,
+    -0.196186178, 0.26617091, 0.0747583996, 0.22244319, 0.236267217, -0.155642709, 0.168383465, -0.160297752,
+    0.204600813, 0.0575982531, 0.195405247, 0.237673929, 0.0522437952, 0.0551953573, 0.135719284, 0.0741656153,
+    0.191114046, -0.267454126, -0.235524549, -0.219607713, -0.0390841079, 0.245140597, 0.115282756, -0.146025155,
+    -0.234575479, 0.0970544436, 0.0792049827, -0.0422866418, -0.243125074, 0.163633933, 0.0905935386, 0.14353906,
+    -0.225157716, 0.273342683, 0.262733969, 0.174986513, -0.0582939206, -0.0924551757, 0.0923466851, -0.265604364,
+    0.114709634, 0.0471638655, 0.0292980121, 0.259202506, 0.0949965464, 0.13421413, -0.16453742, 0.0449154204,
+    -0.212463725, -0.201219842, -0.198538848, 0.183790946, -0.242023191, 0.0478977509, 0.281021572, -0.250102791,
+    0.227370958, -0.136543555, -0.0729929073, -0.0221755271, -0.0357755365, 0.0763213792, 0.286847609, 0.035031404,
+    0.216495611, 0.257634623, -0.157004351, -0.0639387133, 0.121024714, 0.229433065, 0.0484793491, 0.137586706,
+    0.104121008, 0.19003045, -0.0588878981, 0.26475323, 0.0949566924, 0.2450545, 0.0305659648, -0.0488324338,
+    -0.117123741, -0.247601631, -0.126293755, -0.0838362678, -0.268237812, -0.156130153, 0.178273698, 0.0661287421,
+    -0.25886195, 0.225653686, 0.268312909, 0.254513332, 0.249713837, 0.075772143, -0.133390018, -0.0081963948,
+    -0.169947411, -0.0880026879, 0.0281365935, -0.102273683, -0.256368556, -0.017121421, 0.194934676, 0.143361957,
+    0.0189515062, -0.197160159, -0.126668441, -0.234688039, 0.167593987, -0.0448285376, -0.019227915, 0.147512088,
+    0.202194509, -0.135745166, -0.115655124, -0.199859791, -0.211186577, 0.262051368, 0.108549319, -0.00637335083,
+    0.257471057, 0.223319413, -0.114890411, -0.212639067, 0.0730141123, -0.109630916, -0.211999898, -0.0921156195,
+    0.0718028747, 0.0218570145, -0.18554449, -0.0104545758, -0.275329376, -0.140330195, -0.0843585052, 0.0923784344,
+    -0.231226717, -0.132226579, 0.0510587932, 0.0573634419, 0.00779963248, -0.267299513, -0.243648656, 0.183386326,
+    -0.000897139148, -0.0961037519, 0.23996815, 0.0311024239, 0.262121549, -0.0737250717, 0.163770737, -0.028194068,
+    -0.184781903, -0.248250749, 0.090720463, 0.205603626, -0.0515000911, 0.0127377742, 0.161643465, -0.0323805962,
+    0.272349432, -0.250598632, -0.137235872, 0.116930275, 0.141995341, 0.122588939, 0.0709686562, 0.224222806,
+    0.21726794, 0.178073976, 0.24299645, -0.0619418733, -0.247208971, 0.258096014, 0.019853515, -0.286235003,
+    0.195774598, 0.259399636, -0.15113285, -0.182468351, 0.153814242, 0.16068973, 0.00642861352, -0.103086729,
+    -0.00195620618, -0.0410168228, 0.172431299, -0.125037664, 0.0984797146, -0.0690481356, -0.262635465, 0.0492991749,
+    0.0841907035, -0.231651844, -0.262981094, 0.137151963, -0.0531083584, -0.247120443, -0.00710547571, -0.193077616,
+    -0.000869876559, -0.225425249, 0.121792162, 0.189330478, 0.268488076, 0.192231969, -0.180430762, -0.242046494,
+    0.193179801, 0.273476324, 0.219693163, -0.183042602, 0.145392726, -0.170877043, -0.130404468, -0.0392017721,
+    -0.280455332, -0.161470278, -0.263044033, 0.10665415, -0.259394989, -0.129720518, -0.210926925, 0.0819726173,
+    -0.0582438325, -0.00887687414, 0.226453375, 0.142005769, -0.24440166, -0.26275185, 0.270464729, 0.217044074,
+    0.145720465, 0.0685458911, 0.097130411, 0.183630118, -0.0457001915, -0.208632466, -0.168621338, -0.276575009,
+    0.268072163, -0.272914632, -0.254386586, 0.00916695008, 0.0321918358, -0.247692769, -0.146181446, 0.194498102,
+    0.154761299, -0.035752498, 0.198868915, 0.130427021, -0.159532678, -0.174257172, -0.264238278, -0.138668754,
+    0.240037304, 0.188480174, 0.122736218, 0.285973055, 0.104037391, -0.0886209109, 0.190027648, -0.272492805,
+    0.233903516, -0.227206445, -0.234371904, -0.236432246, -0.113942575, -0.0964702512, -0.077072901, 0.140751497,
+    -0.0926888452, -0.0988308228, 0.134579618, -0.28578794, -0.0243921965, -0.027974143, 0.125325502, -0.272893897,
+    0.173347763, -0.00691688179, 0.156228087, 0.0737872777, 0.0508781979, -0.147469144, -0.136355533, -0.144377564,
+    0.202191777, 0.119170905, -0.0697459232, -0.216962233, 0.170068173, -0.0546864344, 0.272556338, -0.22660615,
+    0.0949268222, 0.169057651, -0.171615164, -0.209484097, 0.0653733972, -0.175828566, 0.262710301, 0.0838968801,
+    0.198593255, 0.158867936, -0.230476588, 0.0261838955, 0.116655513, -0.281415137, 0.00608578624, -0.207259472,
+    0.0150977847, -0.165418588, -0.0249282394, 0.248397223, 0.231038113, -0.226383634, -0.171473392, -0.118553364,
+    -0.276984771, -0.215154571, 0.22260224, -0.0763543538, 0.198953501, -0.152176424, -0.22425101, 0.287213121,
+    0.206562334, -0.167486669, -0.279567782, 0.0747707978, -0.108055002, -0.225693096, -0.268476322, -0.120678738,
+    -0.101815209, -0.115310746, -0.236431413, 0.0630193098, 0.201477265, 0.233637955, -0.257932748, -0.121934523,
+    0.0436334069, -0.259423273, -0.177017014, -0.106803353, 0.190291733, -0.252777225, 0.279402861, 0.0751235802,
+    0.0474701378, -0.0445762197, -0.226778123, 0.0190016667, 0.232311246, 0.074527175, 0.242519141, 0.0818810038,
+    0.0279569179, 0.229609349, 0.26205446, -0.0319557523, 0.0472429306, -0.271719134, -0.0879082284, 0.0881147715,
+    0.010486186, 0.287106595, 0.136912271, 0.18231389, 0.068472965, 0.0647532198, 0.0646260552, -0.0299208087,
+    -0.153848084, -0.0679222157, -0.205652912, -0.21576723, 0.0839045512, 0.110056935, 0.0338778308, -0.114748161,
+    0.145305898, 0.062959449, -0.136686796, 0.272969278, -0.0960366995, -0.0496743697, 0.106334834, -0.202354787,
+    0.220960937, -0.00108968009, -0.22271675, 0.263005586, 0.134943621, 0.16007949, 0.170920913, 0.182599678,
+    0.0113862665, 0.0556324124, 0.269444321, -0.135863196, -0.162083282, 0.0920515921, -0.072478266, 0.146641055,
+    -0.00706289254, 0.0778864746, -0.20008942, 0.0172719752, -0.121647785, -0.194004005, 0.0901172358, 0.170493221,
+    0.187728695, -0.118979619, -0.20408382, -0.106995345, -0.219952765, 0.126428878, 0.0358537035, 0.124124146,
+    -0.157512843, 0.0286783074, -0.192245762, -0.0313909997, -0.0417904212, 0.146143853, -0.0593484104, 0.00923630497,
+    0.118236676, -0.123954304, -0.27197133, -0.251256945, 0.124969779, 0.210561714, 0.207574294, -0.258287101,
+    -0.0716696304, -0.285833537, -0.263689913, 0.258308683, 0.0106703348, -0.169312375, 0.217336881, -0.0607518169,
+    0.202509098, -0.158433913, -0.185564491, 0.185157154, -0.199339534, 0.1176405, -0.123028715, -0.0525286602,
+    -0.177677423, 0.0214966675, 0.213594437, -0.241990362, 0.118768487, -0.0580658652, 0.00771571166, 0.0661848661,
+    -0.140538301, 0.0529353331, 0.137150608, -0.118975914, 0.0209457996, -0.117741434, -0.00829417206, -0.0683282062,
+    -0.160183729, -0.182734257, 0.0759711358, -0.150018474, -0.019025031, -0.168048539, 0.0757040079, -0.205637631,
+    0.03486258, 0.0610654571, -0.171711784, 0.021097199, 0.0763200895, 0.110748735, -0.142130588, 0.279140736,
+    0.0511278796, -0.172324035, 0.150810613, 0.143990574, 0.00664614994, 0.00395899531, -0.0102576459, 0.0452204413,
+    -0.208069772, -0.108106608, -0.0835308939, 0.00859485557, 0.249409576, -0.0743460156, -0.162061123, -0.172389206,
+    -0.244467318, 0.182508652, -0.0961720027, 0.190457809, 0.213233285, -0.00440357878, 0.0838716338, -0.0666815569,
+    -0.136193619, 0.172571391, -0.118890194, -0.0522785364, 0.141286534, -0.131500203, -0.122835821, -0.229752596,
+    0.0538843553, -0.237366398, -0.0850056468, 0.199398952, 0.081091179, -0.265194661, -0.0436427912, 0.161826365,
+    0.19017022, -0.0168847024, 0.079554317, -0.143899811, -0.13884124, 0.138604361, -0.22534939, -0.168613208,
+    -0.119561433, -0.282932216, 0.0536381045, 0.238439465, -0.128803921, -0.158574963, 0.132039486, -0.248771114,
+    0.0493577851, 0.201343002, -0.095262269, -0.254048923, -0.126068534, -0.17557702, -0.0982552949, -0.0117495422,
+    0.160119885, -0.185132854, 0.201210984, -0.098661151, 0.184905102, -0.172289048, 0.230516831, 0.0883221548,
+    0.214689679, 0.171624174, 0.217864801, 0.0195670315, 0.124516251, 0.0270101842, -0.0200108212, 0.138086963,
+    -0.0454031401, 0.00557893801, -0.196968124, 0.0279122367, -0.0746164196, 0.14681498, -0.287836204, -0.0908169975,
+    0.0387603977, -0.270505825, -0.208201262, -0.0736331006, -0.114079904, -0.247755204, 0.135112953, 0.132728614,
+    0.238848354, 0.223845736, 0.256576781, -0.280816887, 0.0455621592, 0.181525811, -0.114512583, 0.0605033835,
+    0.198900021, -0.0318671681, 0.11291298, 0.0626044199, 0.263828666, 0.167211015, 0.275606926, 0.0194259296,
+    -0.259385224, 0.209558507, -0.23303895, -0.110863713, 0.142671609, 0.217749481, -0.0474202947, -0.245692871,
+    0.0596386913, 0.16348666, -0.268783987, 0.262803884, -0.0676951682, 0.286136461, -0.105884491, -0.061205315,
+    -0.0379523719, 0.145872322, 0.0246627428, 0.0569624491, -0.0427327535, -0.197053576, 0.0347090081, 0.153347698,
+    0.11114505, 0.192320554, 0.237861308, -0.263452781, -0.167082455, 0.13250416, 0.0043855354, -0.241689974,
+    0.106820568, 0.148981259, 0.0657034541, 0.00680726819, 0.0110241871, -0.138523632, 0.071331461, 0.0154944281,
+    0.223904309, 0.162514553, -0.243206313, -0.111111485, -0.198396864, -0.082283028, -0.109078038, -0.128712037,
+    0.0974681882, -0.026472377, 0.230856435, 0.0718960612, 0.0577350428, -0.116509595, -0.181618977, -0.118165148,
+    -0.0902984742, 0.212343151, 0.276572327, 0.00870192768, -0.150696284, 0.283137722, -0.0139912056, 0.234206774,
+    0.143919112, 0.238617942, 0.0833340072, -0.199501975, -0.0447760759, -0.020935153, 0.255130444, -0.23752268,
+    -0.263237078, -0.160158733, -0.252919997, 0.187364328, 0.0821190884, -0.0595881708, -0.0106552442, -0.130716432,
+    -0.258082662, -0.1701466, 0.28784598, -0.0641842831, -0.133022491, 0.0534992219, 0.262161531, -0.101757442,
+    0.010651589, 0.237996193, -0.0691430728, 0.158948774, 0.137537315, 0.012204631, 0.0919101209, 0.0823262897,
+    -0.232478016, 0.197542176, -0.0415353173, -0.248384913, -0.00166985182, 0.0431509865, 0.0810747861, 0.0422186074,
+    -0.266322468, -0.227098509, -0.233660427, -0.0744737769, -0.250189952, 0.206141947, -0.108623969, 0.204240948,
+    -0.0580081646, -0.256895013, 0.19116687, -0.00584104792, -0.10998467, 0.205590125, 0.134019186, -0.161613938,
+    0.0401398228, 0.0883538734, 0.166266607, 0.219255355, -0.21637373, 0.0915075425, -0.00333252474, -0.158839763,
+    0.184735894, -0.235761334, 0.264507738, 0.118309609, 0.140131679, -0.0681770195, -0.0515004499, 0.225489135,
+    0.228544906, -0.0184167258, -0.0373664647, -0.261133289, -0.266513971, 0.254361727, -0.205329944, 0.0356993771,
+    0.0554094097, -0.122312354, -0.076529389, 0.0830286646, -0.22558003, 0.0350988015, -0.0235041401, -0.0998049391,
+    -0.16336361, -0.0387567708, 0.19617351, 0.030763278, -0.205894827, 0.0639738816, 0.243248288, -0.0845802824,
+    -0.198200242, -0.269896721, -0.0792016484, 0.160483829, -0.0272580069, 0.0119308535, -0.0394693903, -0.198166807,
+    0.235478381, -0.1400585, -0.036537243, -0.198361301, 0.282261905, -0.217070576, 0.0446847724, -0.202444524,
+    -0.224119147, 0.231631664, -0.0873054782, -0.236490574, -0.251499261, -0.136951372, -0.111301273, 0.0591682009,
+    0.0768211692, -0.00422032988, -0.104323418, 0.0884186972, -0.141012602, -0.282522535, -0.0854448512, 0.181949247,
+    0.210737461, 0.205530295, -0.163348837, -0.260885008, 0.189466447, -0.125084485, -0.0550330742, -0.142217927,
+    0.150073197, -0.174144444, 0.254572893, -0.177749411, 0.0632054238, 0.0971456207, 0.184988946, -0.260546719,
+    0.177689307, 0.234659193, 0.0451275616, -0.214211176, 0.157204862, -0.194004279, -0.0200455187, 0.0709678831,
+    -0.215970647, 0.248068208, -0.149643496, 0.191344585, 0.168653673, -0.136998568, -0.0739466535, 0.0630299455,
+    0.0958915482, 0.118606497, -0.274276544, 0.208447624, 0.0154074158, 0.192662549, -0.169077102, 0.0229224596,
+    -0.227361024, -0.103264139, 0.23163237, 0.02814278, 0.0377220201, 0.172113698, -0.146240488, -0.237772649,
+    -0.262121329, 0.175602088, -0.159587511, -0.0058690065, -0.184222249, -0.215654907, 0.274721313, 0.266986292,
+    -0.237800815, 0.0245146144, -0.178889668, 0.0786982324, 0.0733192976, 0.214345778, -0.0940510051, 0.146407081,
+    -0.272662511, 0.275057644, -0.0465121913, -0.210389362, -0.25730147, -0.197707653, 0.28303509, 0.229141939,
+    -0.0719144028, 0.0956523816, 0.226275372, -0.120714474, -0.104428986, 0.144118504, -0.272201699, 0.0396884343,
+    0.0199009339, -0.0959667145, -0.0719980965, 0.209271719, -0.173412111, 0.136732996, -0.106903504, 0.228600835,
+    -0.0241917535, -0.0473266008, 0.17913391, 0.202013565, 0.158373067, 0.0986827997, -0.0325335492, -0.219364993,
+    0.0700426957, -0.0195566167, 0.160269451, -0.248878191, -0.237715063, -0.173419569, 0.0936136923, 0.108451252,
+    -0.201371968, 0.134572289, 0.138930245, 0.186750645, -0.0927834552, 0.0492233594, 0.20808238, 0.0735830336,
+    0.0172414037, -0.271489795, -0.180852688, 0.183899244, 0.067127976, -0.119440828, -0.236001446, 0.179459592,
+    0.177775292, -0.112881718, -0.274227078, -0.18736562, -0.0625268378, 0.0108275328, 0.0200880839, -0.084252253,
+    0.16393781, 0.122435792, 0.287566762, 0.189324192, 0.222845339, 0.13400013, -0.22187228, -0.0729788969,
+    -0.165749384, 0.0936112467, 0.235741153, 0.214482594, 0.184530502, -0.22007712, 0.159273007, 0.184336587,
+    -0.266153253, -0.248701663, 0.286021923, -0.135397462, 0.0574890302, 0.0117787251, 0.124807787, -0.254916364,
+    -0.0401446416, -0.0408779009, 0.21613562, 0.172486253, -0.226837736, -0.225047357, -0.223693908, -0.0104433471,
+    0.224269529, -0.216354034, 0.101337264, 0.179747597, 0.0129610892, -0.258024268, 0.123947282, -0.287110716,
+    0.246838896, 0.195078573, 0.179628254, 0.0597832806, -0.135296128, 0.25677518, 0.0854598898, -0.0409213835,
+    -0.0614021931, 0.126045928, -0.0829265427, -0.188454643, 0.0246305224, -0.134870952, 0.0318487665, 0.110071456,
+    0.0654720081, 0.160346727, -0.152102661, 0.186130596, 0.166396085, -0.178632372, 0.238192776, 0.198580446,
+    -0.181743868, 0.140219231, 0.0274081294, -0.0369867413, 0.193392387, -0.113799736, -0.11751711, 0.0369481038,
+    0.0890123865, -0.161174926, -0.255329009, -0.243627402, -0.254399943, 0.22624548, -0.128129024, -0.141956952,
+    -0.0285374617, -0.00432578071, 0.0960133691, 0.0746080586, 0.257387833, -0.0368362316, 0.233275621
+};
+template<typename T> const T DnnLayer<T, 1>::b[35] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0
+};
+template<typename T> struct DnnLayer<T, 2> { static const T w[35*30]; static const T b[30]; };
+template<typename T> const T DnnLayer<T, 2>::w[35*30] = {
+    -0.0394124259, -0.00956802039, -0.134815821, 0.294452951, 0.214957172, -0.172609043, -0.267057693, 0.075248981,
+    0.0361454097, -0.159382711, -0.0407564642, 0.297921176, 0.238211647, 0.159548162, -0.10093589, -0.237102879,
+    0.0487274397, -0.105682417, -0.0481673429, 0.161273978, 0.195191487, 0.132219701, 0.294536792, -0.0239759947,
+    -0.090573104, -0.0776997989, -0.0247148833, -0.255317627, -0.0786248349, -0.12283954, -0.017749302, -0.113597848,
+    0.0898847287, -0.185625909, 0.0802529557, -0.0619786292, -0.207853941, 0.294147893, 0.0332898748, 0.203007834,
+    -0.186005593, 0.19235933, 0.270227059, 0.0202620892, -0.212081103, -0.101784213, 0.0357179059, -0.109013603,
+    -0.0954648689, 0.168281585, -0.297780184, 0.18521746, 0.186268864, 0.104562767, 0.0508881313, 0.174054543,
+    -0.172070426, 0.0990292928, 0.157797315, 0.178600082, -0.0185468557, 0.00498490976, 0.200428708, 0.156779098,
+    0.0920487698, 0.120325501, 0.01089683, -0.18717254, -0.218219514, 0.288537892, -0.137867461, 0.279413178,
+    -0.204127011, -0.297379811, 0.00746130064, 0.219516428, 0.153137678, 0.19904626, -0.0196523489, -0.300579962,
+    -0.223466792, -0.0741044042, 0.0835659302, 0.0983210727, 0.00912089404, -0.0521130939, -0.0213281928, 0.0644466438,
+    0.0951309731, -0.0499832309, -0.00943847794, 0.0448817778, 0.219886862, -0.0834145465, -0.0763792237, -0.0335262316,
+    -0.120674983, 0.207581716, -0.0198528587, -0.0327637491, -0.17837325, -0.241821384, -0.289324762, 0.29530325,
+    0.196939986, 0.162987941, 0.0933390678, 0.252546486, 0.0536584542, -0.262998863, 0.0134166678, -0.230358509,
+    0.2039617, 0.161616912, -0.141586223, 0.120035017, -0.244863081, -0.0838801361, -0.0594349022, -0.111576806,
+    0.138323488, 0.295957745, -0.217869876, 0.0984537619, 0.0772071981, -0.217095791, 0.0134023282, 0.0435927493,
+    -0.14837179, -0.129651876, -0.287913542, -0.274647101, 0.213418069, -0.258942403, -0.163624314, 0.119210868,
+    -0.285376623, -0.164722449, -0.260645195, 0.154563402, -0.0618401449, -0.211769235, -0.274459173, 0.201354021,
+    -0.127423513, -0.19800684, 0.114800783, 0.191300394, 0.117855776, 0.0239645348, 0.234343054, 0.224100059,
+    0.229540677, -0.246233967, 0.01449174, 0.0227040327, -0.0595999519, 0.144942549, -0.0973259921, 0.174191594,
+    -0.0254563547, -0.191582745, 0.259982191, 0.247647476, 0.258623723, -0.0961393694, -0.243318517, 0.286629095,
+    -0.196615331, -0.0750849072, -0.21003767, 0.042208472, -0.23812425, -0.108828741, 0.0349966654, 0.0909885559,
+    0.131665723, -0.296256319, -0.0522911637, -0.272952572, -0.196346867, -0.0727667958, 0.245984085, 0.23742816,
+    0.14924925, -0.272866952, -0.227600266, -0.0678984889, -0.0194486606, -0.193179891, 0.0354735528, 0.100747111,
+    0.232585426, 0.303666416, -0.184386072, 0.0855549757, -0.274744935, 0.0683349131, -0.251162796, 0.175096857,
+    -0.112898326, 0.0942628374, 0.0979549316, -0.119867187, 0.0467926318, 0.0563488356, 0.116243454, 0.214413708,
+    0.243713029, 0.229149659, -0.184496431, 0.107603645, 0.172671535, 0.196587159, -0.230635425, 0.138880011,
+    0.219794469, 0.280955205, -0.226057523, 0.0798722438, -0.251776164, -0.0291980449, 0.0815015194, -0.106277284,
+    -0.0615883733, 0.132506055, -0.295122353, 0.0260462126, -0.153033057, -0.29660215, -0.0100661565, -0.170400582,
+    -0.142235642, -0.0280911526, -0.00547159556, 0.227982884, -0.29799926, 0.0538555918, -0.280267884, 0.0853218957,
+    0.102530594, 0.286148268, 0.0422882094, -0.225351245, -0.141521619, 0.253211418, -0.288821866, 0.247796021,
+    -0.0433446144, 0.247370783, -0.0169210049, 0.301016261, -0.191644513, -0.290286008, 0.101075876, 0.10514362,
+    0.203109762, -0.0183709909, 0.154371216, -0.0324371526, -0.302098709, -0.0627741269, -0.0870565597, 0.129323465,
+    0.152824463, -0.164795834, 0.134473103, -0.237427402, -0.263046346, -0.164663018, -0.105510067, -0.0783568354,
+    -0.0523693096, 0.135307395, -0.137314423, 0.0652350036, 0.00885747828, -0.15922856, -0.0749224025, -0.201372479,
+    -0.118465831, -0.102527312, -0.253144674, 0.047943262, 0.222645044, 0.295393138, 0.0697708984, 0.296237745,
+    0.116258681, 0.0963569786, 0.0234197648, -0.219822238, 0.23777465, -0.295396103, -0.17568076, 0.204601609,
+    -0.123121447, -0.191259743, -0.0399002854, -0.174332169, -0.0503112369, 0.208720786, -0.0830457097, -0.114622345,
+    -0.0510185761, 0.13155518, 0.197357578, 0.0732898278, -0.158393041, 0.153971761, 0.301675364, -0.282781908,
+    0.0566516333, 0.0198307973, -0.214444687, -0.015178107, -0.297061321, -0.264373771, -0.0199800527, -0.0665579277,
+    -0.0637043791, 0.153798807, 0.0457203788, 0.171222341, -0.095320277, -0.0687263713, 0.0059093537, -0.0314872124,
+    -0.00649366704, -0.139798743, -0.0501072098, 0.189748803, -0.138769667, 0.188815292, 0.0251860059, 0.144971498,
+    0.228028605, 0.0510050021, -0.219828664, 0.225335286, -0.0357858941, 0.200381793, 0.110290523, -0.160145363,
+    0.284112895, 0.129931792, 0.0571722469, -0.148208975, 0.0363875032, 0.0219331945, 0.0641136753, 0.131039578,
+    -0.205870978, 0.0964407712, -0.145658056, -0.179238573, 0.102788247, -0.181774317, 0.178208989, -0.139469729,
+    0.0272414116, 0.114884083, 0.264441619, 0.0762038356, -0.118460368, 0.143142186, -0.113798922, 0.267858951,
+    -0.24203786, -0.0276976047, 0.280580991, -0.237773917, 0.273117724, 0.24536623, 0.202787576, 0.141689286,
+    -0.213059757, 0.0851198625, -0.199639653, 0.0939330278, 0.167771537, -0.180722544, -0.0100326043, -0.0394124722,
+    -0.292276079, 0.239302808, 0.277157344, 0.159777373, -0.0760176004, 0.111623479, 0.290430015, 0.00287764322,
+    0.216990777, -0.240315059, 0.0621573911, 0.0288545454, 0.266970254, -0.0571537315, 0.0663524026, 0.250228888,
+    0.282713906, -0.021434946, -0.0324317772, -0.0260090367, 0.13346095, 0.0212667833, -0.142489838, -0.14393959,
+    -0.279951601, -0.186583559, -0.0521211437, -0.0148123743, -0.140710488, -0.0429851885, -0.254913297, -0.162677463,
+    0.299279931, -0.219997772, -0.25286973, -0.265883008, -0.232277681, 0.113910406, -0.168283683, -0.0393438645,
+    0.0155826018, -0.171239608, -0.236325291, 0.168218432, -0.119203943, 0.0021272578, -0.110836933, 0.00730923977,
+    0.298694045, -0.198243174, -0.100131196, -0.260720639, 0.197094076, -0.000903771207, -0.206922036, 0.22750147,
+    -0.131469445, -0.228994918, -0.136803076, 0.26594535, 0.212748481, 0.145375431, 0.181605334, -0.26098864,
+    0.0450374633, 0.0572905217, -0.0920721921, -0.0843863247, -0.205776739, 0.0864704346, 0.159025063, -0.137463394,
+    0.0932315989, 0.219265436, 0.228098437, -0.162061795, -0.120614699, -0.247799682, -0.22950359, 0.0360588235,
+    -0.261699807, -0.269029822, 0.0145824181, -0.167285921, -0.168020729, 0.0231481378, 0.0525598353, -0.149505427,
+    0.118856204, -0.257784135, 0.29252291, -0.0668143051, -0.0448236098, -0.0611461741, 0.0214878304, -0.00979489219,
+    -0.0348930454, -0.0526772781, 0.218559427, 0.194004692, 0.254590514, 0.0356117964, 0.211905262, 0.176967458,
+    -0.133792768, 0.230628983, 0.186503269, -0.0828739405, 0.286340385, 0.1154319, -0.135477835, 0.223250595,
+    0.176158207, 0.081590227, 0.227739246, 0.00767793769, -0.287635873, -0.293873361, -0.205602598, -0.259089155,
+    0.105447562, 0.0252756067, 0.000874643482, -0.0520183252, -0.117033533, -0.137364952, -0.0107303545, 0.269127123,
+    0.173044607, 0.0468907408, -0.057437221, 0.302660793, -0.176126331, -0.180968008, -0.214733464, 0.238511198,
+    -0.0298674915, 0.157534902, -0.0305145056, -0.297327024, 0.238527596, -0.267942392, 0.2415795, 0.0408984883,
+    0.301963976, -0.0102805502, -0.219494586, -0.0923330886, -0.222269016, -0.265499709, 0.253485489, -0.229566049,
+    0.213978946, 0.227582466, 0.285218733, 0.298832684, -0.0066918274, 0.000561006871, -0.265893203, -0.112186216,
+    0.214211911, -0.209661333, 0.104310484, 0.0386310412, -0.023914707, 0.231564862, -0.139772598, 0.292640692,
+    0.123571969, 0.166334169, -0.0657614258, 0.252253043, -0.17364667, -0.0647191995, 0.0267839178, -0.159137846,
+    -0.0738297314, 0.139176292, -0.0407280487, 0.0539687739, -0.272054054, 0.169146216, 0.214847134, 0.186334092,
+    0.102210319, 0.229907446, -0.0843671787, 0.271962333, 0.0494327196, 0.108751779, -0.211688455, 0.10678723,
+    0.233664275, 0.0231560889, 0.225812663, -0.0483087889, -0.210163808, 0.283311809, -0.30166103, -0.247952117,
+    0.234895517, 0.0667893165, 0.129225223, 0.301814722, -0.104996672, -0.213376857, 0.0464434483, -0.0498096941,
+    0.226530928, -0.140847688, 0.267153673, -0.199305291, -0.101480436, -0.290052659, 0.301570632, -0.185750374,
+    0.0107930123, -0.135692312, -0.301303054, 0.252686277, -0.297653454, 0.192497889, -0.185495277, 0.16119514,
+    -0.0580872314, 0.29243284, 0.223169579, -0.255796163, 0.0524746722, -0.260903056, -0.158642851, 0.116901984,
+    -0.0879696784, 0.299438914, -0.081617686, -0.181865285, 0.0287058538, -0.236258817, 0.104426911, -0.297277102,
+    0.0360207949, -0.150904478, 0.168567862, -0.0396513439, -0.216264597, 0.153585413, 0.0286712682, 0.114576098,
+    0.157232716, 0.223339264, -0.180377466, 0.288877093, 0.172839868, -0.00853066998, -0.179014258, 0.0286095641,
+    0.284454049, 0.120236374, -0.233254308, -0.141758295, -0.0122877116, 0.05076691, -0.0850851788, 0.121608378,
+    0.144392743, -0.0363236756, 0.299465103, -0.197305787, -0.292683707, -0.178576782, -0.303048591, -0.088504222,
+    -0.184557449, -0.0350600532, -0.0537215153, 0.130461742, -0.173604247, -0.0874214016, 0.00399456832, 0.0918343892,
+    0.0908357332, -0.179818771, -0.198569212, 0.0154245384, 0.0156366906, -0.0862776559, -0.173753385, -0.132776545,
+    0.181834225, -0.203767922, -0.00332508766, -0.258194966, 0.0575059354, -0.168831146, -0.0763387898, -0.153141322,
+    0.166316362, 0.0333068498, 0.137213229, 0.193339463, 0.0247300514, -0.107850326, 0.0592855229, -0.301392009,
+    0.221006017, 0.124797606, 0.250248462, 0.0283475343, -0.018237564, 0.260122626, -0.25541958, -0.0121622081,
+    -0.208246041, -0.211430089, -0.129732577, -0.0497287946, -0.0203482197, -0.00473719562, -0.0168722512, 0.242028463,
+    0.187393487, -0.189519857, 0.273210045, 0.227768104, -0.0116908863, -0.208205968, -0.0252456904, 0.0744002194,
+    -0.179708956, 0.149695285, -0.2133521, -0.0466973097, -0.207480788, -0.296373958, -0.0223030342, 0.0577004964,
+    0.2343999, -0.179876122, -0.0598653569, -0.0953572603, 0.235247111, 0.129437246, -0.0639815261, -0.0449939529,
+    0.0133138551, -0.0496037305, 0.272677763, -0.180758426, 0.195477265, -0.215799682, 0.0667397717, -0.140632413,
+    -0.247704439, 0.10135054, 0.0774205243, 0.211332031, 0.27785609, -0.135316027, 0.193023429, 0.0757520138,
+    0.204001526, 0.0948757397, -0.16115187, 0.231981625, -0.14795588, -0.281087577, 0.186457582, 0.272278631,
+    -0.230955501, 0.0175779065, -0.224114857, -0.181275939, 0.0139201141, 0.0688613537, 0.206963012, 0.101321334,
+    -0.246501312, -0.135098398, 0.183078825, 0.265226516, 0.129404759, -0.161360215, 0.0751243014, 0.278297513,
+    -0.0407875151, 0.186688793, -0.235775848, -0.23406244, -0.295775922, 0.12128866, 0.250632178, -0.0368549256,
+    0.0896095091, 0.22355659, -0.183968419, -0.286401895, 0.144709604, -0.0696052339, -0.179524536, -0.238916577,
+    -0.0496504958, -0.0376167194, -0.131005037, 0.260904425, -0.28493081, 0.280209891, 0.293927241, -0.237464195,
+    -0.153653321, 0.0784745704, -0.0542543184, -0.175156366, -0.226703369, 0.26540321, -0.0302012078, -0.182147428,
+    0.0763290057, 0.0869814622, -0.172879594, -0.0502895916, 0.130548548, -0.271841037, -0.285101754, -0.115150347,
+    0.219693394, 0.0318079022, 0.266418006, -0.129994478, -0.183349065, -0.0994541886, -0.102533092, 0.198354374,
+    0.162116973, 0.260197974, 0.126829135, 0.25976109, 0.146737691, 0.0110533456, 0.290212142, -0.276715691,
+    -0.10573746, -0.111207472, -0.211051403, 0.0283550242, -0.10179501, -0.082096744, -0.293724687, -0.0912211721,
+    -0.0160674791, -0.0313374284, 0.267875354, -0.261370539, -0.209361066, 0.278495328, 0.0705074524, -0.0360314577,
+    0.0329175142, 0.247048483, 0.127774991, 0.168897475, -0.268011197, 0.147895402, -0.107060936, 0.246868133,
+    0.259923471, -0.0768494056, -0.244925862, -0.250951155, 0.26883279, 0.00284640075, -0.00333243729, 0.0125984661,
+    -0.220361854, -0.222075398, 0.0554458184, 0.187914146, -0.192009443, -0.221892735, -0.134817097, 0.143670394,
+    0.146551093, 0.287296984, -0.272114522, -0.21433643, 0.227306866, 0.0981705721, -0.110115544, -0.0244300418,
+    0.279709357, -0.0596342737, 0.260965837, -0.026421273, -0.257299357, -0.266872083, 0.285103934, -0.174229265,
+    0.190987363, 0.184859456, -0.0147123373, -0.238463437, 0.157974551, 0.0182237496, -0.235966311, 0.0942823581,
+    0.149527509, 0.266720344, 0.0399177088, 0.274221315, -0.259169028, -0.196547094, -0.28934675, 0.264805995,
+    0.252477236, 0.266769608, -0.0446687734, -0.111766789, 0.196245353, -0.0924434183, 0.129151745, -0.253584127,
+    0.277435376, 0.189287395, 0.27358431, 0.195098066, -0.287422681, -0.0800418081, 0.0015992299, -0.102229803,
+    -0.110639065, 0.203309535, 0.0818045419, -0.0526664161, -0.0922267875, 0.0128413479, 0.0236816097, -0.263421007,
+    -0.071013158, -0.297406094, -0.190902692, -0.207996864, 0.0693563018, -0.0201224882, -0.232546934, -0.214584044,
+    -0.0888280423, -0.10660016, 0.242933297, 0.098936995, -0.184177082, -0.090570491, 0.215851718, -0.0636438307,
+    -0.111948659, -0.02213331, 0.205764908, 0.171072338, -0.228002704, 0.00565447904, 0.282717257, -0.212169206,
+    -0.00596893214, -0.302706499, -0.00231208986, -0.109083567, 0.085546725, -0.0322795285, 0.212431676, 0.281406339,
+    -0.255672622, -0.0345095212, 0.158329902, 0.153892131, -0.00809796983, 0.294478072, 0.0464332135, 0.0395831577,
+    0.0533511819, -0.194596056, -0.0978327757, -0.059408259, -0.0574256117, 0.0331706714, 0.00780976235, 0.0979393506,
+    -0.0717291544, 0.110477735, -0.0521971981, -0.190042659, 0.0397432607, 0.106402191, 0.178581092, -0.11312567,
+    0.0376810538, 0.279665578, 0.155894238, -0.189652623, 0.287348651, -0.215223093, 0.216154855, -0.278473089,
+    -0.0127937844, -0.117641136, -0.0564951918, -0.108687448, 0.0799075964, 0.267006466, -0.00579158265, -0.00188076761,
+    -0.228840051, -0.212927667, 0.192417225, -0.0440748814, 0.028976055, -0.0217845244, -0.0583773464, 0.199015624,
+    0.257418602, 0.221181754, -0.166546935, -0.300477191, 0.191755006, -0.229387036, -0.130367119, 0.0110091994,
+    -0.020186027, 0.225429963, 0.0572085466, 0.0854628837, -0.140723236, -0.280457252, -0.245888205, 0.17965018,
+    0.0170229775, 0.222119399, 0.0218485567, -0.103483734, 0.0868972948, 0.274014321, 0.248571857, 0.0280828346,
+    0.158133575, -0.169690343, -0.211919931, -0.244480092, -0.120192404, -0.0398006945, -0.0197806227, 0.0230251058,
+    0.198646311, 0.16274544, 0.0530330799, 0.0211677151, -0.00687720406, -0.211975057, 0.202810493, 0.0686577712,
+    0.189244324, -0.204180346, -0.198654433, -0.0101051858, -0.0638044298, -0.114481198, -0.139414715, -0.288931103,
+    -0.0683099229, 0.0506254951
+};
+template<typename T> const T DnnLayer<T, 2>::b[30] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0
+};
+template<typename T> struct DnnLayer<T, 3> { static const T w[30*25]; static const T b[25]; };
+template<typename T> const T DnnLayer<T, 3>::w[30*25] = {
+    -0.208360083, -0.0394632705, -0.297520331, -0.2921516, -0.249677036, -0.311122271, -0.0402500858, 0.144802361,
+    -0.313819911, -0.162233776, 0.17597925, -0.310894882, -0.23735428, 0.23249992, 0.078786817, -0.100644716,
+    0.260376609, -0.326300003, -0.222538454, 0.293514093, -0.0815214252, 0.190603109, -0.292544643, 0.190872071,
+    0.0134568759, -0.17458379, -0.0592681403, 0.263659836, 0.16437164, -0.0912795062, 0.300898817, -0.0645114042,
+    0.168335718, -0.208074618, 0.016691702, 0.266917717, -0.25051434, -0.153160951, -0.0676059563, 0.266959732,
+    0.171613488, 0.291748398, 0.0131412887, -0.260686738, -0.186914826, -0.279549503, 0.204744035, -0.0140038023,
+    0.118251455, 0.0981213427, -0.161344162, 0.109536738, 0.306848044, -0.319839872, 0.107175733, 0.208735821,
+    0.0886449604, 0.306176775, -0.0710453963, -0.0394337405, 0.254061246, -0.0328813616, 0.148758081, 0.00461579801,
+    0.236260671, 0.0345383547, -0.230856037, -0.227778645, 0.0503606462, -0.0952905606, 0.0377665997, 0.304662188,
+    0.0123210149, 0.0738126139, 0.0423886845, 0.310916053, -0.20308356, 0.0505034303, -0.0391522038, 0.279873967,
+    -0.234896515, 0.255891973, 0.0395485194, 0.181495651, 0.00394695623, 0.0270136856, 0.22805339, 0.24981785,
+    -0.288379428, -0.244531036, 0.0819974662, -0.0730798502, 0.251929424, -0.139379785, 0.240923651, 0.221251046,
+    -0.0770679932, 0.200224276, -0.0946800671, -0.213120774, 0.000464456125, 0.154264959, 0.260614431, 0.28506642,
+    -0.215687408, 0.0114549287, 0.0569473708, 0.205746155, 0.0834515303, 0.0799918386, 0.197624863, -0.143397907,
+    -0.192700964, -0.283808608, -0.062213985, 0.00310928264, -0.139071322, 0.0412401233, 0.259185262, -0.0175722569,
+    -0.112906974, 0.18255144, 0.112807115, 0.00832450234, -0.0352422848, 0.204821132, 0.139762789, -0.256608294,
+    -0.0927391046, 0.161999741, 0.246946311, 0.058881837, -0.302243421, -0.327488892, 0.0921493946, 0.156915983,
+    0.316664156, 0.0840647343, -0.101769131, 0.32508211, -0.144176221, 0.0262468692, 0.0841400511, -0.0197981152,
+    -0.118652275, 0.30773732, -0.221722433, -0.00682800882, -0.119560283, -0.123782037, 0.0609792904, 0.23797754,
+    0.228903843, -0.228303844, -0.182242389, -0.0869097282, 0.11390722, 0.0760539052, -0.129512985, 0.145563748,
+    -0.0799405057, -0.224878385, 0.0768908201, -0.00976886508, -0.0212026202, 0.0600352853, -0.270663392, 0.302567606,
+    -0.10969695, -0.0673656638, 0.0542238916, -0.297461715, -0.0234459818, 0.0250623096, -0.0960214493, -0.278639795,
+    -0.110572345, -0.0503912364, -0.121401891, 0.230991807, -0.0686702449, 0.222415186, -0.217684129, 0.274762368,
+    -0.00420763234, 0.127312029, -0.209805404, 0.0996340269, 0.228443593, 0.147481633, 0.182801614, 0.0324008134,
+    0.109271221, -0.251717903, -0.0603748196, 0.289593485, -0.000335940638, -0.320687993, 0.0730119853, -0.12312251,
+    -0.107099289, 0.232730291, -0.305986205, 0.114221745, -0.223029559, -0.278261896, 0.303932844, -0.25951553,
+    0.163588069, -0.280130708, 0.0399871596, -0.000482722929, -0.0459890943, 0.292792529, 0.199875229, 0.135460752,
+    -0.299249534, -0.0132132353, -0.167847842, 0.269758252, 0.1159279, -0.208385098, 0.188569703, -0.320049313,
+    0.011576276, 0.327080842, -0.163474519, 0.298356428, 0.326744541, -0.12326022, 0.310159517, -0.217297348,
+    0.312287395, 0.11755507, -0.160604816, 0.269233209, 0.0479162218, -0.260080695, 0.161097311, 0.223186283,
+    -0.232863521, -0.269137798, -0.219745954, -0.097726455, -0.305796721, -0.32617522, 0.16314383, 0.163660195,
+    -0.142957146, 0.258341294, -0.0220865392, -0.157821432, -0.100803699, -0.243008251, 0.0962123087, 0.292814565,
+    -0.0199184089, 0.121993658, -0.265375974, 0.238517131, 0.104473894, 0.239458721, -0.00423865354, 0.0645094791,
+    0.225869609, -0.283615282, 0.00656569569, -0.101996249, -0.227598066, 0.274115197, 0.0918515998, -0.259920629,
+    0.272665449, -0.17788702, -0.210483077, 0.29212691, -0.196828516, 0.0870050361, -0.0421439684, 0.0716503139,
+    0.164073812, 0.117374132, -0.0623648836, -0.275397984, -0.0113251936, -0.102588074, -0.328998569, 0.0724215951,
+    -0.247881428, 0.0777305509, -0.229930367, -0.202495086, -0.0359523992, -0.0496146971, 0.188622999, -0.0291229567,
+    -0.0228254398, -0.201562732, -0.124216495, -0.27389618, -0.0557720412, 0.114766948, 0.249308206, -0.175994496,
+    -0.179359605, 0.125052386, 0.0351865219, -0.0282103687, 0.260667793, -0.0398807989, -0.244330785, -0.29285621,
+    0.139377533, -0.0356855657, 0.1881212, -0.0190142086, -0.277218876, -0.125425112, 0.304008282, 0.0167720524,
+    -0.0277709285, 0.158249631, 0.0649706462, 0.278032047, -0.0093006012, -0.243932345, -0.231426441, -0.205245691,
+    0.271862657, -0.217311706, -0.0439223925, -0.000612135954, 0.214613068, 0.141178615, 0.153185819, -0.0192528526,
+    -0.172449262, -0.275818382, -0.000369282875, 0.231393624, -0.037503004, 0.147514253, -0.0485764949, -0.292679453,
+    0.178707077, 0.177055241, -0.279485452, 0.125558036, -0.0188202049, -0.0853691276, 0.189774791, 0.0775986838,
+    -0.168248691, -0.0537474022, 0.1845629, 0.0996807652, 0.31777049, -0.151311523, -0.267779029, -0.236089138,
+    0.150890732, -0.311041848, 0.309899351, -0.0751727895, 0.0466903262, -0.296208455, -0.0751622081, -0.0282820573,
+    0.059054098, 0.173304477, 0.292086199, -0.147742745, -0.0761475853, -0.012854044, -0.163568669, 0.25018899,
+    -0.328408364, 0.0316904485, -0.261637398, -0.254272077, -0.300981808, 0.247787053, -0.0808200276, -0.184321232,
+    -0.134188868, 0.318595967, 0.104972138, -0.0305979046, -0.0145544639, -0.318157765, 0.207276519, -0.184459368,
+    0.13030355, 0.270606187, 0.301350475, -0.246348733, -0.0843042358, -0.272739099, -0.27509621, -0.105570817,
+    0.0185201675, -0.240452563, -0.0696262887, 0.223323556, -0.305825461, -0.281128777, 0.183912323, -0.232928161,
+    -0.0492771545, -0.0465864762, 0.0967513427, -0.127766062, -0.214938673, 0.229208428, 0.054962356, 0.205985347,
+    0.292407011, -0.21892241, 0.211010275, -0.0660121108, 0.140577927, -0.105244723, 0.258992565, 0.175269582,
+    -0.0596121583, -0.15567477, -0.154115036, 0.140376009, -0.174838932, 0.19532952, -0.104080216, 0.175609553,
+    -0.322822034, 0.266007902, 0.0146691264, -0.104951428, 0.308436938, 0.103626915, 0.228150354, 0.197545269,
+    -0.127481427, -0.292261872, 0.100704811, -0.238405327, 0.110867745, -0.215670972, -0.19437787, -0.12973301,
+    -0.305094539, -0.238914597, 0.100854493, -0.310469246, 0.121525935, 0.0445894485, 0.200660757, -0.263569659,
+    -0.280109361, 0.289361782, 0.205287877, 0.26184665, -0.136274478, 0.086021718, -0.2726068, 0.240954146,
+    0.134071495, -0.0970720281, -0.156326336, 0.187699211, 0.241167419, -0.173125485, -0.158583656, 0.2304463,
+    0.286461918, 0.0530407236, 0.137390798, -0.235801034, 0.0892954779, 0.0539877456, -0.0768287131, -0.130454261,
+    -0.202673211, -0.158580387, -0.0831039202, -0.0915383408, 0.0394808954, 0.138868818, -0.0633490762, -0.185409201,
+    0.23468403, 0.293228983, 0.0026568372, 0.0379634973, -0.13567574, 0.043174929, 0.0366206548, -0.157732614,
+    0.0962992813, 0.277714171, -0.0117131347, -0.278080527, -0.295249956, -0.031059889, 0.14156435, -0.274700012,
+    -0.0946093553, 0.259021587, 0.038146418, -0.234069671, -0.00278470382, 0.263438172, -0.066190646, 0.11675344,
+    0.043901539, 0.111593928, 0.204435854, -0.31314251, 0.262419127, -0.102749124, 0.094920547, 0.190496764,
+    -0.0803952075, 0.115203665, 0.0433168334, -0.140051371, 0.166046802, 0.00387169738, 0.267226254, -0.0798178664,
+    -0.2255088, 0.0715484598, -0.244458443, -0.141625084, -0.00352450168, 0.0642830557, 0.0302396046, 0.1712983,
+    -0.133759121, 0.312284503, -0.211560213, 0.284746365, -0.298858719, -0.116034087, 4.38649492e-06, -0.155449726,
+    0.217449842, 0.275585856, 0.254581893, -0.219621769, -0.0975295424, -0.105590518, -0.17502153, -0.326438749,
+    0.219046306, -0.0613396655, 0.0575247123, 0.233128454, -0.157508926, -0.21252396, 0.0850987635, 0.19231623,
+    -0.313584518, -0.262857514, 0.272475165, -0.194382294, -0.0933287488, -0.265500609, -0.0981641446, -0.170482505,
+    -0.238228143, -0.309223019, 0.266681276, 0.205144809, -0.208607481, 0.114079726, 0.222654639, -0.261460003,
+    0.0147270131, 0.110380401, -0.323744153, 0.178856527, 0.259643854, -0.167683014, -0.0497160898, -0.129339803,
+    -0.125229309, -0.294599254, 0.0354714375, 0.118233591, -0.309165867, -0.2327539, -0.150786069, -0.000190712107,
+    0.00174385892, 0.100970739, 0.323901552, -0.0595586509, -0.297854919, 0.173386654, -0.209120416, -0.31630581,
+    -0.243660018, -0.278382529, 0.205663219, -0.0448772276, 0.0964298594, -0.0152223182, -0.187921948, 0.259982121,
+    0.170744133, -0.186545124, -0.0138490262, -0.0389002568, -0.0331249042, -0.316197288, -0.131808307, -0.0931994175,
+    -0.129744509, 0.153402352, 0.29117035, 0.315192747, -0.275116841, -0.311367372, -0.296233447, -0.193936685,
+    0.0944567855, -0.082488701, 0.244525051, -0.0465807843, -0.0108143073, -0.290184974, 0.318368582, 0.156002548,
+    0.206867919, -0.0165589276, 0.178326616, 0.195013539, 0.0327573833, 0.105213253, -0.155074179, 0.122952839,
+    0.0292783285, 0.0759169509, 0.195894362, 0.300991549, 0.10678501, -0.0211742542, -0.0107031003, 0.216425921,
+    0.1678195, 0.274681708, 0.0207916258, 0.0766831079, 0.024095422, -0.25349361, -0.146860831, -0.327892348,
+    -0.264757505, -0.19415856, -0.195491901, 0.241152376, 0.0502498437, 0.203902117, -0.324094507, -0.195667779,
+    -0.320129017, 0.0519143303, -0.00445482122, 0.293109857, -0.049737797, 0.196397612, -0.164099694, -0.138668248,
+    0.312506381, 0.132016917, 0.0411176446, -0.0982099595, -0.315099696, -0.179166659, 0.031813832, 0.160339459,
+    -0.222407853, -0.0289984119, -0.206245869, 0.191114555, 0.193586253, -0.197982185, -0.0947031063, -0.0331897418,
+    -0.153679912, -0.298134743, -0.309817679, 0.0407711509, -0.310671747, -0.281842383, -0.023342949, -0.217766824,
+    0.206218492, 0.139177652, -0.0466023945, -0.0435514601, 0.229839582, 0.27025739, -0.217784079, 0.282074953,
+    0.0922483944, -0.147155379, 0.329851581, 0.269776802, -0.215489886, -0.160071692, 0.213625759, 0.0608357246,
+    0.268931357, 0.174434982, 0.26107576, 0.322317848, 0.146943596, 0.0533441716, -0.0142428981, 0.216113706,
+    0.308549076, 0.239643085, -0.326662504, -0.0938020422, 0.232407789, -0.242993675, -0.162404464, 0.139274843,
+    0.288142813, 0.103088515, -0.0439623743, 0.0525640421, 0.288032031, 0.20323117, -0.281514039, 0.079577364,
+    0.187173475, -0.15385449, -0.0628870571, -0.0624712081, 0.262601382, 0.0664639472, -0.216047436, 0.100575075,
+    -0.294008778, 0.211507094, 0.13744599, -0.0427087434, 0.220237851, 0.232386631
+};
+template<typename T> const T DnnLayer<T, 3>::b[25] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0
+};
+template<typename T> struct DnnLayer<T, 4> { static const T w[25*30]; static const T b[30]; };
+template<typename T> const T DnnLayer<T, 4>::w[25*30] = {
+    0.28730921, -0.0509276964, 0.302142912, -0.211043576, -0.0765078812, 0.27670578, -0.286986055, -0.240627231,
+    0.0823584859, -0.0130574056, 0.300630113, 0.0961354744, 0.171175224, 0.278461223, -0.152567087, -0.0100041495,
+    -0.0322851707, 0.28128648, 0.209639205, 0.0546822959, -0.134699637, 0.248411374, -0.27682769, -0.328857707,
+    -0.0540370216, -0.294830116, 0.224609336, 0.0650298631, 0.0888763321, 0.323547222, 0.30744167, -0.260666978,
+    0.204590805, 0.113117715, 0.186074214, 0.196234801, -0.17753509, -0.0234097049, 0.284959043, 0.233474824,
+    0.12010135, 0.076300948, -0.147781439, -0.148946572, 0.320299893, -0.120359163, 0.0377862388, 0.243230079,
+    -0.154189766, 0.0665829398, 0.278106409, -0.0319260856, 0.231665111, 0.271248706, 0.0543511637, -0.326870218,
+    -0.163522903, 0.326402585, -0.0551852451, 0.296031536, 0.235426652, -0.00613475277, -0.165432846, 0.29619623,
+    -0.277894255, 0.272792181, 0.206446087, -0.198873452, 0.0116168825, -0.0271943649, -0.0909804622, 0.136382305,
+    -0.0620536684, -0.221945809, 0.116822623, -0.000439571542, 0.00156279676, -0.00593970699, -0.185912878, 0.204307516,
+    0.219025879, 0.275442562, -0.323368536, 0.0273734006, 0.0944623548, 0.292845869, 0.196971571, -0.0498799988,
+    -0.0473445505, -0.139449228, 0.329847637, 0.148864686, 0.199298862, 0.283856243, 0.0176043298, 0.0150270431,
+    -0.0541063837, -0.224194031, -0.097779782, 0.107670092, 0.219726265, 0.238285013, 0.144680245, 0.168387229,
+    -0.0151137041, -0.233484116, 0.17136496, -0.276461842, -0.151720751, 0.0366126293, 0.189621516, 0.29808005,
+    0.0607378118, -0.270012235, -0.285210784, -0.219882549, 0.0205829181, -0.258379155, -0.126383174, 0.305264753,
+    0.315919296, -0.32709868, -0.282024547, 0.20527828, 0.111307653, -0.019513306, 0.0150361718, -0.182294246,
+    -0.298845087, -0.240098327, -0.323068934, 0.0882825045, -0.270473696, 0.0504531978, 0.0107023533, 0.0818013133,
+    0.0826538081, -0.187502799, -0.11585862, 0.258738446, 0.274035401, -0.315914658, -0.163769288, 0.235095706,
+    -0.31299725, 0.273978259, -0.261787745, 0.0652396191, -0.225556671, 0.175967183, 0.32290894, -0.312477413,
+    -0.0459548185, -0.163230884, 0.221553571, -0.137929418, 0.0130680445, -0.14924771, 0.301698102, -0.202015253,
+    0.0795846491, 0.321591231, -0.105726763, 0.275978295, -0.143433294, 0.229858753, -0.326479409, -0.30389409,
+    0.171326069, -0.121893959, -0.120467926, 0.262788961, 0.179046961, 0.0815628476, 0.117559865, 0.0148250598,
+    -0.100872733, 0.311049758, 0.189025379, -0.0230871343, 0.114272625, -0.121498287, 0.311186163, 0.209597615,
+    0.23675192, -0.0154317087, -0.0705600644, 0.255515833, -0.158990948, 0.27698266, -0.0596549433, -0.117796817,
+    0.305675905, -0.0988633415, -0.0453699574, 0.128211602, 0.053719754, 0.166539753, -0.144884678, 0.167292843,
+    -0.161876021, -0.23044064, 0.188896147, 0.22380996, -0.249140257, -0.178590992, -0.0103358584, -0.0778245352,
+    0.292695116, 0.320070866, -0.170272804, 0.261833507, 0.068348783, 0.0267336552, -0.284264054, -0.0229527626,
+    0.129688206, -0.0711798873, 0.131494077, -0.190344657, 0.126493651, 0.327995622, -0.13217981, -0.13460756,
+    0.0814468087, 0.0715883122, 0.251677556, -0.224311924, -0.00749988721, 0.263933276, -0.0808909374, 0.00539730611,
+    -0.201413866, 0.115475868, -0.234182571, 0.0328582917, 0.145815777, 0.259982127, -0.0789398273, 0.238235615,
+    0.121481971, 0.182844456, 0.0348070133, -0.286323553, -0.182490737, -0.17452729, 0.123722008, 0.304797859,
+    0.0422154236, 0.0983239346, 0.211666006, -0.280363538, -0.018094843, 0.0266370051, -0.00220640047, -0.202822657,
+    0.0446264649, 0.192457976, 0.202307817, -0.0545555973, 0.0611317415, 0.168883312, -0.14910612, 0.13947333,
+    -0.298642559, 0.241578754, 0.287532741, 0.241867005, -0.0860765158, -0.229025767, 0.195675758, 0.166992263,
+    0.246853526, 0.251257351, 0.322854228, -0.0991420294, -0.174360708, 0.277549106, -0.0308852594, 0.32236124,
+    -0.175950909, 0.174958743, 0.24632958, -0.217598662, -0.308813829, 0.175736253, 0.24821048, 0.063429232,
+    0.0412136072, -0.276660016, 0.0210946481, -0.205729484, 0.163228098, -0.0720289245, -0.0859340327, -0.14153556,
+    -0.19755581, 0.130881473, 0.250185777, 0.262125791, 0.230711527, 0.257548679, -0.113491384, -0.0623834711,
+    0.21257442, 0.123664696, -0.253877649, 0.236610137, -0.0826579967, -0.00666986271, 0.265424526, 0.0626546755,
+    -0.154246483, 0.0194835706, -0.0505004928, -0.290942761, -0.216736975, 0.179222616, 0.213802302, 0.259326485,
+    -0.0476435801, -0.216686156, -0.13612312, 0.0927201697, -0.0575100222, -0.0988798084, -0.0181862823, 0.17712095,
+    -0.0753309544, 0.178073229, -0.317481113, -0.255103867, 0.191057963, -0.0184953794, 0.0308319646, 0.127950999,
+    -0.165246327, 0.00834916581, -0.199327839, 0.241850191, 0.259954639, -0.0236146721, -0.296484924, 0.0800290774,
+    0.144768084, -0.321528121, 0.047825804, -0.122566977, 0.00208380067, -0.318614278, 0.240982463, 0.287051334,
+    -0.250726313, -0.139492436, 0.0237294689, 0.0625786612, 0.0557325301, -0.0501549179, -0.199922364, -0.0528038194,
+    -0.159782652, -0.0263561338, -0.0720524296, 0.0503993969, -0.0844993694, 0.203929728, 0.18356945, 0.309832669,
+    -0.196483881, -0.308861701, -0.0232920017, -0.135591577, 0.212781968, 0.216293429, 0.321217737, -0.0912796253,
+    -0.280070527, -0.11616748, -0.0741990701, 0.228876384, 0.1009635, -0.129343358, 0.290447306, 0.25970149,
+    0.208988647, -0.00259699293, -0.259413401, -0.092254432, -0.0326454641, 0.116811332, 0.187279915, 0.104090277,
+    -0.0106878287, 0.00429368927, -0.161025423, -0.275945345, -0.096777875, 0.0323862399, -0.0419092614, -0.202998217,
+    0.258351229, -0.0988568493, 0.117151538, -0.146291457, -0.297354381, -0.159623214, 0.230571624, 0.0054173688,
+    0.0695262869, 0.291695854, -0.11404658, 0.109981262, -0.272148359, 0.198655037, 0.0497803033, -0.132379608,
+    0.287358725, -0.00543551831, 0.234409498, -0.247843565, 0.323744009, 0.0671352577, 0.15245636, 0.327291367,
+    -0.137416221, -0.275803304, 0.213357, 0.0318858888, -0.11492434, -0.237236931, 0.125196025, 0.277183196,
+    -0.145851383, 0.126483702, -0.215663816, -0.313625988, -0.0166105627, 0.0609376902, 0.041011439, 0.313513816,
+    0.104547597, 0.0077573164, 0.154305029, 0.155554281, -0.207732208, 0.129372269, 0.213579459, -0.0740435297,
+    0.0461501309, -0.0937455724, -0.000206981311, 0.161770761, -0.317879749, 0.0274662479, -0.217384275, -0.285181753,
+    0.224226556, 0.0901428243, -0.138980793, -0.0696967049, -0.175597055, -0.20613718, -0.201343417, -0.15852341,
+    -0.328135732, -0.0277068396, 0.292171065, -0.188420076, -0.0353597716, -0.0305147671, -0.223241926, -0.247710801,
+    -0.111524061, 0.0554580007, -0.221451181, 0.233923773, 0.0770368341, -0.18806121, 0.240520806, 0.146274854,
+    -0.254720813, -0.0857272789, -0.270360006, 0.0456523758, -0.0870644815, -0.160218852, -0.000424782279, 0.245831372,
+    -0.0492115221, 0.164316377, 0.144546612, 0.136581599, -0.139631476, -0.132731348, 0.194755134, 0.150111505,
+    -0.0420026566, -0.0658710439, -0.218100773, 0.314180114, -0.0181251874, 0.243885657, 0.253017327, 0.301721482,
+    0.11182495, -0.233173314, 0.219801152, -0.232892072, 0.0949060793, -0.171637475, 0.0191225616, 0.181095233,
+    -0.0890594919, 0.275597863, 0.148953327, 0.0887476898, -0.326502986, -0.235715424, -0.00577223037, 0.00849833591,
+    -0.0608338634, 0.154443066, -0.0782752323, 0.131276548, -0.0898718057, -0.101147192, 0.286180415, 0.180944618,
+    -0.0767035877, -0.055313593, 0.182072212, -0.00639921032, -0.321988028, -0.0780540385, 0.261039994, 0.212921795,
+    0.0455171323, 0.0898412886, 0.139325192, -0.235651804, -0.146181306, -0.190475583, 0.227916604, -0.220238499,
+    0.269481417, -0.146378252, 0.229851248, 0.148818083, -0.307570655, -0.29264597, -0.241053471, -0.110934091,
+    -0.0811446126, 0.0866282386, 0.309707913, -0.189481879, -0.0130475807, 0.0499691626, 0.30843921, 0.294738048,
+    0.00222747331, 0.272075001, 0.123355273, -0.0790065645, -0.12435625, 0.0945546464, -0.00745321225, -0.291687203,
+    -0.25029835, 0.284350295, 0.291361666, -0.279054767, 0.151305836, 0.10611421, -0.237233934, -0.321640875,
+    0.16862548, -0.0751019235, -0.241755402, 0.0169964722, 0.0291496605, 0.297066327, -0.0544019836, -0.000623186188,
+    0.206021242, -0.120436157, -0.294461857, -0.00911767728, 0.107539881, -0.0254762662, -0.239629532, -0.270794409,
+    -0.139833045, -0.328440957, -0.096457885, -0.0547683603, 0.091831561, -0.110337005, 0.139537064, -0.0248487616,
+    -0.0156282441, 0.122262627, 0.0849487735, -0.2711475, -0.0823718102, 0.319603984, -0.295808992, -0.218172691,
+    -0.0786792948, 0.184251414, 0.252257699, 0.00807625676, -0.135358989, -0.0678535257, 0.273067011, -0.201904022,
+    -0.286680243, -0.133861067, -0.0939940732, 0.0229797979, -0.299189033, -0.214722742, -0.0634245181, -0.0963157734,
+    0.0357232948, 0.0621935893, -0.299757732, 0.277997612, 0.171138551, -0.190767519, 0.138573201, 0.010872284,
+    0.21535478, -0.00247876267, -0.202475699, 0.00549970089, 0.0358093088, 0.251045281, -0.286245091, -0.304109016,
+    0.319678287, 0.225785227, -0.325619377, 0.312799522, -0.200248457, -0.239607189, -0.227714969, -0.31716406,
+    -0.025501571, 0.0308566222, 0.050336391, 0.198518451, -0.162132357, 0.227866309, -0.167729277, 0.170624118,
+    0.170151808, 0.0842152208, -0.261854626, -0.0254088395, -0.0979337226, 0.176143135, -0.0311038893, 0.130936568,
+    -0.0723324923, -0.188527783, 0.291088512, 0.277949074, 0.105652334, -0.154268471, -0.220229009, -0.198329164,
+    -0.100701987, 0.254800645, -0.0813921458, -0.0227748285, 0.00338604383, 0.103958771, -0.156998134, 0.0751222816,
+    -0.15992801, -0.298807054, 0.148300257, -0.0842820833, 0.29691643, -0.150627782, -0.264232255, 0.222263252,
+    0.110891529, 0.309801357, -0.164091041, 0.232049521, 0.286135946, 0.156807977, 0.0763072517, -0.1077803,
+    0.256360059, -0.0391489864, -0.0697249454, -0.232494659, 0.2907044, -0.00225849993, -0.143169288, -0.330154447,
+    -0.0481393504, -0.308180734, 0.318070599, 0.306442795, -0.0718104461, -0.261757789, -0.0811358456, -0.216589323,
+    -0.212013265, -0.199109596, -0.0630794571, -0.158777234, 0.0669592879, 0.0099850864, -0.161523123, 0.236290169,
+    -0.160150049, -0.14498761, -0.140020557, -0.216170444, 0.0401500472, 0.110046208, 0.193936153, 0.238514615,
+    0.113493681, -0.129462847, 0.12624099, 0.123849092, 0.11468731, -0.296753374, 0.00167334659, -0.299153762,
+    -0.25581522, 0.134527633, -0.14183758, 0.0695681888, -0.299498522, -0.123942135, 0.157785232, 0.233811163,
+    -0.22513976, -0.291851823, -0.330188306, -0.0708460992, -0.0583314601, 0.042911499
+};
+template<typename T> const T DnnLayer<T, 4>::b[30] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0
+};
+template<typename T> struct DnnLayer<T, 5> { static const T w[30*35]; static const T b[35]; };
+template<typename T> const T DnnLayer<T, 5>::w[30*35] = {
+    0.236476293, 0.182843108, 0.21885568, 0.250489603, 0.0826278182, 0.0987883662, -0.294241086, 0.0881903381,
+    -0.118070045, 0.135184224, 0.136534277, -0.0888242245, -0.251337236, 0.282028399, 0.242561584, -0.160194874,
+    0.286804877, 0.274646445, -0.262604259, 0.114835548, 0.129292099, -0.178611168, -0.113903821, 0.00138077,
+    0.149251503, 0.0749693181, -0.256860244, 0.283237731, -0.149783584, 0.0923354082, -0.163971254, -0.187494123,
+    0.148629284, -0.137565586, -0.23240882, 0.0431510349, -0.273320408, -0.248423296, 0.236315466, -0.190423898,
+    -0.121054268, 0.0620217344, 0.27209773, -0.0970116147, -0.0600775103, -0.187402563, 0.14205769, 0.0229722959,
+    0.191640906, -0.226455306, 0.025329306, 0.0341409143, 0.12052742, -0.0593048357, -0.109761243, 0.0489224428,
+    -0.279477843, 0.0850874602, 0.198019413, -0.30053601, 0.119065036, 0.17584893, 0.0224415586, 0.0502181098,
+    0.241220714, -0.201607052, 0.187788067, 0.0582858736, 0.0246673041, 0.282642117, 0.107495205, -0.149522634,
+    -0.123931259, 0.16697586, -0.107637264, 0.204359125, 0.0553757335, -0.275995494, -0.120901482, -0.13534599,
+    -0.178676631, 0.247694532, 0.233176785, -0.0662406355, -0.154238455, 0.158551602, -0.180580043, -0.223329376,
+    0.297058331, 0.271893395, 0.0401709606, 0.110111946, -0.179835834, -0.0420093652, -0.198431161, 0.178835444,
+    0.152951392, -0.276403578, 0.260852687, -0.0390736176, 0.00363437331, -0.0314707475, 0.114976895, 0.283269147,
+    -0.057186638, 0.0460129586, 0.0316829956, 0.154598759, 0.149044612, -0.0418472909, 0.020938557, 0.301837675,
+    -0.198301775, -0.273701956, -0.185346828, 0.227398036, 0.168728178, -0.229363797, -0.0635533613, -0.0055167011,
+    0.0535994076, 0.302889622, 0.283794787, -0.273702795, -0.0405623468, -0.27489015, 0.173516432, -0.100587867,
+    0.15725553, -0.140490053, -0.242648405, 0.0355586458, -0.0496167195, -0.164893203, 0.197140124, 0.297438878,
+    -0.165237117, 0.101259854, -0.279922593, -0.0367036679, -0.0615311205, 0.211616058, -0.0707914856, -0.277424558,
+    -0.246387608, 0.267972234, 0.154124254, 0.0673023111, 0.0843766279, 0.0641022149, 0.0821923121, 0.283468096,
+    -0.0252285318, -0.09404787, -0.0156112404, 0.237102209, 0.0674736396, 0.0289753746, 0.187758438, -0.169875237,
+    0.125025547, 0.088020206, 0.137258519, -0.088473384, 0.122995147, 0.216606799, 0.0257661086, -0.12200788,
+    0.266413635, -0.1231899, -0.0926227243, -0.0754182056, 0.132407699, -0.00318129191, 0.111723709, 0.121543695,
+    0.285504825, -0.145578186, -0.0815082182, -0.0949949055, -0.132703089, 0.0207174027, -0.0422931946, -0.105571416,
+    0.168850718, -0.17649626, -0.182781577, 0.192534082, 0.156085065, -0.0882963137, 0.218381662, 0.0873254585,
+    0.134024978, 0.271662364, -0.131169164, -0.00570174842, -0.275623179, 0.113754246, 0.279258117, -0.11257278,
+    0.0110410869, 0.301633999, 0.0348379883, 0.0629145376, 0.0265277686, 0.251208593, 0.292679585, -0.00363439654,
+    -0.0518053358, -0.294094097, -0.0589107523, -0.213646988, 0.119618988, 0.26728975, 0.173327895, 0.268389863,
+    -0.277836917, 0.0383750527, -0.278042138, -0.245822238, -0.0580326685, -0.0849779843, 0.299145958, 0.0148356033,
+    0.013562095, 0.275283954, -0.227562242, 0.302821369, 0.100394702, -0.164515767, 0.244587092, 0.280841482,
+    0.220560934, 0.243360544, 0.135426611, 0.222211486, 0.148593255, -0.113123596, 0.27274938, -0.088027591,
+    0.110561869, 0.134306555, -0.185531221, -0.282389287, -0.282676564, -0.237626013, -0.0687309175, 0.0128514094,
+    0.114074167, -0.290093428, 0.187025851, 0.103444835, 0.0347094922, 0.266061303, 0.0441483019, 0.28412864,
+    -0.231606623, 0.238186624, 0.184990332, 0.10726896, -0.125850693, 0.169111666, -0.284828675, -0.0795700886,
+    0.12317673, -0.131115672, -0.266924421, -0.265180655, 0.213687062, 0.187401477, -0.192099567, -0.160547881,
+    0.0762282381, -0.0968225466, -0.274898257, 0.19504654, -0.280901875, 0.191258757, 0.00524669783, -0.174657136,
+    0.0935440242, -0.00599421363, 0.227798389, -0.0918978066, -0.220960553, 0.0619844068, 0.0184209275, -0.17738346,
+    0.0917144254, 0.0791522343, -0.0479312418, 0.294785973, -0.0204519308, 0.0566430815, -0.128115055, -0.258041032,
+    -0.090626189, -0.124206761, 0.0385835573, 0.209190506, -0.173927178, 0.01454892, 0.259896235, 0.155909808,
+    0.13141646, -0.128784554, -0.113587045, -0.101707363, -0.0975778204, -0.159712964, -0.297734864, 0.286675469,
+    0.294464903, 0.128711247, -0.124376166, -0.275637409, -0.176681389, 0.037210272, 0.161772575, 0.19462427,
+    -0.0584233371, 0.204943095, -0.191732999, 0.110533949, 0.143519873, -0.131115914, 0.134487362, -0.222048216,
+    0.0333756171, -0.16634009, -0.29746363, 0.101113049, 0.171517186, 0.0264952922, -0.208958569, 0.226354954,
+    -0.157097539, 0.149401801, -0.291627952, -0.251041025, -0.203744133, 0.262082982, 0.202781502, -0.0941613833,
+    -0.138342886, -0.28524184, 0.17775172, 0.0409459729, 0.0966973216, 0.0959059692, 0.0118086907, -0.0171701612,
+    -0.132315365, -0.238292325, -0.17120624, 0.0227565029, -0.138238857, -0.163693582, 0.175592863, 0.11943093,
+    0.0597488677, 0.0582318103, 0.247957492, 0.0292970185, 0.256216941, 0.0943897673, -0.0914114702, -0.222064248,
+    -0.197938085, -0.0697587321, -0.199928009, -0.0270031562, 0.269925311, -0.166349588, 0.280684201, 0.0576622539,
+    -0.103149873, -0.0686583762, -0.0638621398, -0.12930515, 0.296681364, -0.139720695, -0.190375331, 0.207342165,
+    0.040080376, 0.119378242, 0.201805351, -0.110181935, -0.161459634, 0.0137577653, -0.0956781428, 0.289764124,
+    -0.047348852, -0.288447409, 0.184642056, -0.0961299689, -0.22903825, -0.100481777, -0.160087414, -0.126041265,
+    -0.000475091578, -0.0332806048, 0.0392852105, -0.181385261, -0.219398668, 0.0324156215, -0.157049482, -0.177490676,
+    -0.0723565104, -0.284235917, 0.0857249054, -0.188118196, -0.221451828, -0.0611475337, 0.159176708, -0.126119375,
+    -0.291939578, -0.132700537, -0.137072955, 0.00362350953, -0.113282356, 0.185691536, -0.290964677, 0.265408286,
+    -0.0103491983, 0.202934325, 0.127887572, 0.107772778, 0.00608728847, -0.162424746, -0.0288613811, 0.054924932,
+    -0.0556977032, 0.00732608765, 0.131978914, 0.115719054, -0.176228152, -0.237372534, 0.195948196, -0.0730836977,
+    -0.274388361, -0.302658659, 0.0222164828, -0.0644460029, -0.00128387335, 0.259690856, 0.0867216674, 0.116802308,
+    -0.0421657829, -0.202564989, -0.0273549528, -0.0915034383, -0.114680593, 0.198235916, -0.117465414, -0.210056865,
+    -0.0754704063, -0.087361319, 0.162271483, 0.162149565, -0.0435873634, -0.131846603, -0.139890749, -0.160405792,
+    0.221734893, 0.0571316642, 0.168996845, 0.116041679, 0.100419797, 0.00808674612, -0.196911495, -0.131753713,
+    0.0304323695, 0.221474963, 0.175750325, 0.0548390386, 0.2892234, -0.06940266, -0.286107181, 0.202951919,
+    -0.227721551, -0.110853294, -0.0232553161, 0.285355869, -0.0109301777, 0.0962470098, -0.261527466, -0.212226001,
+    -0.176995388, 0.0177753073, 0.0885640957, 0.0983802645, -0.0761046064, -0.0207905662, -0.0901686731, 0.033453047,
+    0.0204276176, 0.146493162, 0.191193928, -0.164309711, -0.177664523, 0.27076875, -0.264982994, -0.0875609663,
+    0.191281278, 0.0438197644, 0.144244332, 0.00352008903, -0.0655640166, 0.182949362, 0.16444154, 0.276046577,
+    0.146798928, -0.196596242, -0.254466227, -0.175803562, -0.0878837065, 0.182710332, 0.0915330795, -0.0417334157,
+    -0.13707891, 0.103219449, -0.0543879743, -0.177081403, 0.115681987, 0.303216035, -0.155729828, -0.0248800515,
+    -0.199168198, 0.0793015097, -0.0617711917, 0.17665817, -0.249018529, -0.209930723, -0.0522539544, -0.0279302434,
+    0.0773500113, -0.140804898, 0.0320380104, 0.0513444637, 0.142628209, 0.0556824274, -0.073254782, 0.292104558,
+    0.117297244, 0.265823664, 0.028174271, -0.09135205, 0.00900538501, 0.0508088104, -0.271964312, -0.269437801,
+    0.0874095215, 0.168808858, 0.225257836, -0.0897476589, -0.262716103, -0.0444776988, 0.157382257, -0.24677311,
+    -0.219620262, -0.0564547504, -0.0647895494, 0.238958261, -0.198567345, -0.0560393703, 0.0352406823, 0.0276497519,
+    0.122491237, -0.276219628, 0.129580282, 0.21442083, 0.0655693465, -0.104593986, -0.190449654, -0.0888482474,
+    -0.00264852166, 0.246306407, -0.051542754, -0.177660357, 0.232826401, -0.16004666, 0.095506429, 0.167276776,
+    -0.155244299, -0.134815264, 0.278900894, 0.133438874, -0.0117637648, -0.0673292431, -0.221861682, 0.291303806,
+    0.19619513, -0.00624073414, 0.149352655, 0.152883162, 0.101159171, 0.142779216, 0.199218147, 0.0353827959,
+    0.200431047, -0.184689222, -0.18792486, -0.00561821833, -0.0172353682, -0.127383822, -0.0338885584, 0.211129552,
+    0.280981725, -0.287879552, 0.253859701, 0.107596121, 0.217667151, -0.0660685384, -0.248731536, -0.225837489,
+    -0.301905883, 0.234458713, 0.00985161336, 0.302974839, -0.055845288, 0.219169692, -0.233037761, -0.244903614,
+    0.0910960319, -0.0281943379, -0.0367771791, 0.0486921604, -0.022544862, 0.251257409, 0.171779196, -0.0296775948,
+    0.0152003383, -0.300681016, -0.172091679, -0.0257334748, -0.238992069, -0.294798359, 0.0660736439, -0.111530396,
+    0.288680166, 0.132406628, -0.145226593, 0.116293663, -0.129867403, 0.0119735411, -0.0983884258, -0.194212069,
+    0.0719813984, 0.155488938, -0.131414046, -0.0413912648, -0.160560808, -0.252497637, -0.178492171, 0.0978959242,
+    -0.205712846, 0.230425932, -0.235297298, -0.286440176, 0.0547419677, -0.20689411, 0.126568612, -0.180332062,
+    -0.10292313, 0.216733222, 0.0599870492, -0.25657083, -0.222804023, -0.0312792785, -0.156248567, -0.140876107,
+    0.0339937534, -0.0792915349, -0.0348037356, -0.153060359, -0.163826195, -0.131119883, -0.207825119, -0.289936746,
+    0.105128759, -0.0135609098, -0.10906474, -0.0790103146, -0.262244454, -0.102740856, -0.0674541893, 0.131262397,
+    0.297011624, -0.00377634718, 0.129324138, -0.255813188, 0.091009685, -0.158574902, -0.0915260975, 0.135908877,
+    -0.0201651897, 0.232190712, -0.0631891678, 0.228850689, -0.0293885431, -0.076175628, -0.0384737311, 0.151445107,
+    0.0747984636, -0.241561994, -0.15834607, -0.0761789131, -0.0992823303, -0.0986722402, 0.160162378, 0.00429949424,
+    0.0679088544, 0.0659331773, -0.0713618484, 0.0570373057, 0.170388314, 0.00551534307, 0.119954958, 0.0727733712,
+    -0.236695552, -0.234187601, -0.129627986, 0.207195603, -0.246992811, 0.095953929, -0.301090469, 0.251019339,
+    -0.205018749, -0.232585543, -0.0870772256, 0.00775925704, 0.0266720206, 0.221748945, 0.281355302, -0.0229824022,
+    -0.0890309475, -0.0468424284, 0.283422145, -0.0866721326, 0.121628797, -0.0105605589, -0.0256204121, -0.0409841988,
+    -0.295894591, -0.113245747, 0.209612589, -0.0723399083, 0.235004609, 0.0266489158, -0.076576547, 0.0455536054,
+    -0.285024056, -0.0776291759, -0.261300475, -0.175173618, -0.119802529, -0.013547743, 0.0221942412, -0.133509843,
+    -0.260026512, 0.266523538, -0.0547375914, -0.0340567423, 0.0111259683, -0.230217365, 0.0772832442, -0.253868096,
+    0.0355515311, -0.0540700729, 0.0966377496, 0.100925798, 0.0935232582, 0.292012577, 0.162960313, 0.022288371,
+    -0.202486598, 0.113611812, 0.0240892995, -0.258738034, -0.274106854, -0.0642187701, 0.00112690107, 0.175006929,
+    -0.136167437, 0.130482477, -0.0891890431, 0.0763840928, -0.0376220926, 0.23692611, -0.142007255, 0.00949324649,
+    0.181008748, 0.225948183, -0.296873974, 0.143839643, 0.188944102, 0.267693111, -0.0757069355, -0.165154648,
+    -0.21505678, 0.0518163805, -0.121059971, -0.270519495, -0.135465462, 0.114259393, -0.00368851083, 0.217483789,
+    -0.0782963286, 0.164648984, 0.130428479, 0.278918373, -0.0342617289, -0.155890459, 0.270750121, -0.103114416,
+    0.258471004, 0.0443540878, 0.274369361, -0.165881059, 0.229819521, -0.169120868, -0.227951168, 0.0601115832,
+    0.226939442, 0.0475344599, 0.108972834, 0.266322391, -0.0717537849, 0.0967095024, -0.217129226, 0.158687452,
+    0.114658461, -0.0854634663, 0.0915841939, -0.28482781, 0.0989816358, 0.223105547, 0.290884471, 0.000915874747,
+    -0.279625435, 0.294346698, 0.146335997, 0.238750361, -0.0827978692, -0.184976195, -0.1516577, -0.115479137,
+    0.0421210372, 0.106608611, 0.0262544375, 0.186949535, 0.113243982, 0.0362209431, 0.269897593, -0.0593311753,
+    -0.124504156, -0.140092577, -0.199255804, -0.0521589563, -0.104487617, 0.225677556, -0.202684805, 0.175664978,
+    0.196115782, 0.182907296, 0.161146991, 0.273278173, -0.253622803, -0.0813407166, -0.218798745, -0.120171522,
+    -0.0375704482, 0.294918241, -0.0316533293, -0.196553557, 0.0506982991, 0.131094672, -0.290460924, -0.0772148659,
+    -0.0474824152, -0.131285145, -0.213434714, 0.23776729, -0.194821902, 0.287388797, 0.042120837, 0.179457228,
+    -0.021864616, 0.146881492, -0.210315993, -0.0595000993, 0.198489768, 0.0543120892, -0.2669939, 0.261449601,
+    0.0649961343, -0.276396166, -0.0289710615, -0.248245764, 0.266453675, -0.0153344699, -0.266263811, -0.111560784,
+    -0.146176615, -0.288039746, 0.297128406, 0.192061604, 0.0940529186, 0.197707672, 0.268417601, -0.160739403,
+    -0.0157934397, -0.150332936, 0.157166313, 0.11176157, -0.231983776, 0.0982975591, -0.11890341, -0.171922599,
+    -0.054403049, -0.15561523, -0.0758056697, 0.203166556, -0.149562309, -0.124546525, 0.247716813, -0.169184641,
+    0.100634564, -0.105710192, -0.267519219, 0.239632695, -0.111111931, -0.297044312, 0.299571853, -0.156808663,
+    -0.0177161744, 0.141284086, -0.276347697, 0.200775084, 0.0252429626, -0.105261372, 0.166936717, 0.249629467,
+    -0.276464697, 0.208974706, -0.0864263346, -0.0169980444, -0.154671577, -0.20147263, -0.0776606536, -0.0183185898,
+    0.27603895, 0.143868381, -0.218892096, 0.0459299721, 0.282454942, -0.0441530344, -0.2677002, 0.160993397,
+    0.0834492604, -0.165994485, 0.0509242964, 0.118651089, 0.0395317151, -0.196262961, 0.125639839, -0.258739173,
+    -0.0444203812, -0.0431815088, -0.00655594658, 0.0493021045, 0.226789786, -0.0953428326, 0.192818748, -0.191402244,
+    -0.144176933, 0.151021523, 0.0800172428, 0.0866923148, -0.0349932607, -0.0881635908, -0.09580934, 0.0320579531,
+    -0.209602015, -0.121233327, -0.0131783855, -0.173793885, 0.110797883, 0.0175270186, 0.0524043368, 0.170487438,
+    0.121678593, 0.13541103, -0.110149745, -0.297639791, -0.273487677, -0.196319233, -0.253132486, -0.257790883,
+    -0.0993746541, 0.0286199637, 0.154243664, 0.117141346, 0.262860445, 0.254237678, -0.0788632634, -0.196621,
+    -0.190780376, -0.15361038, 0.0457174605, -0.0442041607, -0.0560512213, -0.0575872105, 0.0339563097, -0.0544653054,
+    0.19640983, -0.184249253, 0.209010754, -0.037453813, 0.0266835471, -0.272902101, -0.165283103, 0.181892123,
+    -0.178433716, -0.254692287, -0.151577263, 0.234328474, -0.302456816, 0.0171862104, -0.217640409, -0.0545522011,
+    -0.0137106173, -0.090166372, 0.190327373, -0.0547390601, 0.0490998506, -0.0217934146, 0.24543109, 0.208143621,
+    0.2365296, -0.121598098, 0.0376656611, 0.215161613, -0.275085683, -0.0408130072, -0.29554698, -0.0398070873,
+    0.0690355107, -0.0217213855
+};
+template<typename T> const T DnnLayer<T, 5>::b[35] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0
+};
+template<typename T> struct DnnLayer<T, 6> { static const T w[35*1]; static const T b[1]; };
+template<typename T> const T DnnLayer<T, 6>::w[35*1] = {
+    -0.194316727, -0.164395461, 0.280738198, -0.241986556, -0.145700991, -0.323232633, 0.0615889251, 0.104256936,
+    0.15290521, -0.0406924432, -0.11173078, -0.100264049, -0.311023628, -0.262907316, -0.199610976, 0.1504949,
+    -0.329154033, 0.373796037, -0.0812321689, -0.0460906116, -0.29044826, 0.370650558, 0.155270634, -0.0698878729,
+    0.362548226, -0.0268563242, 0.331767688, 0.267325546, -0.257303435, -0.156611576, 0.342169658, -0.235665733,
+    -0.133151048, -0.185736782, -0.0941131815
+};
+template<typename T> const T DnnLayer<T, 6>::b[1] = {
+    0
+};
+
+#endif
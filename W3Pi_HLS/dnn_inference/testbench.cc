@@ -0,0 +1,79 @@
+#include "src/dnn_inference.h"
+#include "dnn_features.h"
+#include "../event_processor/ref_workspace.h"
+#include "../utils/dump_reader.h"
+#include "../utils/stage_stats.h"
+#include <cassert>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+// Largest difference allowed between the fixed-point and the float scores
+#define DNN_TOLERANCE 0.02
+
+int main(int argc, char **argv) {
+
+    // Map and index input file
+    DumpReader in("Puppi_w3p_PU200.dump");
+    if (!in.good()) { printf("Cannot open Puppi_w3p_PU200.dump (run from the data directory)\n"); return 1; }
+
+    RefWorkspace ws;
+    unsigned int nevents = 0, ntriplets = 0, nfailed = 0;
+    float maxdiff = 0;
+
+    // Loop on input events
+    for (int itest = 0, ntest = 20; itest < ntest && itest < int(in.size()); ++itest)
+    {
+        DumpEvent event = in.event(itest);
+        unsigned int npuppi = event.npuppi();
+        assert(npuppi <= NPUPPI_MAX);
+        if (npuppi < 3) continue;
+
+        // Triplets of the reference
+        Puppi * puppi = ws.load(event.data, npuppi);
+        Puppi pivot;
+        Triplet triplets[NTRIPLETS_MAX];
+        bool masked_triplets[NTRIPLETS_MAX];
+        event_processor_ref(npuppi, puppi, pivot, triplets, masked_triplets, ws);
+
+        // Features of the triplets passing the selections
+        float features[NTRIPLETS_MAX][DNN_NFEATURES] = {};
+        dnn_input_t features_hw[NTRIPLETS_MAX][DNN_NFEATURES];
+        for (int i = 0; i < NTRIPLETS_MAX; i++)
+        {
+            if (!masked_triplets[i]) dnn_features_ref(npuppi, ws.soa, triplets[i], features[i]);
+            for (int f = 0; f < DNN_NFEATURES; f++) features_hw[i][f] = features[i][f];
+        }
+
+        // FIRMWARE call
+        dnn_score_t scores_hls[NTRIPLETS_MAX];
+        dnn_inference(features_hw, masked_triplets, scores_hls);
+
+        // REFERENCE call
+        float scores_ref[NTRIPLETS_MAX];
+        dnn_inference_ref(features, masked_triplets, scores_ref);
+
+        // Compare
+        printf("Event %3d: %3u candidates\n", itest, npuppi);
+        for (int i = 0; i < NTRIPLETS_MAX; i++)
+        {
+            if (masked_triplets[i]) continue;
+            float diff = std::abs(scores_hls[i].to_float() - scores_ref[i]);
+            bool ok = diff <= DNN_TOLERANCE;
+            printf("  triplet (%3d,%3d,%3d): score %.4f, ref %.4f%s\n", triplets[i].idx0.to_int(), triplets[i].idx1.to_int(), triplets[i].idx2.to_int(),
+                   scores_hls[i].to_float(), scores_ref[i], ok ? "" : "  <-- MISMATCH");
+            maxdiff = std::max(maxdiff, diff);
+            nfailed += !ok;
+            ntriplets++;
+        }
+        nevents++;
+    }
+
+#ifdef W3P_STAGE_STATS
+    w3p_stats::print_stats();
+#endif
+
+    printf("DNN test %s: %u events, %u triplets, max |score - ref| = %.4f (tolerance %.4f)\n",
+           nfailed ? "FAILED" : "passed", nevents, ntriplets, maxdiff, DNN_TOLERANCE);
+    return nfailed ? 1 : 0;
+}
@@ -0,0 +1,210 @@
+// Microbenchmarks of event_processor, its C++ references and the RootDF_utils.h helpers
+//
+// Usage:
+//   event_processor_benchmark [-n repeat] [-s nsynthetic] [-o results.jsonl] [file1.dump ...]
+//
+//  - inputs: the events of the dump files (default: the bundled W3Pi dumps, run from the data
+//    directory) and nsynthetic synthetic events of NPUPPI_MAX candidates (default 200)
+//  - each benchmark runs repeat times (default 5) over the events of each input, and prints
+//    ns/event, events/s and the percentiles of the time per event (see utils/benchmark.h)
+//  - with -o, the same results are written as JSON Lines, to compare them across commits
+// The RootDF_utils.h helpers (add_isolation, add_all_triplet_idxs_from_pivot) run on the
+// float pt/eta/phi of the same candidates. ROOT::VecOps::RVec and ROOT::Math::PtEtaPhiMVector
+// are used when the ROOT headers are found (compile with `root-config --cflags --libs`),
+// otherwise minimal stand-ins.
+#include "src/event_processor.h"
+#include "isolation_simd.h"
+#include "../utils/dump_reader.h"
+#include "../utils/puppi_soa.h"
+#include "../utils/benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#if defined(__has_include)
+#if __has_include("ROOT/RVec.hxx") && __has_include("Math/Vector4D.h") && __has_include("TRandom3.h")
+#include "ROOT/RVec.hxx"
+#include "Math/Vector4D.h"
+#include "TRandom3.h"
+#define BENCHMARK_ROOT 1
+#endif
+#endif
+
+#ifndef BENCHMARK_ROOT
+// Minimal stand-ins for the ROOT types used by RootDF_utils.h
+typedef float Float_t;
+typedef int Int_t;
+namespace ROOT {
+    namespace VecOps { template<typename T> using RVec = std::vector<T>; }
+    namespace Math {
+        struct PtEtaPhiMVector {
+            double px, py, pz, e;
+            PtEtaPhiMVector(double pt, double eta, double phi, double m) :
+                px(pt*std::cos(phi)), py(pt*std::sin(phi)), pz(pt*std::sinh(eta)),
+                e(std::sqrt(pt*pt*std::cosh(eta)*std::cosh(eta) + m*m)) {}
+            PtEtaPhiMVector operator+(const PtEtaPhiMVector & o) const { PtEtaPhiMVector r = *this; r.px += o.px; r.py += o.py; r.pz += o.pz; r.e += o.e; return r; }
+            double M() const { double m2 = e*e - px*px - py*py - pz*pz; return m2 > 0 ? std::sqrt(m2) : 0; }
+            double Pt() const { return std::hypot(px, py); }
+        };
+    }
+}
+struct TRandom3 {
+    std::mt19937 rng;
+    explicit TRandom3(unsigned int seed) : rng(seed) {}
+    double Uniform(double a, double b) { return std::uniform_real_distribution<double>(a, b)(rng); }
+    unsigned int Integer(unsigned int n) { return std::uniform_int_distribution<unsigned int>(0, n-1)(rng); }
+};
+#endif
+
+#include "../../W3PiDNN/utils/RootDF_utils.h"
+
+// See replay_ref.cc: event_processor_ref may read up to input[-1] and input[255]
+#define NPUPPI_BUFFER (1 + 256)
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [-n repeat] [-s nsynthetic] [-o results.jsonl] [file1.dump ...]\n", name);
+}
+
+// One event in all the input formats
+struct BenchEvent {
+    unsigned int npuppi = 0;
+    Puppi buffer[NPUPPI_BUFFER];
+    Puppi sorted[NPUPPI_MAX];
+    PuppiEventSoA<NPUPPI_MAX> soa;
+    // RootDF_utils.h inputs
+    ROOT::VecOps::RVec<Float_t> pt, eta, phi, mass, iso;
+    ROOT::VecOps::RVec<Int_t> pdgId, charge;
+    std::vector<int> candidate_idxs;
+
+    Puppi * puppi() { return buffer + 1; }
+
+    void fill(const uint64_t * words, unsigned int n)
+    {
+        static const int PDG_ID[8] = {130, 22, -211, 211, 11, -11, 13, -13};
+        npuppi = n;
+        for (Puppi & p : buffer) p.clear();
+        soa.unpack(words, npuppi);
+        soa.to_puppi(puppi(), NPUPPI_MAX);
+        std::copy(puppi(), puppi() + NPUPPI_MAX, sorted);
+        std::stable_sort(sorted, sorted + npuppi, [](const Puppi & a, const Puppi & b) { return a.hwPt > b.hwPt; });
+        for (unsigned int i = 0; i < npuppi; ++i)
+        {
+            const Puppi & p = puppi()[i];
+            pt.push_back(p.floatPt());
+            eta.push_back(p.floatEta());
+            phi.push_back(p.floatPhi());
+            pdgId.push_back(PDG_ID[p.hwID.to_uint()]);
+            charge.push_back(p.charge());
+            mass.push_back(std::abs(PDG_ID[p.hwID.to_uint()]) == 211 ? 0.13957 : 0.);
+            candidate_idxs.push_back(i);
+        }
+        std::vector<float> absiso = add_isolation(pt, eta, phi);
+        iso.assign(absiso.begin(), absiso.end());
+    }
+};
+
+// All the benchmarks on one input
+static void run_input(w3p_bench::BenchSuite & suite, const std::string & input, std::vector<BenchEvent> & events)
+{
+    size_t n = events.size();
+    const dr2_t dr2_max = drToHwDr2(0.4), dr2_veto = drToHwDr2(0.1);
+    bool nomask[NPUPPI_MAX] = {false};
+
+    suite.run("event_processor_ref", input, n, [&](size_t i) {
+        Puppi pivot; Triplet triplets[NTRIPLETS_MAX]; bool masked_triplets[NTRIPLETS_MAX];
+        event_processor_ref(events[i].npuppi, events[i].puppi(), pivot, triplets, masked_triplets);
+        w3p_bench::do_not_optimize(masked_triplets);
+    });
+    suite.run("event_processor (C-sim)", input, n, [&](size_t i) {
+        Puppi pivot; Triplet triplets[NTRIPLETS_MAX]; bool masked_triplets[NTRIPLETS_MAX];
+        event_processor(events[i].puppi(), pivot, triplets, masked_triplets);
+        w3p_bench::do_not_optimize(masked_triplets);
+    });
+    suite.run("event_processor_sorted (C-sim)", input, n, [&](size_t i) {
+        Puppi pivot; Triplet triplets[NTRIPLETS_MAX]; bool masked_triplets[NTRIPLETS_MAX];
+        event_processor_sorted(events[i].sorted, pivot, triplets, masked_triplets);
+        w3p_bench::do_not_optimize(masked_triplets);
+    });
+    suite.run("compute_isolation_ref", input, n, [&](size_t i) {
+        Puppi::pt_t absiso[NPUPPI_MAX];
+        compute_isolation_ref(events[i].npuppi, events[i].puppi(), nomask, absiso, dr2_max, dr2_veto);
+        w3p_bench::do_not_optimize(absiso);
+    });
+    suite.run("compute_isolation_grid", input, n, [&](size_t i) {
+        Puppi::pt_t absiso[NPUPPI_MAX];
+        compute_isolation_grid(events[i].npuppi, events[i].puppi(), nomask, absiso, dr2_max, dr2_veto);
+        w3p_bench::do_not_optimize(absiso);
+    });
+    suite.run(std::string("compute_isolation_simd (") + iso_kernel_name(iso_kernel_best()) + ")", input, n, [&](size_t i) {
+        Puppi::pt_t absiso[NPUPPI_MAX];
+        compute_isolation_simd(events[i].soa, nomask, absiso, dr2_max, dr2_veto);
+        w3p_bench::do_not_optimize(absiso);
+    });
+    suite.run("RootDF add_isolation", input, n, [&](size_t i) {
+        std::vector<float> iso = add_isolation(events[i].pt, events[i].eta, events[i].phi);
+        w3p_bench::do_not_optimize(iso.data());
+    });
+    suite.run("RootDF add_all_triplet_idxs_from_pivot", input, n, [&](size_t i) {
+        const BenchEvent & e = events[i];
+        std::vector<triplet_idx> triplets = add_all_triplet_idxs_from_pivot(e.candidate_idxs, e.pdgId, e.charge, e.pt, e.eta, e.phi, e.mass, e.iso);
+        w3p_bench::do_not_optimize(triplets.data());
+    });
+}
+
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    unsigned int repeat = 5, nsynthetic = 200;
+    std::string outname;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-n") && i+1 < argc) repeat = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i+1 < argc) nsynthetic = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i+1 < argc) outname = argv[++i];
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU0.dump", "Puppi_w3p_PU200.dump"};
+
+    w3p_bench::BenchSuite suite("event_processor", repeat, outname);
+
+    // Dump files, the input is named after the file
+    for (const std::string & name : innames)
+    {
+        DumpReader in(name);
+        std::vector<BenchEvent> events;
+        events.reserve(in.size());
+        for (size_t ievt = 0; ievt < in.size(); ++ievt)
+        {
+            DumpEvent event = in.event(ievt);
+            if (event.npuppi() == 0 || event.npuppi() > NPUPPI_MAX) continue;
+            events.emplace_back();
+            events.back().fill(event.data, event.npuppi());
+        }
+        std::string input = name.substr(name.find_last_of('/') + 1);
+        input = input.substr(0, input.find(".dump"));
+        if (input.compare(0, 10, "Puppi_w3p_") == 0) input = input.substr(10);
+        run_input(suite, input, events);
+    }
+
+    // Synthetic events: full events of NPUPPI_MAX candidates
+    std::mt19937 rng(12345);
+    std::vector<BenchEvent> events(nsynthetic);
+    std::vector<uint64_t> words;
+    for (BenchEvent & e : events)
+    {
+        w3p_bench::synthetic_event(rng, NPUPPI_MAX, words);
+        e.fill(words.data(), NPUPPI_MAX);
+    }
+    run_input(suite, "synthetic", events);
+
+    return 0;
+}
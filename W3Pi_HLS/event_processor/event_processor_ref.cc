@@ -1,4 +1,8 @@
 #include "src/event_processor.h"
+#include "isolation_grid.h"
+#include "ref_workspace.h"
+#include "../utils/triplet_mass.h"
+#include "../utils/stage_stats.h"
 
 // Compute dR between two puppi objects
 inline dr2_t deltaR2(const Puppi & p1, const Puppi & p2) {
@@ -9,6 +13,53 @@ inline dr2_t deltaR2(const Puppi & p1, const Puppi & p2) {
     return dphi*dphi + deta*deta;
 }
 
+// Invariant mass of three massless candidates in floating point (reference for triplet_mass2)
+float triplet_mass_ref(const Puppi & p0, const Puppi & p1, const Puppi & p2)
+{
+    const Puppi * p[3] = {&p0, &p1, &p2};
+    double m2 = 0;
+    for (int i = 0; i < 3; ++i)
+        for (int j = i+1; j < 3; ++j)
+        {
+            double dphi = p[i]->floatPhi() - p[j]->floatPhi();
+            double deta = p[i]->floatEta() - p[j]->floatEta();
+            m2 += 2 * p[i]->floatPt() * p[j]->floatPt() * (std::cosh(deta) - std::cos(dphi));
+        }
+    return std::sqrt(m2);
+}
+
+// Compute isolation for all (filtered) candidates looping on all pairs
+void compute_isolation_ref(unsigned int npuppi, const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NPUPPI_MAX], dr2_t dr2_max, dr2_t dr2_veto)
+{
+    for (unsigned int j = 0; j < npuppi; ++j)
+    {
+        // Define each filtered candidate as seed to compute isolation
+        Puppi seed = input[j];
+
+        // Define list of pts to sum (particle inside isolation cone)
+        Puppi::pt_t myiso = 0;
+
+        // Loop on all particles to compute iso_sum
+        for (unsigned int i = 0; i < npuppi; ++i) {
+            // Get dR2
+            dr2_t dr2 = deltaR2(seed, input[i]);
+            // If inside and not in veto cone, get pt for iso computation
+            myiso += (dr2 < dr2_max) && (dr2 > dr2_veto) ? input[i].hwPt : Puppi::pt_t(0);
+        }
+
+        // Store isolation value
+        output_absiso[j] = masked[j] ? Puppi::pt_t(0) : myiso;
+    }
+}
+
+// Compute isolation for all (filtered) candidates on the eta/phi grid (same output as compute_isolation_ref)
+void compute_isolation_grid(unsigned int npuppi, const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NPUPPI_MAX], dr2_t dr2_max, dr2_t dr2_veto)
+{
+    IsolationGrid grid;
+    grid.fill(npuppi, input, dr2_max);
+    grid.compute(masked, output_absiso, dr2_max, dr2_veto);
+}
+
 // Find highest pT puppi object
 Puppi find_pivot_ref(unsigned int npuppi, const Puppi puppi[NPUPPI_MAX], const bool masked[NPUPPI_MAX]) {
     Puppi pivot;
@@ -30,15 +81,24 @@ int find_pivot_idx_ref(unsigned int npuppi, const Puppi puppi[NPUPPI_MAX], const
     return iseed;
 }
 
-// Top function:
+// Candidate selection:
 //  - filter candidates
 //  - add isolation to filtered candidates
 //  - update mask to consider only (iso_sum/pt) <= 0.6
-//  - find pivot among them
-void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX])
+//  - find pivot among them, and return its index
+int select_candidates_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], bool masked[NPUPPI_MAX])
 {
-    // Define masked lists to filter candidates
-    bool masked[NPUPPI_MAX];
+    IsolationGrid grid;
+    Puppi::pt_t output_absiso[NPUPPI_MAX];
+    return select_candidates_ref(npuppi, input, masked, grid, output_absiso);
+}
+
+// Same, with the candidates also given as raw integers in soa (nullptr: read from input)
+static int select_candidates_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], const PuppiEventSoA<NPUPPI_MAX> * soa, bool masked[NPUPPI_MAX],
+                                  IsolationGrid & grid, Puppi::pt_t output_absiso[NPUPPI_MAX])
+{
+    W3P_STATS_CLOCK(clock);
+    W3P_STATS_COUNT("ref.npuppi", npuppi);
 
     // Filter candidates: loop and apply selections
     for (unsigned int i = 0; i < npuppi; i++)
@@ -48,48 +108,50 @@ void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Pu
                       (input[i].hwEta < -Puppi::ETA_CUT || input[i].hwEta > Puppi::ETA_CUT)
                     );
     }
+    W3P_STATS_LAP(clock, "ref.filter");
+    W3P_STATS_COUNT("ref.filtered", std::count(masked, masked + npuppi, false));
 
-    // Define and clean isolation array
-    Puppi::pt_t output_absiso[npuppi];
+    // Clean isolation array
     for (unsigned int j = 0; j < npuppi; ++j) output_absiso[j] = 0;
 
     // Define min/max isolation cones
     const dr2_t dr2_max = drToHwDr2(0.4), dr2_veto = drToHwDr2(0.1);
 
-    // Compute isolation for all (filtered) candidates
-    for (unsigned int j = 0; j < npuppi; ++j)
-    {
-        // Define each filtered candidate as seed to compute isolation
-        Puppi seed = input[j];
-
-        // Define list of pts to sum (particle inside isolation cone)
-        Puppi::pt_t myiso = 0;
-
-        // Loop on all particles to compute iso_sum
-        for (unsigned int i = 0; i < npuppi; ++i) {
-            // Get dR2
-            dr2_t dr2 = deltaR2(seed, input[i]);
-            // If inside and not in veto cone, get pt for iso computation
-            myiso += (dr2 < dr2_max) && (dr2 > dr2_veto) ? input[i].hwPt : Puppi::pt_t(0);
-        }
-
-        // Store isolation value
-        output_absiso[j] = masked[j] ? Puppi::pt_t(0) : myiso;
-    }
+    // Compute isolation for all (filtered) candidates, visiting only the neighbouring eta/phi cells
+    if (soa) grid.fill(*soa, dr2_max);
+    else grid.fill(npuppi, input, dr2_max);
+    grid.compute(masked, output_absiso, dr2_max, dr2_veto);
 
     // Update mask to consider only (iso_sum/pt) <= 0.6
     for (unsigned int i = 0; i < npuppi; i++)
     {
         masked[i] = masked[i] ? masked[i] : (output_absiso[i]/input[i].hwPt) > 0.6;
     }
+    W3P_STATS_LAP(clock, "ref.isolation");
+    W3P_STATS_COUNT("ref.isolated", std::count(masked, masked + npuppi, false));
 
     // Find pivot (charged filtered candidate with highest pt)
     int pivot_idx = find_pivot_idx_ref(npuppi, input, masked);
-    pivot = input[pivot_idx];
+    W3P_STATS_LAP(clock, "ref.pivot");
+    return pivot_idx;
+}
 
-    // Debug printout
-    //std::cout << "---> Ref Pivot idx: " << pivot_idx << std::endl;
-    //std::cout << "     Ref Pivot pT : " << pivot.hwPt << " eta: " << pivot.hwEta*Puppi::ETAPHI_LSB << " pdgID: " << pivot.hwID << std::endl;
+int select_candidates_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], bool masked[NPUPPI_MAX], IsolationGrid & grid, Puppi::pt_t output_absiso[NPUPPI_MAX])
+{
+    return select_candidates_ref(npuppi, input, nullptr, masked, grid, output_absiso);
+}
+
+// Top function:
+//  - select candidates and find the pivot
+//  - build the triplets starting from the pivot
+//  - filter the triplets
+static void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], const PuppiEventSoA<NPUPPI_MAX> * soa, Puppi & pivot, Triplet triplets[NTRIPLETS_MAX],
+                                 bool masked_triplets[NTRIPLETS_MAX], bool masked[NPUPPI_MAX], IsolationGrid & grid, Puppi::pt_t absiso[NPUPPI_MAX])
+{
+    // Filter candidates and find pivot
+    int pivot_idx = select_candidates_ref(npuppi, input, soa, masked, grid, absiso);
+    pivot = input[pivot_idx];
+    W3P_STATS_CLOCK(clock);
 
     // Build all triplets (pT ordered) starting from pivot
     int ntriplets = 0;
@@ -111,11 +173,12 @@ void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Pu
                 ntriplets++;
             }
         }
+    W3P_STATS_LAP(clock, "ref.build_triplets");
+    W3P_STATS_COUNT("ref.triplets_built", ntriplets);
 
-    // Debug printout
-    //std::cout << "---> Ref Triplets:" << std::endl;
-    //for (unsigned int i = 0; i < ntriplets; i++)
-    //    std::cout << "     - triplet: " << triplets[i].idx0 << "-" << triplets[i].idx1 << "-" << triplets[i].idx2 << std::endl;
+    // Pairs of the candidates left after the pivot: more than NTRIPLETS_MAX are truncated
+    W3P_STATS_ONLY(unsigned int nleft = std::count(masked, masked + npuppi, false) - (pivot_idx >= 0));
+    W3P_STATS_COUNT("ref.triplets_truncated", nleft*(nleft-1)/2 > NTRIPLETS_MAX);
 
     // Filter triplets
     for (unsigned int i = 0; i < NTRIPLETS_MAX; i++)
@@ -127,13 +190,27 @@ void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Pu
 
         // Add selections on sum-charge, pt triplet, mass triplet
         masked_triplets[i] = ( std::abs(input[idx0].charge()+input[idx1].charge()+input[idx2].charge()) != 1 ||
-                              (input[idx0].hwPt < 15) || (input[idx1].hwPt < 4) || (input[idx2].hwPt < 3)
+                              (input[idx0].hwPt < 15) || (input[idx1].hwPt < 4) || (input[idx2].hwPt < 3) ||
+                              !triplet_mass_window(input[idx0], input[idx1], input[idx2])
                             );
     }
+    W3P_STATS_LAP(clock, "ref.filter_triplets");
+    W3P_STATS_COUNT("ref.triplets_passing", std::count(masked_triplets, masked_triplets + NTRIPLETS_MAX, false));
+}
+
+void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX])
+{
+    // Define masked lists to filter candidates, isolation grid and array
+    bool masked[NPUPPI_MAX];
+    IsolationGrid grid;
+    Puppi::pt_t absiso[NPUPPI_MAX];
+    event_processor_ref(npuppi, input, nullptr, pivot, triplets, masked_triplets, masked, grid, absiso);
+}
 
-    // Debug printout
-    //std::cout << "     Ref Cleaned Triplets:" << std::endl;
-    //for (unsigned int i = 0; i < NTRIPLETS_MAX; i++)
-    //    if (!masked_triplets[i])
-    //        std::cout << "     - triplet: " << triplets[i].idx0 << "-" << triplets[i].idx1 << "-" << triplets[i].idx2 << std::endl;
+// Same on the buffers of the workspace (see ref_workspace.h)
+void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX], RefWorkspace & ws)
+{
+    // Candidates of ws.load(): the isolation grid reads the raw integers of ws.soa
+    const PuppiEventSoA<NPUPPI_MAX> * soa = (input == ws.puppi() && ws.soa.n == npuppi) ? &ws.soa : nullptr;
+    event_processor_ref(npuppi, input, soa, pivot, triplets, masked_triplets, ws.masked, ws.grid, ws.absiso);
 }
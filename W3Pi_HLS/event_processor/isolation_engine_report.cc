@@ -0,0 +1,112 @@
+// Latency/resources report of the time-multiplexed isolation engine (src/isolation_engine.h)
+//
+// Usage:
+//   isolation_engine_report [-c clock_ns] [-b budget_ns] [-n nevents] [file1.dump ...]
+//
+//  - for each LANES setting, the cycle-count model gives the iterations, the latency and the
+//    number of dR2 units / multipliers / adders, and the smallest LANES with a latency within
+//    the budget is reported (default: 150 ns, one event every 6 bunch crossings)
+//  - the engine is run in C++ for a few LANES settings on the first nevents of the dump files
+//    (default: the bundled PU200 dump, run from the data directory) and compared with
+//    compute_isolation_ref
+#include "src/event_processor.h"
+#include "src/isolation_engine.h"
+#include "../utils/dump_reader.h"
+#include "../utils/puppi_soa.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [-c clock_ns] [-b budget_ns] [-n nevents] [file1.dump ...]\n", name);
+}
+
+// Run the engine with LANES lanes and compare with the all-pairs reference
+template<int LANES>
+bool check_engine(unsigned int npuppi, const Puppi puppi[NPUPPI_MAX], const bool masked[NPUPPI_MAX], const Puppi::pt_t absiso_ref[NPUPPI_MAX], dr2_t dr2_max, dr2_t dr2_veto)
+{
+    Puppi::pt_t absiso[NPUPPI_MAX];
+    isolation_engine<LANES>(puppi, masked, absiso, dr2_max, dr2_veto);
+    bool ok = std::equal(absiso_ref, absiso_ref + npuppi, absiso);
+    if (!ok) printf("Isolation mismatch with LANES = %d\n", LANES);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    float clock_ns = 2.777, budget_ns = 150;
+    unsigned int nevents = 10;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-c") && i+1 < argc) clock_ns = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-b") && i+1 < argc) budget_ns = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i+1 < argc) nevents = atoi(argv[++i]);
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU200.dump"};
+
+    // Cycle-count model
+    printf("Isolation engine: %d seeds x %d candidates, clock %.3f ns, latency budget %.1f ns (%d cycles)\n",
+           NPUPPI_MAX, NPUPPI_MAX, clock_ns, budget_ns, int(budget_ns / clock_ns));
+    printf("%6s %6s %6s %8s %10s %9s %10s %9s\n", "LANES", "iter", "depth", "latency", "latency_ns", "dR2", "mult", "adders");
+    int best = -1;
+    for (int lanes : {1, 2, 3, 4, 6, 8, 9, 12, 18, 24, 27, 36, 54, 72, 108, 216})
+    {
+        IsolationEngineCost c = isolation_engine_cost(lanes);
+        bool fits = c.latency_ns(clock_ns) <= budget_ns;
+        if (fits && best < 0) best = lanes;
+        printf("%6d %6d %6d %8d %10.1f %9d %10d %9d %s%s\n", c.lanes, c.iterations, c.depth, c.latency, c.latency_ns(clock_ns),
+               c.dr2_units, c.multipliers, c.adders, fits ? "ok" : "", lanes == ISO_LANES ? " <- ISO_LANES" : "");
+    }
+    if (best > 0)
+        printf("Smallest LANES within the budget: %d\n", best);
+    else
+        printf("No LANES setting within the budget\n");
+    IsolationEngineCost lead = IsolationEngineModel<ISO_LANES, NLEAD>::cost;
+    printf("event_processor_sorted (%d leading seeds, ISO_LANES = %d): %d iterations, latency %d cycles (%.1f ns), %d dR2 units\n",
+           NLEAD, ISO_LANES, lead.iterations, lead.latency, lead.latency_ns(clock_ns), lead.dr2_units);
+
+    // Functional check of the engine against the reference
+    const dr2_t dr2_max = drToHwDr2(0.4), dr2_veto = drToHwDr2(0.1);
+    unsigned int ntested = 0;
+    bool ok = true;
+    for (const std::string & name : innames)
+    {
+        DumpReader in(name);
+        for (size_t ievt = 0; ievt < in.size() && ievt < nevents; ++ievt)
+        {
+            DumpEvent event = in.event(ievt);
+            unsigned int npuppi = event.npuppi();
+            if (npuppi == 0 || npuppi > NPUPPI_MAX) continue;
+
+            Puppi puppi[NPUPPI_MAX];
+            PuppiEventSoA<NPUPPI_MAX> soa;
+            soa.unpack(event.data, npuppi);
+            soa.to_puppi(puppi, NPUPPI_MAX);
+
+            // Mask every other candidate to also test the masked seeds
+            bool masked[NPUPPI_MAX];
+            for (unsigned int i = 0; i < NPUPPI_MAX; ++i) masked[i] = (i % 2 == 1);
+
+            Puppi::pt_t absiso_ref[NPUPPI_MAX];
+            compute_isolation_ref(npuppi, puppi, masked, absiso_ref, dr2_max, dr2_veto);
+
+            ok = ok && check_engine<1>(npuppi, puppi, masked, absiso_ref, dr2_max, dr2_veto);
+            ok = ok && check_engine<5>(npuppi, puppi, masked, absiso_ref, dr2_max, dr2_veto);
+            ok = ok && check_engine<ISO_LANES>(npuppi, puppi, masked, absiso_ref, dr2_max, dr2_veto);
+            ok = ok && check_engine<NPUPPI_MAX>(npuppi, puppi, masked, absiso_ref, dr2_max, dr2_veto);
+            ntested++;
+        }
+    }
+    printf("Engine vs compute_isolation_ref (LANES = 1, 5, %d, %d): %u events, %s\n", ISO_LANES, NPUPPI_MAX, ntested, ok ? "identical" : "MISMATCH");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+#ifndef ISOLATION_GRID_H
+#define ISOLATION_GRID_H
+
+#include "src/event_processor.h"
+#include "../utils/stage_stats.h"
+#include "../utils/puppi_soa.h"
+#include <cstdint>
+#include <cmath>
+
+/**************************************************
+ * CPU isolation on an integer eta/phi grid
+ *
+ * Candidates are binned (counting sort) in cells at least as wide as the isolation cone,
+ * so that each seed only needs the 3x3 neighbouring cells, with phi wrap-around at
+ * Puppi::INT_PI. The output is bit-identical to the all-pairs isolation of
+ * event_processor_ref:
+ *  - dR2 is computed with the same integer arithmetic as deltaR2 (including the dphi
+ *    wrap and the truncation to dr2_t)
+ *  - candidates outside the grid acceptance (|phi| > INT_PI or |eta| > ETA_MAX, where the
+ *    dr2_t truncation could bring far pairs inside the cone) are kept in an overflow list
+ *    that is checked against every seed, and such seeds are checked against every candidate
+ *  - pT are summed as raw integers and saturated once at the end, which is the same as the
+ *    running AP_SAT sum of pt_t since all the terms are positive
+ **************************************************/
+
+class IsolationGrid {
+  public:
+    static constexpr int ETA_MAX = 1500;                       // grid acceptance in |hwEta|
+    static constexpr int MIN_CELL = 32;                        // smallest cell size (bounds the number of cells)
+    static constexpr int NETA_MAX = (2*ETA_MAX + MIN_CELL) / MIN_CELL;
+    static constexpr int NPHI_MAX = Puppi::INT_2PI / MIN_CELL;
+    static constexpr int PT_RAW_MAX = (1 << Puppi::pt_t::width) - 1;
+
+    // Exact integer equivalent of deltaR2 (see event_processor_ref.cc)
+    static inline unsigned int dr2(int eta1, int phi1, int eta2, int phi2)
+    {
+        int dphi = phi1 - phi2;
+        if (dphi > Puppi::INT_PI) dphi -= Puppi::INT_2PI;
+        else if (dphi < -Puppi::INT_PI) dphi += Puppi::INT_2PI;
+        int deta = eta1 - eta2;
+        return (unsigned int)(dphi*dphi + deta*deta) & ((1u << dr2_t::width) - 1);
+    }
+
+    // Bin the candidates of one event
+    void fill(unsigned int npuppi, const Puppi input[NPUPPI_MAX], dr2_t dr2_max)
+    {
+        npuppi_ = npuppi;
+        for (unsigned int i = 0; i < npuppi; ++i)
+        {
+            eta_[i] = input[i].hwEta.to_int();
+            phi_[i] = input[i].hwPhi.to_int();
+            pt_[i]  = input[i].hwPt(Puppi::pt_t::width-1, 0).to_uint();
+        }
+        bin(dr2_max);
+    }
+
+    void fill(const PuppiEventSoA<NPUPPI_MAX> & soa, dr2_t dr2_max)
+    {
+        npuppi_ = soa.n;
+        for (unsigned int i = 0; i < soa.n; ++i)
+        {
+            eta_[i] = soa.eta[i];
+            phi_[i] = soa.phi[i];
+            pt_[i]  = soa.pt[i];
+        }
+        bin(dr2_max);
+    }
+
+    // Compute the isolation of all the non-masked candidates (masked ones get 0)
+    void compute(const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NPUPPI_MAX], dr2_t dr2_max, dr2_t dr2_veto) const
+    {
+        const unsigned int max = dr2_max.to_uint(), veto = dr2_veto.to_uint();
+
+        for (unsigned int j = 0; j < npuppi_; ++j)
+        {
+            output_absiso[j] = 0;
+            if (masked[j]) continue;
+
+            const int seta = eta_[j], sphi = phi_[j];
+            unsigned int sum = 0;
+            W3P_STATS_ONLY(unsigned int ncone = 0);
+
+            if (cellEta_[j] < 0)
+            {
+                // Seed outside the grid: all the candidates
+                for (unsigned int i = 0; i < npuppi_; ++i)
+                {
+                    unsigned int d = dr2(seta, sphi, eta_[i], phi_[i]);
+                    sum += (d < max && d > veto) ? pt_[i] : 0;
+                    W3P_STATS_ONLY(ncone += (d < max && d > veto));
+                }
+            }
+            else
+            {
+                // Neighbouring cells
+                int ieta_lo = cellEta_[j] > 0 ? cellEta_[j] - 1 : 0;
+                int ieta_hi = cellEta_[j] < neta_ - 1 ? cellEta_[j] + 1 : neta_ - 1;
+                int nphicells = nphi_ < 3 ? 1 : 3;
+                for (int ieta = ieta_lo; ieta <= ieta_hi; ++ieta)
+                    for (int k = 0; k < nphicells; ++k)
+                    {
+                        int iphi = nphicells == 1 ? 0 : (cellPhi_[j] + k - 1 + nphi_) % nphi_;
+                        int c = ieta*nphi_ + iphi;
+                        for (int i = start_[c]; i < start_[c+1]; ++i)
+                        {
+                            unsigned int d = dr2(seta, sphi, sortedEta_[i], sortedPhi_[i]);
+                            sum += (d < max && d > veto) ? sortedPt_[i] : 0;
+                            W3P_STATS_ONLY(ncone += (d < max && d > veto));
+                        }
+                    }
+                // Candidates outside the grid
+                for (int k = 0; k < noverflow_; ++k)
+                {
+                    int i = overflow_[k];
+                    unsigned int d = dr2(seta, sphi, eta_[i], phi_[i]);
+                    sum += (d < max && d > veto) ? pt_[i] : 0;
+                    W3P_STATS_ONLY(ncone += (d < max && d > veto));
+                }
+            }
+
+            W3P_STATS_COUNT("iso_grid.cone", ncone);
+
+            // Saturate as pt_t does and store the raw bits
+            output_absiso[j](Puppi::pt_t::width-1, 0) = sum > PT_RAW_MAX ? PT_RAW_MAX : sum;
+        }
+    }
+
+  private:
+    void bin(dr2_t dr2_max)
+    {
+        // Cell size: any |d| with d*d < dr2_max is smaller than the cell
+        int cell = std::sqrt((double)dr2_max.to_uint());
+        while (cell*cell < (int)dr2_max.to_uint()) cell++;
+        cell_ = cell < MIN_CELL ? MIN_CELL : cell;
+        neta_ = (2*ETA_MAX + cell_) / cell_;
+        // Phi cells must tile the full circle with at least cell_ each, and need three distinct ones
+        nphi_ = Puppi::INT_2PI / cell_;
+        if (nphi_ < 3) nphi_ = 1;
+
+        // Count per cell
+        noverflow_ = 0;
+        for (int c = 0; c <= neta_*nphi_; ++c)
+            start_[c] = 0;
+        for (unsigned int i = 0; i < npuppi_; ++i)
+        {
+            bool inGrid = (eta_[i] >= -ETA_MAX && eta_[i] <= ETA_MAX && phi_[i] >= -Puppi::INT_PI && phi_[i] <= Puppi::INT_PI);
+            if (inGrid)
+            {
+                cellEta_[i] = etaCell(eta_[i]);
+                cellPhi_[i] = phiCell(phi_[i]);
+                start_[cellEta_[i]*nphi_ + cellPhi_[i] + 1]++;
+            }
+            else
+            {
+                cellEta_[i] = -1;
+                overflow_[noverflow_++] = i;
+            }
+        }
+
+        // Prefix sum and scatter in cell order
+        for (int c = 0; c < neta_*nphi_; ++c)
+            start_[c+1] += start_[c];
+        int fillpos[NETA_MAX*NPHI_MAX];
+        for (int c = 0; c < neta_*nphi_; ++c)
+            fillpos[c] = start_[c];
+        for (unsigned int i = 0; i < npuppi_; ++i)
+        {
+            if (cellEta_[i] < 0) continue;
+            int pos = fillpos[cellEta_[i]*nphi_ + cellPhi_[i]]++;
+            sortedEta_[pos] = eta_[i];
+            sortedPhi_[pos] = phi_[i];
+            sortedPt_[pos]  = pt_[i];
+        }
+    }
+
+    int etaCell(int eta) const { return (eta + ETA_MAX) / cell_; }
+    // -INT_PI and +INT_PI are the same point of the circle
+    int phiCell(int phi) const { return nphi_ == 1 ? 0 : ((phi + Puppi::INT_PI) % Puppi::INT_2PI) * nphi_ / Puppi::INT_2PI; }
+
+    unsigned int npuppi_ = 0;
+    int cell_ = MIN_CELL, neta_ = 1, nphi_ = 1;
+
+    // Candidates in input order
+    int eta_[NPUPPI_MAX], phi_[NPUPPI_MAX];
+    unsigned int pt_[NPUPPI_MAX];
+    int cellEta_[NPUPPI_MAX], cellPhi_[NPUPPI_MAX];
+
+    // Candidates in cell order
+    int start_[NETA_MAX*NPHI_MAX + 1];
+    int sortedEta_[NPUPPI_MAX], sortedPhi_[NPUPPI_MAX];
+    unsigned int sortedPt_[NPUPPI_MAX];
+
+    // Candidates outside the grid acceptance
+    int overflow_[NPUPPI_MAX];
+    int noverflow_ = 0;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "isolation_simd.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ISO_SIMD_X86 1
+#else
+#define ISO_SIMD_X86 0
+#endif
+
+static constexpr unsigned int DR2_MASK = (1u << dr2_t::width) - 1;
+static constexpr unsigned int PT_RAW_MAX = (1u << Puppi::pt_t::width) - 1;
+
+// The AVX-512 kernel runs on full registers of 16 candidates
+static_assert(PUPPI_SOA_PAD % 16 == 0, "PuppiEventSoA padding too small for the AVX-512 kernel");
+
+// ------------------------------------------------------------------
+// Kernels: raw isolation sum of one seed over all the candidates
+static unsigned int iso_sum_scalar(const PuppiEventSoA<NPUPPI_MAX> & soa, int seta, int sphi, unsigned int max, unsigned int veto)
+{
+    unsigned int sum = 0;
+    for (unsigned int i = 0; i < soa.n; ++i)
+    {
+        int dphi = sphi - soa.phi[i];
+        if (dphi > Puppi::INT_PI) dphi -= Puppi::INT_2PI;
+        else if (dphi < -Puppi::INT_PI) dphi += Puppi::INT_2PI;
+        int deta = seta - soa.eta[i];
+        unsigned int dr2 = (unsigned int)(dphi*dphi + deta*deta) & DR2_MASK;
+        sum += (dr2 < max && dr2 > veto) ? soa.pt[i] : 0;
+    }
+    return sum;
+}
+
+#if ISO_SIMD_X86
+// dr2 fits in 24 bits, so signed 32-bit compares are safe
+__attribute__((target("avx2")))
+static unsigned int iso_sum_avx2(const PuppiEventSoA<NPUPPI_MAX> & soa, int seta, int sphi, unsigned int max, unsigned int veto)
+{
+    const __m256i vseta  = _mm256_set1_epi32(seta);
+    const __m256i vsphi  = _mm256_set1_epi32(sphi);
+    const __m256i vpi    = _mm256_set1_epi32(Puppi::INT_PI);
+    const __m256i vmpi   = _mm256_set1_epi32(-Puppi::INT_PI);
+    const __m256i v2pi   = _mm256_set1_epi32(Puppi::INT_2PI);
+    const __m256i vmask  = _mm256_set1_epi32(DR2_MASK);
+    const __m256i vmax   = _mm256_set1_epi32(max);
+    const __m256i vveto  = _mm256_set1_epi32(veto);
+    __m256i vsum = _mm256_setzero_si256();
+
+    const unsigned int npadded = soa.npadded();
+    for (unsigned int i = 0; i < npadded; i += 8)
+    {
+        __m256i eta = _mm256_cvtepi16_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(&soa.eta[i])));
+        __m256i phi = _mm256_cvtepi16_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(&soa.phi[i])));
+        __m256i pt  = _mm256_cvtepu16_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(&soa.pt[i])));
+
+        // dphi with wrap: the two corrections are exclusive for |phi| < 2^10
+        __m256i dphi = _mm256_sub_epi32(vsphi, phi);
+        dphi = _mm256_sub_epi32(dphi, _mm256_and_si256(_mm256_cmpgt_epi32(dphi, vpi), v2pi));
+        dphi = _mm256_add_epi32(dphi, _mm256_and_si256(_mm256_cmpgt_epi32(vmpi, dphi), v2pi));
+        __m256i deta = _mm256_sub_epi32(vseta, eta);
+
+        __m256i dr2 = _mm256_add_epi32(_mm256_mullo_epi32(dphi, dphi), _mm256_mullo_epi32(deta, deta));
+        dr2 = _mm256_and_si256(dr2, vmask);
+
+        // Inside the cone and outside the veto
+        __m256i in = _mm256_and_si256(_mm256_cmpgt_epi32(vmax, dr2), _mm256_cmpgt_epi32(dr2, vveto));
+        vsum = _mm256_add_epi32(vsum, _mm256_and_si256(in, pt));
+    }
+
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1,0,3,2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2,3,0,1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+__attribute__((target("avx512f")))
+static unsigned int iso_sum_avx512(const PuppiEventSoA<NPUPPI_MAX> & soa, int seta, int sphi, unsigned int max, unsigned int veto)
+{
+    const __m512i vseta  = _mm512_set1_epi32(seta);
+    const __m512i vsphi  = _mm512_set1_epi32(sphi);
+    const __m512i vpi    = _mm512_set1_epi32(Puppi::INT_PI);
+    const __m512i vmpi   = _mm512_set1_epi32(-Puppi::INT_PI);
+    const __m512i v2pi   = _mm512_set1_epi32(Puppi::INT_2PI);
+    const __m512i vmask  = _mm512_set1_epi32(DR2_MASK);
+    const __m512i vmax   = _mm512_set1_epi32(max);
+    const __m512i vveto  = _mm512_set1_epi32(veto);
+    __m512i vsum = _mm512_setzero_si512();
+
+    const unsigned int npadded = soa.npadded();
+    for (unsigned int i = 0; i < npadded; i += 16)
+    {
+        __m512i eta = _mm512_cvtepi16_epi32(_mm256_load_si256(reinterpret_cast<const __m256i *>(&soa.eta[i])));
+        __m512i phi = _mm512_cvtepi16_epi32(_mm256_load_si256(reinterpret_cast<const __m256i *>(&soa.phi[i])));
+        __m512i pt  = _mm512_cvtepu16_epi32(_mm256_load_si256(reinterpret_cast<const __m256i *>(&soa.pt[i])));
+
+        __m512i dphi = _mm512_sub_epi32(vsphi, phi);
+        dphi = _mm512_mask_sub_epi32(dphi, _mm512_cmpgt_epi32_mask(dphi, vpi), dphi, v2pi);
+        dphi = _mm512_mask_add_epi32(dphi, _mm512_cmplt_epi32_mask(dphi, vmpi), dphi, v2pi);
+        __m512i deta = _mm512_sub_epi32(vseta, eta);
+
+        __m512i dr2 = _mm512_add_epi32(_mm512_mullo_epi32(dphi, dphi), _mm512_mullo_epi32(deta, deta));
+        dr2 = _mm512_and_si512(dr2, vmask);
+
+        __mmask16 in = _mm512_cmplt_epi32_mask(dr2, vmax) & _mm512_cmpgt_epi32_mask(dr2, vveto);
+        vsum = _mm512_mask_add_epi32(vsum, in, vsum, pt);
+    }
+    return _mm512_reduce_add_epi32(vsum);
+}
+#endif
+
+// ------------------------------------------------------------------
+// Dispatch
+bool iso_kernel_supported(IsoKernel kernel)
+{
+    switch (kernel)
+    {
+#if ISO_SIMD_X86
+        case IsoKernel::AVX2:   return __builtin_cpu_supports("avx2");
+        case IsoKernel::AVX512: return __builtin_cpu_supports("avx512f");
+#else
+        case IsoKernel::AVX2:   return false;
+        case IsoKernel::AVX512: return false;
+#endif
+        default:                return true;
+    }
+}
+
+IsoKernel iso_kernel_best()
+{
+    static const IsoKernel best = iso_kernel_supported(IsoKernel::AVX512) ? IsoKernel::AVX512 :
+                                  iso_kernel_supported(IsoKernel::AVX2)   ? IsoKernel::AVX2   : IsoKernel::Scalar;
+    return best;
+}
+
+const char * iso_kernel_name(IsoKernel kernel)
+{
+    switch (kernel)
+    {
+        case IsoKernel::Scalar: return "scalar";
+        case IsoKernel::AVX2:   return "avx2";
+        case IsoKernel::AVX512: return "avx512";
+        default:                return iso_kernel_name(iso_kernel_best());
+    }
+}
+
+void compute_isolation_simd(const PuppiEventSoA<NPUPPI_MAX> & soa, const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NPUPPI_MAX],
+                            dr2_t dr2_max, dr2_t dr2_veto, IsoKernel kernel)
+{
+    if (kernel == IsoKernel::Best || !iso_kernel_supported(kernel))
+        kernel = iso_kernel_best();
+
+    unsigned int (*iso_sum)(const PuppiEventSoA<NPUPPI_MAX> &, int, int, unsigned int, unsigned int) = iso_sum_scalar;
+#if ISO_SIMD_X86
+    if (kernel == IsoKernel::AVX2)   iso_sum = iso_sum_avx2;
+    if (kernel == IsoKernel::AVX512) iso_sum = iso_sum_avx512;
+#endif
+
+    const unsigned int max = dr2_max.to_uint(), veto = dr2_veto.to_uint();
+    for (unsigned int j = 0; j < soa.n; ++j)
+    {
+        output_absiso[j] = 0;
+        if (masked[j]) continue;
+        unsigned int sum = iso_sum(soa, soa.eta[j], soa.phi[j], max, veto);
+        // Saturate as pt_t does and store the raw bits
+        output_absiso[j](Puppi::pt_t::width-1, 0) = sum > PT_RAW_MAX ? PT_RAW_MAX : sum;
+    }
+}
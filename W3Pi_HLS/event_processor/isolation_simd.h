@@ -0,0 +1,33 @@
+#ifndef ISOLATION_SIMD_H
+#define ISOLATION_SIMD_H
+
+#include "src/event_processor.h"
+#include "../utils/puppi_soa.h"
+#include <cstdint>
+
+/**************************************************
+ * Vectorized CPU isolation over integer eta/phi in SoA layout (PuppiEventSoA)
+ *
+ * Same integer arithmetic as deltaR2 in event_processor_ref (dphi wrap at Puppi::INT_PI,
+ * dr2 truncated to dr2_t, cone and veto tests), evaluated on 32-bit lanes:
+ *  - Scalar : plain C++ loop
+ *  - AVX2   : 8 candidates per instruction
+ *  - AVX512 : 16 candidates per instruction (AVX-512F)
+ * pT are accumulated as raw integers and saturated at the end like pt_t, so all the
+ * kernels are bit-exact with event_processor_ref.
+ * The kernel is picked at run time from the CPU features (IsoKernel::Best).
+ **************************************************/
+
+enum class IsoKernel { Scalar, AVX2, AVX512, Best };
+
+// Best kernel supported by this CPU
+IsoKernel iso_kernel_best();
+// True if the kernel can run on this CPU
+bool iso_kernel_supported(IsoKernel kernel);
+const char * iso_kernel_name(IsoKernel kernel);
+
+// Compute isolation for all (filtered) candidates (same output as compute_isolation_ref)
+void compute_isolation_simd(const PuppiEventSoA<NPUPPI_MAX> & soa, const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NPUPPI_MAX],
+                            dr2_t dr2_max, dr2_t dr2_veto, IsoKernel kernel = IsoKernel::Best);
+
+#endif
@@ -0,0 +1,148 @@
+// Accuracy report of the fixed-point triplet mass (src/triplet_mass.h)
+//
+// Usage:
+//   mass_report [file1.dump ...]     (default: the bundled W3Pi dumps, run from the data directory)
+//
+// For every triplet built by event_processor_ref, the LUT mass is compared with:
+//  - triplet_mass_ref  : same massless formula in floating point (LUT and fixed-point error)
+//  - PtEtaPhiMVector   : four-vector sum with M = 0 and with the charged pion mass
+// ROOT::Math::PtEtaPhiMVector is used when the ROOT headers are found (compile with
+// `root-config --cflags`), otherwise an equivalent double precision four-vector.
+#include "src/event_processor.h"
+#include "../utils/triplet_mass.h"
+#include "../utils/dump_reader.h"
+#include "../utils/puppi_soa.h"
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#if defined(__has_include)
+#if __has_include("Math/Vector4D.h")
+#include "Math/Vector4D.h"
+#define MASS_REPORT_ROOT 1
+#endif
+#endif
+
+#ifdef MASS_REPORT_ROOT
+typedef ROOT::Math::PtEtaPhiMVector tlv;
+#else
+// Minimal stand-in for ROOT::Math::PtEtaPhiMVector (sum and M only)
+struct tlv {
+    double px, py, pz, e;
+    tlv(double pt, double eta, double phi, double m) :
+        px(pt*std::cos(phi)), py(pt*std::sin(phi)), pz(pt*std::sinh(eta)),
+        e(std::sqrt(pt*pt*std::cosh(eta)*std::cosh(eta) + m*m)) {}
+    tlv operator+(const tlv & o) const { tlv r = *this; r.px += o.px; r.py += o.py; r.pz += o.pz; r.e += o.e; return r; }
+    double M() const { double m2 = e*e - px*px - py*py - pz*pz; return m2 > 0 ? std::sqrt(m2) : 0; }
+};
+#endif
+
+// See replay_ref.cc: event_processor_ref may read up to input[-1] and input[255]
+#define NPUPPI_BUFFER (1 + 256)
+
+static constexpr double PION_MASS = 0.13957; // GeV
+
+// Running statistics of (test - ref)
+struct ErrorStats {
+    const char * name;
+    size_t n = 0, nwindow = 0;
+    double sum = 0, sum2 = 0, sumrel = 0, sumrel2 = 0, maxabs = 0, maxrel = 0;
+    std::vector<double> absrel;
+
+    explicit ErrorStats(const char * name_) : name(name_) {}
+
+    void fill(double test, double ref)
+    {
+        double d = test - ref, r = ref > 0 ? d / ref : 0;
+        n++;
+        sum += d; sum2 += d*d;
+        sumrel += r; sumrel2 += r*r;
+        maxabs = std::max(maxabs, std::abs(d));
+        maxrel = std::max(maxrel, std::abs(r));
+        absrel.push_back(std::abs(r));
+        // Different decision of the [MASS_MIN, MASS_MAX] window
+        if (inWindow(test) != inWindow(ref)) nwindow++;
+    }
+
+    static bool inWindow(double m) { return m >= MASS_MIN && m <= MASS_MAX; }
+
+    void print()
+    {
+        if (n == 0) return;
+        std::sort(absrel.begin(), absrel.end());
+        double mean = sum/n, rms = std::sqrt(std::max(0., sum2/n - mean*mean));
+        double rmean = sumrel/n, rrms = std::sqrt(std::max(0., sumrel2/n - rmean*rmean));
+        printf(" - vs %-26s: mean %+8.4f GeV  rms %7.4f GeV  max %7.4f GeV | rel. mean %+.2e  rms %.2e  p99 %.2e  max %.2e | window flips %zu (%.3f%%)\n",
+               name, mean, rms, maxabs, rmean, rrms, absrel[std::min(n-1, size_t(0.99*n))], maxrel, nwindow, 100.*nwindow/n);
+    }
+};
+
+int main(int argc, char **argv) {
+
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i) innames.push_back(argv[i]);
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU0.dump", "Puppi_w3p_PU200.dump"};
+
+    printf("Fixed-point triplet mass: COSCOSH_LSB %d, LUT sizes cos %d cosh %d, window [%d, %d] GeV\n",
+           COSCOSH_LSB, TripletMassLut<Puppi>::COS_SIZE, TripletMassLut<Puppi>::COSH_SIZE, MASS_MIN, MASS_MAX);
+#ifdef MASS_REPORT_ROOT
+    printf("Four-vectors: ROOT::Math::PtEtaPhiMVector\n");
+#else
+    printf("Four-vectors: double precision stand-in (ROOT headers not found)\n");
+#endif
+
+    ErrorStats vsRef("triplet_mass_ref (float)"), vsTlv("PtEtaPhiMVector (M=0)"), vsTlvPion("PtEtaPhiMVector (M=m_pi)");
+    size_t nevents = 0, ntriplets = 0, nwindow = 0;
+
+    for (const std::string & name : innames)
+    {
+        DumpReader in(name);
+        for (size_t ievt = 0; ievt < in.size(); ++ievt)
+        {
+            DumpEvent event = in.event(ievt);
+            unsigned int npuppi = event.npuppi();
+            if (npuppi == 0 || npuppi > NPUPPI_MAX) continue;
+            nevents++;
+
+            Puppi buffer[NPUPPI_BUFFER];
+            Puppi * puppi = buffer + 1;
+            PuppiEventSoA<NPUPPI_MAX> soa;
+            soa.unpack(event.data, npuppi);
+            soa.to_puppi(puppi, NPUPPI_BUFFER - 1);
+
+            Puppi pivot;
+            Triplet triplets[NTRIPLETS_MAX];
+            bool masked_triplets[NTRIPLETS_MAX];
+            event_processor_ref(npuppi, puppi, pivot, triplets, masked_triplets);
+
+            for (unsigned int i = 0; i < NTRIPLETS_MAX; ++i)
+            {
+                unsigned int idx[3] = {triplets[i].idx0, triplets[i].idx1, triplets[i].idx2};
+                // Only the triplets actually built
+                if (idx[0] == idx[1] || idx[0] == idx[2] || idx[1] == idx[2]) continue;
+                if (idx[0] >= npuppi || idx[1] >= npuppi || idx[2] >= npuppi) continue;
+                const Puppi & p0 = puppi[idx[0]], & p1 = puppi[idx[1]], & p2 = puppi[idx[2]];
+                ntriplets++;
+
+                double mfix = floatMass(triplet_mass2(p0, p1, p2));
+                if (ErrorStats::inWindow(mfix)) nwindow++;
+                vsRef.fill(mfix, triplet_mass_ref(p0, p1, p2));
+
+                tlv v0(p0.floatPt(), p0.floatEta(), p0.floatPhi(), 0), v1(p1.floatPt(), p1.floatEta(), p1.floatPhi(), 0), v2(p2.floatPt(), p2.floatEta(), p2.floatPhi(), 0);
+                vsTlv.fill(mfix, (v0 + v1 + v2).M());
+                tlv w0(p0.floatPt(), p0.floatEta(), p0.floatPhi(), PION_MASS), w1(p1.floatPt(), p1.floatEta(), p1.floatPhi(), PION_MASS), w2(p2.floatPt(), p2.floatEta(), p2.floatPhi(), PION_MASS);
+                vsTlvPion.fill(mfix, (w0 + w1 + w2).M());
+            }
+        }
+    }
+
+    printf("Triplets: %zu from %zu events, %zu (%.1f%%) in the mass window\n", ntriplets, nevents, nwindow, ntriplets ? 100.*nwindow/ntriplets : 0.);
+    vsRef.print();
+    vsTlv.print();
+    vsTlvPion.print();
+
+    return 0;
+}
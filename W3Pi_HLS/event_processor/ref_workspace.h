@@ -0,0 +1,68 @@
+#ifndef REF_WORKSPACE_H
+#define REF_WORKSPACE_H
+
+#include "src/event_processor.h"
+#include "isolation_grid.h"
+#include "../utils/puppi_soa.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**************************************************
+ * Working buffers of event_processor_ref, reused for all the events of a batch
+ *
+ * event_processor_ref declares its arrays (masks, isolation, eta/phi grid) on the stack of
+ * every call, and the callers unpack each event into a fresh candidate buffer that they
+ * clear entirely. A RefWorkspace owns all of them, for one thread:
+ *  - load() unpacks the packed words of an event into puppi(), and only clears the entries
+ *    written by the previous event (the buffer is padded as in replay_ref.cc, since
+ *    event_processor_ref may read up to input[-1] and input[255])
+ *  - event_processor_ref(..., ws) runs the reference on these buffers, with the same output;
+ *    when the input is puppi() the isolation grid is filled from the raw integers of soa
+ * The arrays of soa are aligned to 64 bytes (aligned SIMD loads): in C++14 a plain new only
+ * guarantees 16 bytes, so RefWorkspace has its own aligned operator new/delete.
+ **************************************************/
+
+struct RefWorkspace {
+    static constexpr unsigned int NBUFFER = 1 + 256;
+
+    PuppiEventSoA<NPUPPI_MAX> soa;
+    Puppi buffer[NBUFFER];
+    bool masked[NPUPPI_MAX];
+    Puppi::pt_t absiso[NPUPPI_MAX];
+    IsolationGrid grid;
+
+    RefWorkspace()
+    {
+        for (Puppi & p : buffer) p.clear();
+    }
+
+    Puppi * puppi() { return buffer + 1; }
+
+    // Heap allocation with the alignment of soa
+    static void * operator new(std::size_t size)
+    {
+        void * p = nullptr;
+        if (posix_memalign(&p, alignof(RefWorkspace), size)) throw std::bad_alloc();
+        return p;
+    }
+    static void operator delete(void * p) { free(p); }
+
+    // Unpack npuppi (at most NPUPPI_MAX) packed candidates into puppi()
+    Puppi * load(const uint64_t * words, unsigned int npuppi)
+    {
+        soa.unpack(words, npuppi);
+        soa.to_puppi(puppi(), nwritten_);
+        nwritten_ = npuppi;
+        return puppi();
+    }
+
+  private:
+    unsigned int nwritten_ = 0; // entries of puppi() to clear at the next load
+};
+
+// Same as select_candidates_ref and event_processor_ref, on the buffers of ws
+int select_candidates_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], bool masked[NPUPPI_MAX], IsolationGrid & grid, Puppi::pt_t output_absiso[NPUPPI_MAX]);
+void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX], RefWorkspace & ws);
+
+#endif
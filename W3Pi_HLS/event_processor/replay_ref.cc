@@ -0,0 +1,329 @@
+// Multi-threaded replay of whole .dump files through event_processor_ref
+//
+// Usage:
+//   replay_ref [-j nthreads] [-g grain] [-b] [-o output.txt] [-p orbits.txt] [-s stats.json] file1.dump [file2.dump ...]
+//
+//  - every file is memory-mapped and indexed once by DumpReader
+//  - events of all files are split in ranges of `grain` events, or with -b in orbit batches
+//    (consecutive events with the same run and orbit numbers, at most 3564, see DumpReader::orbits)
+//  - ranges are distributed in contiguous blocks over the threads
+//  - a thread with an empty queue steals ranges from the back of the other queues
+//  - each thread reuses the same buffers for all its events (see ref_workspace.h)
+//  - results are stored per event and written in file order at the end
+//  - with -b, the time and accept counts of each orbit are summarised, and written to orbits.txt with -p
+//  - built with -DW3P_STAGE_STATS, the counters and timing of each stage of the reference (see
+//    utils/stage_stats.h) are printed, and written to stats.json with -s
+#include "src/event_processor.h"
+#include "ref_workspace.h"
+#include "../utils/dump_reader.h"
+#include "../utils/puppi_soa.h"
+#include "../utils/stage_stats.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+
+// Buffer size for the Puppi candidates of one event.
+// event_processor_ref reads input[pivot_idx] with pivot_idx = -1 when no seed survives,
+// and filter_triplets reads input[idx] for idx up to 255 (Triplet::idx_t) when fewer than
+// NTRIPLETS_MAX triplets are built: pad the buffer so that these reads stay in bounds.
+#define NPUPPI_BUFFER (1 + 256)
+static_assert(RefWorkspace::NBUFFER == NPUPPI_BUFFER, "replay_ref: RefWorkspace buffer not padded");
+
+// -------------------------------------------------------------
+// Work items and queues
+struct EventRef {
+    unsigned int file;      // index in the list of files
+    unsigned int event;     // index of the event in its file
+    DumpEvent data;         // view on the mapped file
+};
+
+struct EventResult {
+    unsigned int npuppi = 0;
+    bool processed = false;
+    Puppi pivot;
+    Triplet triplets[NTRIPLETS_MAX];
+    bool masked_triplets[NTRIPLETS_MAX];
+};
+
+// Range queue of indexes in the list of ranges: the owner pops from the front, thieves pop from the back
+class RangeQueue {
+  public:
+    void push(size_t r) { std::lock_guard<std::mutex> lock(mutex_); ranges_.push_back(r); }
+    bool pop_front(size_t & r) { return pop(r, true); }
+    bool pop_back(size_t & r) { return pop(r, false); }
+  private:
+    bool pop(size_t & r, bool front)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ranges_.empty()) return false;
+        if (front) { r = ranges_.front(); ranges_.pop_front(); }
+        else       { r = ranges_.back();  ranges_.pop_back();  }
+        return true;
+    }
+    std::mutex mutex_;
+    std::deque<size_t> ranges_;
+};
+
+struct ThreadStats {
+    size_t nevents = 0;     // processed events
+    size_t npuppi = 0;      // processed Puppi candidates
+    size_t nranges = 0;     // processed ranges
+    size_t nstolen = 0;     // ranges stolen from other threads
+    double busy = 0;        // seconds spent processing
+};
+
+// -------------------------------------------------------------
+// Process one event: unpack into the buffers of the thread and call the reference
+void process_event(const EventRef & ref, EventResult & result, RefWorkspace & ws)
+{
+    unsigned int npuppi = ref.data.npuppi();
+    result.npuppi = npuppi;
+
+    // Same as testbench: use only events with at least 3 puppi candidates
+    if (npuppi < 3 || npuppi > NPUPPI_MAX) return;
+
+    // Bulk unpack, then convert to Puppi for the reference
+    Puppi * puppi = ws.load(ref.data.data, npuppi);
+
+    event_processor_ref(npuppi, puppi, result.pivot, result.triplets, result.masked_triplets, ws);
+    result.processed = true;
+}
+
+void worker(unsigned int id, std::vector<RangeQueue> & queues, const std::vector<DumpRange> & ranges,
+            const std::vector<EventRef> & events, std::vector<EventResult> & results,
+            std::vector<double> & range_time, ThreadStats & stats)
+{
+    std::unique_ptr<RefWorkspace> ws(new RefWorkspace());
+    unsigned int nqueues = queues.size();
+    size_t ir;
+    while (true)
+    {
+        // Own queue first, then steal from the others
+        bool found = queues[id].pop_front(ir);
+        for (unsigned int k = 1; !found && k < nqueues; ++k)
+        {
+            found = queues[(id+k) % nqueues].pop_back(ir);
+            if (found) stats.nstolen++;
+        }
+        // All ranges are queued before starting: no work left anywhere means we are done
+        if (!found) break;
+
+        const DumpRange & r = ranges[ir];
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = r.begin; i < r.end; ++i)
+        {
+            process_event(events[i], results[i], *ws);
+            stats.nevents++;
+            stats.npuppi += results[i].npuppi;
+        }
+        range_time[ir] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats.busy += range_time[ir];
+        stats.nranges++;
+    }
+}
+
+// -------------------------------------------------------------
+unsigned int count_passing(const EventResult & res)
+{
+    unsigned int npassing = 0;
+    for (unsigned int t = 0; t < NTRIPLETS_MAX; t++)
+        npassing += !res.masked_triplets[t];
+    return npassing;
+}
+
+// Write one line per event:
+//   file event npuppi processed pivot_pt pivot_eta pivot_phi pivot_id npassing [idx0-idx1-idx2 ...]
+void write_results(std::ostream & os, const std::vector<EventRef> & events, const std::vector<EventResult> & results)
+{
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const EventResult & res = results[i];
+        os << events[i].file << " " << events[i].event << " " << res.npuppi << " " << res.processed;
+        if (!res.processed) { os << "\n"; continue; }
+
+        unsigned int npassing = count_passing(res);
+        os << " " << res.pivot.floatPt() << " " << res.pivot.floatEta() << " " << res.pivot.floatPhi()
+           << " " << res.pivot.hwID.to_uint() << " " << npassing;
+        for (unsigned int t = 0; t < NTRIPLETS_MAX; t++)
+            if (!res.masked_triplets[t])
+                os << " " << res.triplets[t];
+        os << "\n";
+    }
+}
+
+// Accounting of one orbit batch
+struct OrbitStats {
+    unsigned int file, run, orbit;
+    size_t first, nevents;      // first event in the file, number of events
+    size_t nprocessed = 0;      // events with enough candidates for the reference
+    size_t naccepted = 0;       // events with at least one passing triplet
+    size_t npassing = 0;        // passing triplets
+    double time = 0;            // seconds spent processing
+};
+
+// Write one line per orbit:
+//   file run orbit first_event nevents nprocessed naccepted npassing time_us
+void write_orbits(std::ostream & os, const std::vector<OrbitStats> & orbits)
+{
+    for (const OrbitStats & o : orbits)
+        os << o.file << " " << o.run << " " << o.orbit << " " << o.first << " " << o.nevents << " " << o.nprocessed
+           << " " << o.naccepted << " " << o.npassing << " " << o.time * 1e6 << "\n";
+}
+
+void usage(const char * name)
+{
+    std::cerr << "Usage: " << name << " [-j nthreads] [-g grain] [-b] [-o output.txt] [-p orbits.txt] [-s stats.json] file1.dump [file2.dump ...]" << std::endl;
+}
+
+// -------------------------------------------------------------
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    unsigned int nthreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t grain = 64;
+    bool batch_orbits = false;
+    std::string outname, orbitsname, statsname;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-j") && i+1 < argc) nthreads = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-g") && i+1 < argc) grain = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-b")) batch_orbits = true;
+        else if (!strcmp(argv[i], "-o") && i+1 < argc) outname = argv[++i];
+        else if (!strcmp(argv[i], "-p") && i+1 < argc) orbitsname = argv[++i];
+        else if (!strcmp(argv[i], "-s") && i+1 < argc) statsname = argv[++i];
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty()) { usage(argv[0]); return 1; }
+#ifndef W3P_STAGE_STATS
+    if (!statsname.empty()) std::cerr << "Built without -DW3P_STAGE_STATS, no stage statistics in " << statsname << std::endl;
+#endif
+
+    // Map and index input files
+    auto load_start = std::chrono::steady_clock::now();
+    std::vector<DumpReader> dumps(innames.size());
+    std::vector<EventRef> events;
+    std::vector<DumpRange> ranges;
+    for (unsigned int f = 0; f < innames.size(); ++f)
+    {
+        if (!dumps[f].open(innames[f]))
+        {
+            std::cerr << "Cannot open " << innames[f] << std::endl;
+            return 1;
+        }
+        if (dumps[f].truncated())
+            std::cerr << "Truncated last event in " << innames[f] << std::endl;
+        size_t offset = events.size();
+        for (unsigned int e = 0; e < dumps[f].size(); ++e)
+            events.push_back({f, e, dumps[f].event(e)});
+        if (batch_orbits)
+            for (const DumpRange & r : dumps[f].orbits())
+                ranges.push_back({offset + r.begin, offset + r.end});
+        std::cout << " - " << innames[f] << ": " << dumps[f].size() << " events" << std::endl;
+    }
+    double load_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - load_start).count();
+
+    // Split events in ranges (unless batched by orbit) and give each thread a contiguous block of ranges
+    if (!batch_orbits)
+        for (size_t b = 0; b < events.size(); b += grain)
+            ranges.push_back({b, std::min(events.size(), b + grain)});
+    std::vector<RangeQueue> queues(nthreads);
+    size_t nranges = ranges.size();
+    for (size_t r = 0; r < nranges; ++r)
+        queues[r * nthreads / nranges].push(r);
+
+    // Run
+    std::vector<EventResult> results(events.size());
+    std::vector<double> range_time(nranges, 0.);
+    std::vector<ThreadStats> stats(nthreads);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int t = 0; t < nthreads; ++t)
+        threads.emplace_back(worker, t, std::ref(queues), std::cref(ranges), std::cref(events), std::ref(results),
+                             std::ref(range_time), std::ref(stats[t]));
+    for (auto & th : threads)
+        th.join();
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Write results in file order
+    if (!outname.empty())
+    {
+        std::ofstream out(outname);
+        write_results(out, events, results);
+    }
+
+    // Orbit accounting
+    std::vector<OrbitStats> orbits;
+    if (batch_orbits)
+    {
+        for (size_t r = 0; r < nranges; ++r)
+        {
+            const EventRef & first = events[ranges[r].begin];
+            OrbitStats o{first.file, first.data.header.run(), first.data.header.orbit(), first.event, ranges[r].size()};
+            for (size_t i = ranges[r].begin; i < ranges[r].end; ++i)
+            {
+                if (!results[i].processed) continue;
+                unsigned int npassing = count_passing(results[i]);
+                o.nprocessed++;
+                o.naccepted += (npassing > 0);
+                o.npassing += npassing;
+            }
+            o.time = range_time[r];
+            orbits.push_back(o);
+        }
+        if (!orbitsname.empty())
+        {
+            std::ofstream out(orbitsname);
+            write_orbits(out, orbits);
+        }
+    }
+
+    // Report
+    size_t nprocessed = std::count_if(results.begin(), results.end(), [](const EventResult & r) { return r.processed; });
+    if (batch_orbits)
+        printf("Replayed %zu events (%zu processed) from %zu file(s) with %u thread(s), %zu orbit batches\n",
+                events.size(), nprocessed, dumps.size(), nthreads, nranges);
+    else
+        printf("Replayed %zu events (%zu processed) from %zu file(s) with %u thread(s), grain %zu\n",
+                events.size(), nprocessed, dumps.size(), nthreads, grain);
+    printf(" - map+index : %.3f s\n", load_time);
+    printf(" - processing: %.3f s -> %.1f events/s\n", wall, wall > 0 ? events.size()/wall : 0.);
+    printf(" - per-thread load:\n");
+    for (unsigned int t = 0; t < nthreads; ++t)
+        printf("   %3u : events %8zu  puppi %10zu  ranges %6zu  stolen %6zu  busy %.3f s (%5.1f%%)\n",
+                t, stats[t].nevents, stats[t].npuppi, stats[t].nranges, stats[t].nstolen,
+                stats[t].busy, wall > 0 ? 100.*stats[t].busy/wall : 0.);
+    if (batch_orbits && !orbits.empty())
+    {
+        double total = 0, tmax = 0;
+        size_t accepted = 0;
+        for (const OrbitStats & o : orbits)
+        {
+            total += o.time;
+            tmax = std::max(tmax, o.time);
+            accepted += o.naccepted;
+        }
+        printf(" - per orbit : %zu orbits, mean %.3f ms, max %.3f ms, %zu accepted events (%.2f%% of processed)\n",
+                orbits.size(), 1e3*total/orbits.size(), 1e3*tmax, accepted, nprocessed ? 100.*accepted/nprocessed : 0.);
+    }
+
+#ifdef W3P_STAGE_STATS
+    // Per-stage counters and timing, merged over the threads
+    w3p_stats::print_stats();
+    if (!statsname.empty() && !w3p_stats::write_stats_json(statsname))
+        std::cerr << "Cannot write " << statsname << std::endl;
+#endif
+
+    return 0;
+}
@@ -1,7 +1,9 @@
 open_project -reset proj_w3p
 set_top event_processor
 add_files src/event_processor.cc
+add_files src/event_processor_sorted.cc
 add_files -tb event_processor_ref.cc
+add_files -tb isolation_simd.cc
 add_files -tb testbench.cc -cflags "-DON_W3P"
 add_files -tb ../data/Puppi_w3p_PU200.dump
 
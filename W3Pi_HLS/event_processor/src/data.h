@@ -1,17 +1,16 @@
 #ifndef ALGO_DATA_H
 #define ALGO_DATA_H
 
-#include "ap_int.h"
-#include "ap_fixed.h"
+#include "../../utils/w3p_types.h"
 #include <cstdint>
 #include <fstream>
 #include "math.h"
 
 struct Puppi {
     // data types and constants
-    typedef ap_ufixed<14,12,AP_RND,AP_SAT>  pt_t; 
-    typedef ap_int<12> eta_t;
-    typedef ap_int<11> phi_t;
+    typedef w3p_ufixed<14,12,AP_RND,AP_SAT>  pt_t; 
+    typedef w3p_int<12> eta_t;
+    typedef w3p_int<11> phi_t;
     static constexpr int INT_PI = 720;
     static constexpr int INT_2PI = 2*INT_PI;
     static constexpr float ETAPHI_LSB = M_PI/INT_PI; // FIXME: where is M_PI declared??
@@ -21,8 +20,25 @@ struct Puppi {
     pt_t hwPt;
     eta_t hwEta;
     phi_t hwPhi;
-    ap_uint<3> hwID;
+    w3p_uint<3> hwID;
     // pack and unpack
+#ifdef W3P_NATIVE_TYPES
+    // raw bits of the native types: shifts and masks, the signed fields are sign-extended
+    // by set_raw_bits (same layout as PuppiEventSoA::unpack)
+    uint64_t pack() const {
+        return   hwPt.raw_bits()
+             | (hwEta.raw_bits() << 14)
+             | (hwPhi.raw_bits() << 26)
+             | (hwID.raw_bits()  << 37);
+    }
+    Puppi & unpack(uint64_t packed) {
+        hwPt.set_raw_bits(packed & 0x3FFF);
+        hwEta.set_raw_bits((packed >> 14) & 0xFFF);
+        hwPhi.set_raw_bits((packed >> 26) & 0x7FF);
+        hwID.set_raw_bits((packed >> 37) & 0x7);
+        return *this;
+    }
+#else
     uint64_t pack() const {
         ap_uint<64> ret;
         ret(13,0)  = hwPt(13,0);
@@ -39,6 +55,7 @@ struct Puppi {
        hwID(2,0)   = packed(39,37);
        return *this;
     }
+#endif
     void clear() {
         hwPt = 0;
         hwEta = 0;
@@ -68,7 +85,7 @@ struct Puppi {
 
 struct Triplet {
     // data types and constants
-    typedef ap_uint<8> idx_t; // represent up to 2^8 = 256 indexes
+    typedef w3p_uint<8> idx_t; // represent up to 2^8 = 256 indexes
     // data members
     idx_t idx0;
     idx_t idx1;
@@ -1,4 +1,8 @@
 #include "event_processor.h"
+#include "../../utils/triplet_mass.h"
+#include "isolation_engine.h"
+#include "triplet_builder.h"
+#include "../../utils/stage_stats.h"
 #ifndef __SYNTHESIS__
 #include <cstdio>
 #endif
@@ -21,7 +25,7 @@ Puppi::pt_t SumReduceAll(const Puppi::pt_t in[NPUPPI_MAX]) {
     return SumReduce<NPUPPI_MAX>(in);
 }
 
-ap_int<Puppi::eta_t::width+1> deltaEta(Puppi::eta_t eta1, Puppi::eta_t eta2) {
+w3p_int<Puppi::eta_t::width+1> deltaEta(Puppi::eta_t eta1, Puppi::eta_t eta2) {
     #pragma HLS latency min=1
     #pragma HLS inline off
     return eta1 - eta2;
@@ -112,16 +116,7 @@ void filter_candidates(const Puppi input[NPUPPI_MAX], bool masked[NPUPPI_MAX])
         bool badPt  = input[i].hwPt <= 3;
         bool badEta = input[i].hwEta < -Puppi::ETA_CUT || input[i].hwEta > Puppi::ETA_CUT;
         masked[i] = (badID || badPt || badEta);
-        // Debug printout
-        //if (i < 5)
-        //{
-        //    std::cout << " - Candidate: " << i << " - badID: " << badID << " badPt: " << badPt << " badEta: " << badEta << " - masked:" << masked[i] << std::endl;
-        //    std::cout << "            pT: " << input[i].hwPt << " eta: " << input[i].hwEta*Puppi::ETAPHI_LSB << " ID: " << input[i].hwID << std::endl;
-        //    std::cout << "            eta_raw: " << input[i].hwEta << " ETA_CUT_raw: " << Puppi::ETA_CUT << std::endl;
-        //}
     }
-    // Debug printout
-    //for (unsigned int i = 0; i < 5; i++) std::cout << " - Filtered Candidate: " << i << " - masked ? " << masked[i] << std::endl;
 }
 
 // Filter triplets
@@ -143,8 +138,8 @@ void filter_triplets(const Puppi input[NPUPPI_MAX], const Triplet triplets[NTRIP
 
         // Add selections on sum-charge, pt triplet, mass triplet
         masked_triplets[i] = ( std::abs(input[idx0].charge()+input[idx1].charge()+input[idx2].charge()) != 1 ||
-                              (input[idx0].hwPt < 15) || (input[idx1].hwPt < 4) || (input[idx2].hwPt < 3)
-                              // FIXME: add mass selection here
+                              (input[idx0].hwPt < 15) || (input[idx1].hwPt < 4) || (input[idx2].hwPt < 3) ||
+                              !triplet_mass_window(input[idx0], input[idx1], input[idx2])
                             );
     }
 }
@@ -157,9 +152,6 @@ Puppi::pt_t get_iso(const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX]
     #pragma HLS ARRAY_PARTITION variable=masked complete
     //#pragma HLS pipeline II=9
 
-    // Debug printout
-    //std::cout << "  - Inside pT: " << seed.hwPt << " eta: " << seed.hwEta*Puppi::ETAPHI_LSB << " ID: " << seed.hwID << std::endl;
-
     // Define list of pts to sum (particle inside isolation cone)
     Puppi::pt_t tosum[NPUPPI_MAX];
     #pragma HLS ARRAY_PARTITION variable=tosum complete
@@ -176,15 +168,10 @@ Puppi::pt_t get_iso(const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX]
 
         // If inside and not in veto cone, get pt for iso computation
         tosum[i] = inside && (dr2 > dr2_veto) ? input[i].hwPt : Puppi::pt_t(0);
-
-        // Debug printout
-        //if (i < 5) std::cout << "      Part " << i << " dR2: " << dr2 << " inside: " << inside << " veto: " << (dr2 <= dr2_veto) << " tosum: " << tosum[i] << std::endl;
     }
 
     // Compute final sum to get iso_sum
     Puppi::pt_t iso_sum = SumReduceAll(tosum);
-    // Debug printout
-    //std::cout << "    iso_sum: " << iso_sum << std::endl;
 
     return iso_sum;
 }
@@ -197,9 +184,8 @@ void compute_isolation(const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_M
     #pragma HLS ARRAY_PARTITION variable=output_absiso complete
     //#pragma HLS pipeline II=9
 
-    // Compute isolation for all (filtered) candidates
-    LOOP_CI: for (unsigned int j = 0; j < NPUPPI_MAX; ++j)
-        output_absiso[j] = masked[j] ? Puppi::pt_t(0) : get_iso(input, masked, dr2_max, dr2_veto, input[j]);
+    // Compute isolation for all (filtered) candidates, ISO_LANES seeds per clock cycle
+    isolation_engine<ISO_LANES>(input, masked, output_absiso, dr2_max, dr2_veto);
 }
 
 // Top function:
@@ -220,6 +206,7 @@ void event_processor (const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet trip
 
     // Filter candidates
     filter_candidates(input, masked);
+    W3P_STATS_COUNT("hls.filtered", std::count(masked, masked + NPUPPI_MAX, false));
 
     // Define isolation array
     Puppi::pt_t output_absiso[NPUPPI_MAX];
@@ -242,11 +229,7 @@ void event_processor (const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet trip
         masked[i] = masked[i] ? masked[i] : (output_absiso[i]/input[i].hwPt) > 0.6;
     }
 
-    // Debug printout
-    //for (unsigned int i = 0; i < 45; i++)
-    //    if (!masked[i])
-    //        std::cout << " -> Seed " << i << " pT: " << input[i].hwPt << " eta: " << input[i].hwEta*Puppi::ETAPHI_LSB << " pdgID: " << input[i].hwID
-    //                << " charge: " << input[i].charge() << " IsoSum: " << output_absiso[i] << " Masked: " << masked[i] << std::endl;
+    W3P_STATS_COUNT("hls.isolated", std::count(masked, masked + NPUPPI_MAX, false));
 
     // Indexes array
     int my_indexes[NPUPPI_MAX];
@@ -258,37 +241,10 @@ void event_processor (const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet trip
     int pivot_idx = find_pivot_idx(input, masked, my_indexes);
     pivot = input[pivot_idx];
 
-    // Debug printout
-    //std::cout << "---> Pivot     idx: " << pivot_idx << std::endl;
-    //std::cout << "     Pivot     pT : " << pivot.hwPt << " eta: " << pivot.hwEta*Puppi::ETAPHI_LSB << " pdgID: " << pivot.hwID << std::endl;
-
-    // Build all triplets (pT ordered) starting from pivot
-    int ntriplets = 0;
-    LOOP_EP4: for (unsigned int i = 0; i < NPUPPI_MAX-1; i++)
-        for (unsigned int j = i+1; j < NPUPPI_MAX; j++)
-        {
-            if (ntriplets == NTRIPLETS_MAX)
-                break;
-
-            if (i == pivot_idx || masked[i] || j == pivot_idx || masked[j])
-                continue;
-
-            triplets[ntriplets] = (input[i].hwPt >= input[j].hwPt) ? Triplet(pivot_idx,i,j) : Triplet(pivot_idx,j,i);
-            ntriplets++;
-        }
-
-    // Debug printout
-    //std::cout << "---> My Triplets:" << std::endl;
-    //for (unsigned int i = 0; i < ntriplets; i++)
-    //    std::cout << "     - triplet: " << triplets[i].idx0 << "-" << triplets[i].idx1 << "-" << triplets[i].idx2 << std::endl;
+    // Build all triplets (pT ordered) starting from pivot, first NTRIPLETS_MAX in (i,j) order
+    build_triplets<NPUPPI_MAX>(input, masked, pivot_idx, triplets);
 
     // Filter triplets
     filter_triplets(input, triplets, masked_triplets);
-
-    // Debug printout
-    //std::cout << "     My Cleaned Triplets:" << std::endl;
-    //for (unsigned int i = 0; i < NTRIPLETS_MAX; i++)
-    //    if (!masked_triplets[i])
-    //        std::cout << "     - triplet: " << triplets[i].idx0 << "-" << triplets[i].idx1 << "-" << triplets[i].idx2 << std::endl;
-
+    W3P_STATS_COUNT("hls.triplets_passing", std::count(masked_triplets, masked_triplets + NTRIPLETS_MAX, false));
 }
@@ -9,12 +9,30 @@
 #define NISO_MAX 12
 #define NTRIPLETS_MAX 30
 
-typedef ap_uint<24> dr2_t;
+// Seeds processed per clock cycle by the isolation engine (isolation_engine.h)
+#ifndef ISO_LANES
+#define ISO_LANES 8
+#endif
+
+// Leading candidates used by event_processor_sorted (pT-sorted input)
+#ifndef NLEAD
+#define NLEAD 32
+#endif
+
+typedef w3p_uint<24> dr2_t;
 
 inline dr2_t drToHwDr2(float dr) { return dr2_t(round(std::pow(dr/Puppi::ETAPHI_LSB,2))); }
 
 // w3p HLS implementation
+void filter_candidates(const Puppi input[NPUPPI_MAX], bool masked[NPUPPI_MAX]);
+void filter_triplets(const Puppi input[NPUPPI_MAX], const Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX]);
+Puppi::pt_t get_iso(const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX], const dr2_t dr2_max, const dr2_t dr2_veto, const Puppi seed);
 void event_processor (const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX]);
+void event_processor_sorted (const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX]);
 void event_processor_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX]);
+int select_candidates_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], bool masked[NPUPPI_MAX]);
+void compute_isolation_ref (unsigned int npuppi, const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NPUPPI_MAX], dr2_t dr2_max, dr2_t dr2_veto);
+void compute_isolation_grid (unsigned int npuppi, const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NPUPPI_MAX], dr2_t dr2_max, dr2_t dr2_veto);
+float triplet_mass_ref (const Puppi & p0, const Puppi & p1, const Puppi & p2);
 
 #endif
@@ -0,0 +1,58 @@
+#include "event_processor.h"
+#include "isolation_engine.h"
+#include "triplet_builder.h"
+
+// Variant of event_processor for pT-sorted input (decreasing pT, e.g. the output of w3p_streamer):
+//  - only the leading NLEAD candidates can be seeds: isolation is computed for NLEAD seeds
+//    against all the candidates (NLEAD x NPUPPI_MAX instead of NPUPPI_MAX^2)
+//  - the pivot is the first unmasked candidate (priority encoder, no pT comparisons),
+//    or input[0] if there is none (then all the triplets are masked)
+//  - the triplets are built from the pairs of the leading NLEAD candidates (NLEAD^2 pairs)
+// The output is the same as event_processor on the same input when input[NLEAD] has
+// pT <= 3 GeV, since the following candidates are then masked by the pT cut.
+void event_processor_sorted (const Puppi input[NPUPPI_MAX], Puppi & pivot, Triplet triplets[NTRIPLETS_MAX], bool masked_triplets[NTRIPLETS_MAX])
+{
+    #pragma HLS ARRAY_PARTITION variable=input complete
+    #pragma HLS ARRAY_PARTITION variable=triplets complete
+    #pragma HLS ARRAY_PARTITION variable=masked_triplets complete
+
+    // Filter candidates
+    bool masked[NPUPPI_MAX];
+    #pragma HLS ARRAY_PARTITION variable=masked complete
+    filter_candidates(input, masked);
+
+    // Define min/max isolation cones
+    const dr2_t dr2_max = drToHwDr2(0.4), dr2_veto = drToHwDr2(0.1);
+
+    // Compute abs isolation for the leading filtered candidates
+    Puppi::pt_t output_absiso[NLEAD];
+    #pragma HLS ARRAY_PARTITION variable=output_absiso complete
+    isolation_engine<ISO_LANES, NLEAD>(input, masked, output_absiso, dr2_max, dr2_veto);
+
+    // Update mask to consider only (iso_sum/pt) <= 0.6
+    LOOP_EPS1: for (unsigned int i = 0; i < NLEAD; i++)
+    {
+        #pragma HLS UNROLL
+        masked[i] = masked[i] ? masked[i] : (output_absiso[i]/input[i].hwPt) > 0.6;
+    }
+
+    // Find pivot: first unmasked candidate
+    int pivot_idx = 0;
+    bool found = false;
+    LOOP_EPS2: for (int i = 0; i < NLEAD; i++)
+    {
+        #pragma HLS UNROLL
+        if (!found && !masked[i])
+        {
+            pivot_idx = i;
+            found = true;
+        }
+    }
+    pivot = input[pivot_idx];
+
+    // Build all triplets (pT ordered) starting from pivot, on the leading candidates
+    build_triplets<NLEAD>(input, masked, pivot_idx, triplets);
+
+    // Filter triplets
+    filter_triplets(input, triplets, masked_triplets);
+}
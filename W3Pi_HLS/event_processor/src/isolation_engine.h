@@ -0,0 +1,120 @@
+#ifndef ISOLATION_ENGINE_H
+#define ISOLATION_ENGINE_H
+
+#include "event_processor.h"
+
+/**************************************************
+ * Time-multiplexed isolation engine
+ *
+ * LANES seeds are processed per clock cycle, each against all the NPUPPI_MAX candidates
+ * (get_iso: NPUPPI_MAX dR2 units and a NPUPPI_MAX-input adder tree per lane), in a loop
+ * of ceil(NSEEDS/LANES) pipelined iterations. The seeds are the first NSEEDS candidates
+ * (all of them by default, the leading ones for pT-sorted inputs):
+ *  - LANES = NSEEDS : fully parallel, NSEEDS*NPUPPI_MAX dR2 units
+ *  - LANES = 1      : one seed per cycle, NPUPPI_MAX dR2 units
+ * The output does not depend on LANES.
+ *
+ * IsolationEngineModel<LANES,NSEEDS> (or isolation_engine_cost() at run time) estimates the
+ * latency in clock cycles and the arithmetic units of a given setting, to pick the
+ * smallest LANES meeting the per-event latency budget (see isolation_engine_report.cc).
+ * The stage depths are estimates at the 2.777 ns clock of run_hls_w3p.tcl, to be updated
+ * from the csynth reports.
+ **************************************************/
+
+// Pipeline depths (clock cycles) of one engine iteration
+#define ISO_DEPTH_SEED 1     // read of the LANES seeds
+#define ISO_DEPTH_DR2 5      // dphi/deta, wrap, two multiplications (DSP) and sum
+#define ISO_DEPTH_CONE 1     // cone/veto comparisons and pT select
+#define ISO_ADDERS_DEPTH 2   // adder tree levels per clock cycle
+#define ISO_DEPTH_WRITE 1    // write of the LANES sums
+
+struct IsolationEngineCost {
+    int lanes;
+    int iterations;    // pipelined loop iterations (II = 1)
+    int depth;         // latency of one iteration
+    int latency;       // total latency [clock cycles]
+    int dr2_units;     // dR2 evaluations instantiated
+    int multipliers;   // dphi^2 and deta^2
+    int adders;        // adder tree nodes
+
+    float latency_ns(float clock_ns) const { return latency * clock_ns; }
+};
+
+// Levels of a balanced adder tree with n inputs
+constexpr int iso_adder_levels(int n) { return n <= 1 ? 0 : 1 + iso_adder_levels((n+1)/2); }
+
+constexpr IsolationEngineCost isolation_engine_cost(int lanes, int nseeds = NPUPPI_MAX, int ncands = NPUPPI_MAX)
+{
+    IsolationEngineCost c{};
+    c.lanes = lanes;
+    c.iterations = (nseeds + lanes - 1) / lanes;
+    c.depth = ISO_DEPTH_SEED + ISO_DEPTH_DR2 + ISO_DEPTH_CONE + ISO_DEPTH_WRITE
+            + (iso_adder_levels(ncands) + ISO_ADDERS_DEPTH - 1) / ISO_ADDERS_DEPTH;
+    c.latency = c.depth + c.iterations - 1;
+    c.dr2_units = lanes * ncands;
+    c.multipliers = 2 * c.dr2_units;
+    c.adders = lanes * (ncands - 1);
+    return c;
+}
+
+template<int LANES, int NSEEDS = NPUPPI_MAX>
+struct IsolationEngineModel {
+    static_assert(NSEEDS >= 1 && NSEEDS <= NPUPPI_MAX, "NSEEDS must be in [1, NPUPPI_MAX]");
+    static_assert(LANES >= 1 && LANES <= NSEEDS, "LANES must be in [1, NSEEDS]");
+    static constexpr int NITER = (NSEEDS + LANES - 1) / LANES;
+    static constexpr IsolationEngineCost cost = isolation_engine_cost(LANES, NSEEDS);
+    static constexpr int LATENCY = cost.latency;
+};
+
+// Compute isolation for the first NSEEDS (filtered) candidates, LANES seeds per clock cycle
+template<int LANES, int NSEEDS = NPUPPI_MAX>
+void isolation_engine(const Puppi input[NPUPPI_MAX], const bool masked[NPUPPI_MAX], Puppi::pt_t output_absiso[NSEEDS], dr2_t dr2_max, dr2_t dr2_veto)
+{
+    #pragma HLS ARRAY_PARTITION variable=input complete
+    #pragma HLS ARRAY_PARTITION variable=masked complete
+    #pragma HLS ARRAY_PARTITION variable=output_absiso complete
+
+    static constexpr int NITER = IsolationEngineModel<LANES, NSEEDS>::NITER;
+
+    // Seeds and results in [iteration][lane], so each iteration only addresses its own row
+    // (no NSEEDS:1 multiplexer per lane)
+    Puppi seeds[NITER][LANES];
+    bool seeds_masked[NITER][LANES];
+    Puppi::pt_t absiso[NITER][LANES];
+    #pragma HLS ARRAY_PARTITION variable=seeds complete dim=2
+    #pragma HLS ARRAY_PARTITION variable=seeds_masked complete dim=2
+    #pragma HLS ARRAY_PARTITION variable=absiso complete dim=2
+
+    LOOP_IE_LOAD: for (int j = 0; j < NITER*LANES; ++j)
+    {
+        #pragma HLS UNROLL
+        if (j < NSEEDS)
+        {
+            seeds[j/LANES][j%LANES] = input[j];
+            seeds_masked[j/LANES][j%LANES] = masked[j];
+        }
+        else
+        {
+            seeds[j/LANES][j%LANES].clear();
+            seeds_masked[j/LANES][j%LANES] = true;
+        }
+    }
+
+    LOOP_IE_SEEDS: for (int it = 0; it < NITER; ++it)
+    {
+        #pragma HLS PIPELINE II=1
+        LOOP_IE_LANES: for (int l = 0; l < LANES; ++l)
+        {
+            #pragma HLS UNROLL
+            absiso[it][l] = seeds_masked[it][l] ? Puppi::pt_t(0) : get_iso(input, masked, dr2_max, dr2_veto, seeds[it][l]);
+        }
+    }
+
+    LOOP_IE_STORE: for (int j = 0; j < NSEEDS; ++j)
+    {
+        #pragma HLS UNROLL
+        output_absiso[j] = absiso[j/LANES][j%LANES];
+    }
+}
+
+#endif
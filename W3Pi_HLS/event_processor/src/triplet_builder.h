@@ -0,0 +1,148 @@
+#ifndef TRIPLET_BUILDER_H
+#define TRIPLET_BUILDER_H
+
+#include "event_processor.h"
+#include <cstdint>
+
+/**************************************************
+ * Fixed-latency triplet builder
+ *
+ * Same triplets as the serial loop over the pairs (i,j), i < j, of the good candidates
+ * (not masked and not the pivot), keeping the first NTRIPLETS_MAX in (i,j) order:
+ *  - the good flags are turned into ranks by a parallel prefix sum (log2(N) adder levels)
+ *  - the first NCOMPACT good candidates are gathered by rank (one-hot multiplexers):
+ *    the first NTRIPLETS_MAX pairs only involve them, whatever the number of candidates
+ *  - the pairs of ranks (a,b) of each output slot only depend on the number of good
+ *    candidates n (clipped to NCOMPACT), and are read from a table generated at compile time
+ * There is no running counter nor early exit, so the builder is fully pipelined and works
+ * for any number of input candidates N (NPUPPI_MAX of event_processor or of the streamer).
+ * Unused slots are set to Triplet(0,0,0), as left by the serial loop.
+ **************************************************/
+
+#define NCOMPACT (NTRIPLETS_MAX + 1)  // good candidates that can enter the first NTRIPLETS_MAX pairs
+
+// Pipeline depths (clock cycles) of the builder, estimates at 2.777 ns
+#define TB_DEPTH_VALID 1      // good flags
+#define TB_PREFIX_LEVELS 3    // prefix sum levels per clock cycle
+#define TB_DEPTH_GATHER 2     // N:1 one-hot multiplexers by rank
+#define TB_DEPTH_SLOTS 2      // table read and NCOMPACT:1 multiplexers
+#define TB_DEPTH_ORDER 1      // pT ordering of the pair
+
+// Levels of the parallel prefix sum over n inputs
+constexpr int tb_prefix_levels(int n) { return n <= 1 ? 0 : 1 + tb_prefix_levels((n+1)/2); }
+
+// Latency of the builder for N input candidates [clock cycles]
+constexpr int triplet_builder_latency(int n)
+{
+    return TB_DEPTH_VALID + (tb_prefix_levels(n) + TB_PREFIX_LEVELS - 1) / TB_PREFIX_LEVELS
+         + TB_DEPTH_GATHER + TB_DEPTH_SLOTS + TB_DEPTH_ORDER;
+}
+
+// Rank pairs (a,b) of the output slots vs number of good candidates
+struct PairSlotTable {
+    uint8_t a[NCOMPACT+1][NTRIPLETS_MAX];
+    uint8_t b[NCOMPACT+1][NTRIPLETS_MAX];
+    uint8_t npairs[NCOMPACT+1];
+};
+
+constexpr PairSlotTable makePairSlotTable()
+{
+    PairSlotTable t{};
+    for (int n = 0; n <= NCOMPACT; ++n)
+    {
+        int k = 0;
+        for (int a = 0; a < n-1; ++a)
+            for (int b = a+1; b < n && k < NTRIPLETS_MAX; ++b, ++k)
+            {
+                t.a[n][k] = a;
+                t.b[n][k] = b;
+            }
+        t.npairs[n] = k;
+    }
+    return t;
+}
+
+static constexpr PairSlotTable PAIR_SLOTS = makePairSlotTable();
+
+// Build the first NTRIPLETS_MAX triplets (pivot, i, j), pT_i >= pT_j, from the good candidates
+template<int N>
+void build_triplets(const Puppi input[N], const bool masked[N], int pivot_idx, Triplet triplets[NTRIPLETS_MAX])
+{
+    #pragma HLS ARRAY_PARTITION variable=input complete
+    #pragma HLS ARRAY_PARTITION variable=masked complete
+    #pragma HLS ARRAY_PARTITION variable=triplets complete
+    #pragma HLS pipeline II=1
+
+    typedef w3p_uint<8> rank_t;
+    static_assert(N < 256, "rank_t too small");
+
+    // Good candidates
+    bool good[N];
+    #pragma HLS ARRAY_PARTITION variable=good complete
+    LOOP_TB_GOOD: for (int i = 0; i < N; i++)
+    {
+        #pragma HLS UNROLL
+        good[i] = !masked[i] && (i != pivot_idx);
+    }
+
+    // Inclusive prefix sum of the good flags (Hillis-Steele)
+    rank_t count[N];
+    #pragma HLS ARRAY_PARTITION variable=count complete
+    LOOP_TB_INIT: for (int i = 0; i < N; i++)
+    {
+        #pragma HLS UNROLL
+        count[i] = good[i] ? 1 : 0;
+    }
+    LOOP_TB_PREFIX: for (int d = 1; d < N; d *= 2)
+    {
+        #pragma HLS UNROLL
+        rank_t level[N];
+        #pragma HLS ARRAY_PARTITION variable=level complete
+        LOOP_TB_PREFIX_LEVEL: for (int i = 0; i < N; i++)
+        {
+            #pragma HLS UNROLL
+            level[i] = (i >= d) ? rank_t(count[i] + count[i-d]) : count[i];
+        }
+        LOOP_TB_PREFIX_COPY: for (int i = 0; i < N; i++)
+        {
+            #pragma HLS UNROLL
+            count[i] = level[i];
+        }
+    }
+    int ngood = count[N-1];
+    int n = (ngood < NCOMPACT) ? ngood : NCOMPACT;
+
+    // Gather the first NCOMPACT good candidates by rank
+    int sel[NCOMPACT];
+    #pragma HLS ARRAY_PARTITION variable=sel complete
+    LOOP_TB_GATHER: for (int r = 0; r < NCOMPACT; r++)
+    {
+        #pragma HLS UNROLL
+        int idx = 0;
+        LOOP_TB_GATHER_IN: for (int i = 0; i < N; i++)
+        {
+            #pragma HLS UNROLL
+            // good[i] with rank r (exclusive prefix sum = count[i]-1): at most one i
+            idx |= (good[i] && count[i] == r+1) ? i : 0;
+        }
+        sel[r] = idx;
+    }
+
+    // Fill the output slots
+    LOOP_TB_SLOTS: for (int k = 0; k < NTRIPLETS_MAX; k++)
+    {
+        #pragma HLS UNROLL
+        if (k < PAIR_SLOTS.npairs[n])
+        {
+            int i = sel[PAIR_SLOTS.a[n][k]];
+            int j = sel[PAIR_SLOTS.b[n][k]];
+            triplets[k] = (input[i].hwPt >= input[j].hwPt) ? Triplet(pivot_idx,i,j) : Triplet(pivot_idx,j,i);
+        }
+        else
+        {
+            triplets[k] = Triplet(0,0,0);
+        }
+    }
+}
+
+#endif
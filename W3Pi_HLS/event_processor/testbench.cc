@@ -1,26 +1,30 @@
 #include "src/event_processor.h"
+#include "../utils/dump_reader.h"
+#include "isolation_simd.h"
+#include "../utils/stage_stats.h"
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <bitset>
+#include <algorithm>
 
 int main(int argc, char **argv) {
 
-    // Variables to read data
-    uint64_t header, data[NPUPPI_MAX];
+    // Map and index input file
+    //DumpReader in("Puppi_SingleNu.dump");
+    //DumpReader in("Puppi_w3p_PU0.dump");
+    DumpReader in("Puppi_w3p_PU200.dump");
+    if (!in.good()) { printf("Cannot open Puppi_w3p_PU200.dump (run from the data directory)\n"); return 1; }
 
-    // Read input stream
-    //std::fstream in("Puppi_SingleNu.dump", std::ios::in | std::ios::binary);
-    //std::fstream in("Puppi_w3p_PU0.dump", std::ios::in | std::ios::binary);
-    std::fstream in("Puppi_w3p_PU200.dump", std::ios::in | std::ios::binary);
-
-    // Loop on input data in chunks
-    for (int itest = 0, ntest = 10; itest < ntest && in.good(); ++itest) {
+    // Loop on input events
+    for (int itest = 0, ntest = 10; itest < ntest && itest < in.size(); ++itest) {
 
        std::cout << "--------------------" << std::endl;
 
-        // Read header
-        in.read(reinterpret_cast<char *>(&header), sizeof(uint64_t));
+        // Get header and data of the event (no copy)
+        DumpEvent event = in.event(itest);
+        uint64_t header = event.header.word;
+        const uint64_t * data = event.data;
 
         // Read header quantities
         // bits 	size 	meaning
@@ -53,13 +57,10 @@ int main(int argc, char **argv) {
             std::cout << " - validH: " << std::bitset<64>(validH) << " : " << validH << std::endl;
         }
 
-        // Minimal assert on npuppi to guarantee correct reading of fstream
+        // Minimal assert on npuppi to guarantee correct reading of the file
         assert(npuppi <= NPUPPI_MAX);
         if (npuppi == 0) continue;
 
-        // Read actual data and store it in puppi array
-        in.read(reinterpret_cast<char *>(data), npuppi*sizeof(uint64_t));
-
         // Use only events with at least 3 puppi candidates
         if (npuppi < 3) continue; // FIXME: this should actually be moved to the firmwere...how??
 
@@ -115,6 +116,32 @@ int main(int argc, char **argv) {
         bool masked_triplets_cpp[NTRIPLETS_MAX];
         event_processor_ref(npuppi, puppi, pivot_cpp, triplets_cpp, masked_triplets_cpp);
 
+        // SORTED VARIANT: event_processor_sorted vs event_processor on the pT-sorted candidates
+        Puppi sorted[NPUPPI_MAX];
+        std::copy(puppi, puppi+NPUPPI_MAX, sorted);
+        std::stable_sort(sorted, sorted+npuppi, [](const Puppi & a, const Puppi & b) { return a.hwPt > b.hwPt; });
+        Puppi pivot_all, pivot_lead;
+        Triplet triplets_all[NTRIPLETS_MAX], triplets_lead[NTRIPLETS_MAX];
+        bool masked_triplets_all[NTRIPLETS_MAX], masked_triplets_lead[NTRIPLETS_MAX];
+        event_processor(sorted, pivot_all, triplets_all, masked_triplets_all);
+        event_processor_sorted(sorted, pivot_lead, triplets_lead, masked_triplets_lead);
+        // Same output expected if the candidates after the leading NLEAD are below the pT cut
+        bool ok_sorted = true;
+        if (npuppi <= NLEAD || sorted[NLEAD].hwPt <= 3)
+        {
+            // The pivot is only defined if a candidate passes the selections
+            bool masked_sorted[NPUPPI_MAX];
+            bool has_pivot = select_candidates_ref(npuppi, sorted, masked_sorted) >= 0;
+            ok_sorted = ( !has_pivot || pivot_all.pack() == pivot_lead.pack() ) &&
+                        std::equal(triplets_all, triplets_all+NTRIPLETS_MAX, triplets_lead) &&
+                        std::equal(masked_triplets_all, masked_triplets_all+NTRIPLETS_MAX, masked_triplets_lead);
+            if (!ok_sorted) printf("Mismatch between event_processor_sorted and event_processor\n");
+        }
+        else
+        {
+            printf("More than NLEAD = %d candidates above the pT cut, event_processor_sorted not compared\n", NLEAD);
+        }
+
         // Debug printout
         //std::cout << "---> Test Triplets HLS:" << std::endl;
         //for (unsigned int i = 0; i < NTRIPLETS_MAX; i++)
@@ -126,12 +153,39 @@ int main(int argc, char **argv) {
         //        std::cout << "     - triplet: " << triplets_cpp[i].idx0 << "-" << triplets_cpp[i].idx1 << "-" << triplets_cpp[i].idx2 << std::endl;
 
 
+        // ISOLATION: grid vs all-pairs, on all the candidates
+        bool nomask[NPUPPI_MAX] = {false};
+        Puppi::pt_t absiso_pairs[NPUPPI_MAX], absiso_grid[NPUPPI_MAX];
+        const dr2_t dr2_max = drToHwDr2(0.4), dr2_veto = drToHwDr2(0.1);
+        compute_isolation_ref(npuppi, puppi, nomask, absiso_pairs, dr2_max, dr2_veto);
+        compute_isolation_grid(npuppi, puppi, nomask, absiso_grid, dr2_max, dr2_veto);
+        // ISOLATION: SIMD kernels supported by this CPU vs all-pairs
+        PuppiEventSoA<NPUPPI_MAX> soa;
+        soa.unpack(data, npuppi);
+        bool ok_simd = true;
+        for (IsoKernel kernel : {IsoKernel::Scalar, IsoKernel::AVX2, IsoKernel::AVX512})
+        {
+            if (!iso_kernel_supported(kernel)) continue;
+            Puppi::pt_t absiso_simd[NPUPPI_MAX];
+            compute_isolation_simd(soa, nomask, absiso_simd, dr2_max, dr2_veto, kernel);
+            ok_simd = ok_simd && std::equal(absiso_pairs, absiso_pairs+npuppi, absiso_simd);
+            if (!ok_simd) printf("Isolation mismatch with %s kernel\n", iso_kernel_name(kernel));
+        }
+
+        // SoA: bulk unpack vs Puppi::unpack
+        bool ok_soa = true;
+        for (unsigned int i = 0; i < npuppi; ++i)
+            ok_soa = ok_soa && ( soa.get<Puppi>(i).pack() == puppi[i].pack() );
+        if (!ok_soa) printf("Mismatch between PuppiEventSoA and Puppi::unpack\n");
+
         // COMPARE
-        bool ok = true;
+        bool ok = ok_soa && ok_sorted;
+        // - Check isolation
+        ok = ok && ( std::equal(absiso_pairs, absiso_pairs+npuppi, absiso_grid) ) && ok_simd;
         // - Check Pivot
         ok = ok && ( pivot_hls.pack() == pivot_cpp.pack() );
         // - Check triplets
-        ok = ok && ( std::equal(std::begin(triplets_cpp), std::end(triplets_cpp), std::begin(triplets_cpp)) );
+        ok = ok && ( std::equal(std::begin(triplets_hls), std::end(triplets_hls), std::begin(triplets_cpp)) );
         // - Check masked triplets
         ok = ok && ( std::equal(std::begin(masked_triplets_hls), std::end(masked_triplets_hls), std::begin(masked_triplets_cpp)) );
         // Final assert/printout
@@ -150,5 +204,9 @@ int main(int argc, char **argv) {
             printf("Test %u passed\n", itest);
         }
     }
+#ifdef W3P_STAGE_STATS
+    // Per-stage counters and timing of the kernel C-simulation and of the reference
+    w3p_stats::print_stats();
+#endif
     return 0;
 }
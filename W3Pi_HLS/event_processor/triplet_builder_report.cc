@@ -0,0 +1,159 @@
+// Latency report of the triplet builder: serial loop (former LOOP_EP4) vs fixed-latency builder (src/triplet_builder.h)
+//
+// Usage:
+//   triplet_builder_report [-r nrandom] [file1.dump ...]
+//
+//  - serial loop: one clock cycle per visited (i,j) pair plus one per i, up to the
+//    NTRIPLETS_MAX-th good pair; the worst case (no good pair) visits all the N(N-1)/2 pairs
+//  - builder: fixed latency from the model of src/triplet_builder.h
+// The number of cycles of the serial loop is counted on the events of the dump files (default:
+// the bundled W3Pi dumps, run from the data directory), and the two builders are compared on
+// them and on nrandom random masks for N = NPUPPI_MAX (216) and N = 208 (streamer).
+#include "src/event_processor.h"
+#include "src/triplet_builder.h"
+#include "../utils/dump_reader.h"
+#include "../utils/puppi_soa.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// See replay_ref.cc: the pivot index of event_processor_ref may be -1
+#define NPUPPI_BUFFER (1 + 256)
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [-r nrandom] [file1.dump ...]\n", name);
+}
+
+// Serial loop of the former LOOP_EP4, returns the number of clock cycles
+template<int N>
+unsigned int build_triplets_serial(const Puppi input[N], const bool masked[N], int pivot_idx, Triplet triplets[NTRIPLETS_MAX])
+{
+    unsigned int cycles = 0;
+    for (unsigned int k = 0; k < NTRIPLETS_MAX; k++) triplets[k] = Triplet(0,0,0);
+    int ntriplets = 0;
+    for (int i = 0; i < N-1; i++)
+    {
+        cycles++;
+        for (int j = i+1; j < N; j++)
+        {
+            cycles++;
+            if (ntriplets == NTRIPLETS_MAX)
+                break;
+            if (i == pivot_idx || masked[i] || j == pivot_idx || masked[j])
+                continue;
+            triplets[ntriplets] = (input[i].hwPt >= input[j].hwPt) ? Triplet(pivot_idx,i,j) : Triplet(pivot_idx,j,i);
+            ntriplets++;
+        }
+    }
+    return cycles;
+}
+
+// Cycles statistics
+struct CycleStats {
+    unsigned int n = 0, min = ~0u, max = 0;
+    double sum = 0;
+    void fill(unsigned int c) { n++; sum += c; min = std::min(min, c); max = std::max(max, c); }
+    void print(const char * name) const
+    {
+        if (n) printf(" - %-28s: %6u events, cycles min %6u  mean %8.1f  max %6u\n", name, n, min, sum/n, max);
+    }
+};
+
+// Random masks with a good-candidate density in [0, 1], compare the two builders
+template<int N>
+bool check_random(unsigned int nrandom, std::mt19937 & rng, CycleStats & stats)
+{
+    std::uniform_real_distribution<float> uniform(0, 1);
+    std::uniform_int_distribution<int> pt(0, (1 << Puppi::pt_t::width) - 1);
+    std::uniform_int_distribution<int> pivot(-1, N-1);
+    bool ok = true;
+    for (unsigned int itest = 0; itest < nrandom; ++itest)
+    {
+        Puppi input[N];
+        bool masked[N];
+        // Dense, sparse and very sparse (< NCOMPACT good candidates) events
+        float density = std::pow(uniform(rng), 3);
+        for (int i = 0; i < N; ++i)
+        {
+            input[i].clear();
+            input[i].hwPt(Puppi::pt_t::width-1, 0) = pt(rng);
+            masked[i] = uniform(rng) > density;
+        }
+        int pivot_idx = pivot(rng);
+
+        Triplet serial[NTRIPLETS_MAX], parallel[NTRIPLETS_MAX];
+        stats.fill(build_triplets_serial<N>(input, masked, pivot_idx, serial));
+        build_triplets<N>(input, masked, pivot_idx, parallel);
+        ok = ok && std::equal(serial, serial + NTRIPLETS_MAX, parallel);
+    }
+    if (!ok) printf("Triplet mismatch on random masks with N = %d\n", N);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    unsigned int nrandom = 10000;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-r") && i+1 < argc) nrandom = atoi(argv[++i]);
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU0.dump", "Puppi_w3p_PU200.dump"};
+
+    // Serial loop on the dump files
+    CycleStats data;
+    bool ok_data = true;
+    for (const std::string & name : innames)
+    {
+        DumpReader in(name);
+        for (size_t ievt = 0; ievt < in.size(); ++ievt)
+        {
+            DumpEvent event = in.event(ievt);
+            unsigned int npuppi = event.npuppi();
+            if (npuppi == 0 || npuppi > NPUPPI_MAX) continue;
+
+            Puppi buffer[NPUPPI_BUFFER];
+            Puppi * puppi = buffer + 1;
+            PuppiEventSoA<NPUPPI_MAX> soa;
+            soa.unpack(event.data, npuppi);
+            soa.to_puppi(puppi, NPUPPI_MAX);
+
+            // Masks of the padding candidates as in the firmware (cleared: pT = 0)
+            bool masked[NPUPPI_MAX];
+            int pivot_idx = select_candidates_ref(npuppi, puppi, masked);
+            for (unsigned int i = npuppi; i < NPUPPI_MAX; ++i) masked[i] = true;
+
+            Triplet serial[NTRIPLETS_MAX], parallel[NTRIPLETS_MAX];
+            data.fill(build_triplets_serial<NPUPPI_MAX>(puppi, masked, pivot_idx, serial));
+            build_triplets<NPUPPI_MAX>(puppi, masked, pivot_idx, parallel);
+            ok_data = ok_data && std::equal(serial, serial + NTRIPLETS_MAX, parallel);
+        }
+    }
+
+    // Random masks
+    std::mt19937 rng(12345);
+    CycleStats random216, random208;
+    bool ok_random = check_random<NPUPPI_MAX>(nrandom, rng, random216) && check_random<208>(nrandom, rng, random208);
+
+    printf("Triplet builder, NTRIPLETS_MAX = %d\n", NTRIPLETS_MAX);
+    printf("Serial loop (former LOOP_EP4):\n");
+    data.print("dump files");
+    random216.print("random masks, N = 216");
+    random208.print("random masks, N = 208");
+    printf(" - %-28s: %6u cycles (N = 216), %u cycles (N = 208)\n", "worst case", (216-1) + 216*(216-1)/2, (208-1) + 208*(208-1)/2);
+    printf("Fixed-latency builder:\n");
+    printf(" - %-28s: %6d cycles (N = 216), %d cycles (N = 208), II = 1\n", "latency", triplet_builder_latency(216), triplet_builder_latency(208));
+    printf("Builder vs serial loop: dump files %s, random masks %s\n", ok_data ? "identical" : "MISMATCH", ok_random ? "identical" : "MISMATCH");
+
+    return (ok_data && ok_random) ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+// Check and throughput of the multi-link event builder (utils/event_builder.h)
+//
+// Usage:
+//   event_builder_report [-n nsynthetic] [-r readahead] [-k] [link_a.dump link_b.dump link_c.dump link_d.dump]
+//
+//  - the events of the link files (default: the bundled PU200 links, run from the data
+//    directory) are built with and without read-ahead, which must give the same events
+//  - nsynthetic events (default 200000) spread over orbits and bunch crossings are written
+//    in NLINKS temporary link files, with missing fragments, error bits and oversized
+//    fragments: the builder must find them all and align the other fragments
+//  - for both, the events/s and MB/s of the builder with and without read-ahead (-r sets the
+//    read-ahead depth, default 64); -k keeps the synthetic files
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+
+#include "src/data.h"
+#include "../utils/event_builder.h"
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [-n nsynthetic] [-r readahead] [-k] [link_a.dump link_b.dump link_c.dump link_d.dump]\n", name);
+}
+
+// Summary of a built event, to compare two runs of the builder
+struct BuiltEvent {
+    unsigned int run, orbit, bx;
+    uint32_t missing, error;
+    uint64_t headers[NLINKS];   // header word of each fragment, 0 if missing
+    bool operator==(const BuiltEvent & o) const
+    {
+        return run == o.run && orbit == o.orbit && bx == o.bx && missing == o.missing && error == o.error &&
+               std::equal(headers, headers + NLINKS, o.headers);
+    }
+};
+
+struct BuildResult {
+    std::vector<BuiltEvent> events;
+    EventBuilderStats<NLINKS> stats;
+    double seconds = 0;
+    size_t words = 0;
+};
+
+static BuildResult build(const std::vector<std::string> & names, unsigned int readahead)
+{
+    BuildResult r;
+    auto start = std::chrono::steady_clock::now();
+    EventBuilder<NLINKS> builder(names, NPUPPI_LINK, readahead);
+    if (!builder.good()) { printf("Cannot open the link files\n"); exit(1); }
+    LinkEvent<NLINKS> event;
+    while (builder.next(event))
+    {
+        BuiltEvent b{event.run, event.orbit, event.bx, event.missing, event.error, {}};
+        for (int l = 0; l < NLINKS; l++)
+        {
+            b.headers[l] = (event.missing >> l) & 1 ? 0 : event.link(l).header.word;
+            r.words += 1 + event.link(l).npuppi();
+        }
+        r.events.push_back(b);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    r.seconds = elapsed.count();
+    r.stats = builder.stats();
+    return r;
+}
+
+static void print(const char * what, const BuildResult & r)
+{
+    printf("  %-22s %8zu events, %8llu complete, %10.0f events/s, %8.1f MB/s\n", what, r.events.size(),
+           (unsigned long long) r.stats.complete, r.events.size() / r.seconds, r.words * sizeof(uint64_t) / r.seconds / 1e6);
+}
+
+static void print_links(const BuildResult & r)
+{
+    for (int l = 0; l < NLINKS; l++)
+        printf("  link %d: %8llu fragments, %6llu missing, %6llu errors, %6llu out of order\n", l,
+               (unsigned long long) r.stats.fragments[l], (unsigned long long) r.stats.missing[l],
+               (unsigned long long) r.stats.error[l], (unsigned long long) r.stats.unordered[l]);
+}
+
+// Same events, in the same order
+static bool same(const std::vector<BuiltEvent> & a, const std::vector<BuiltEvent> & b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+// Header word (see dump_reader.h)
+static uint64_t header(unsigned int run, unsigned int orbit, unsigned int bx, unsigned int npuppi, bool error)
+{
+    return (uint64_t(2) << 62) | (uint64_t(error) << 61) | (uint64_t(run & 0x1F) << 56) | (uint64_t(orbit) << 24) | (uint64_t(bx & 0xFFF) << 12) | (npuppi & 0xFF);
+}
+
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    unsigned int nsynthetic = 200000, readahead = 64;
+    bool keep = false;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-n") && i+1 < argc) nsynthetic = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-r") && i+1 < argc) readahead = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-k")) keep = true;
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU200_a.dump", "Puppi_w3p_PU200_b.dump", "Puppi_w3p_PU200_c.dump", "Puppi_w3p_PU200_d.dump"};
+    if (innames.size() != NLINKS || readahead == 0) { usage(argv[0]); return 1; }
+
+    // Link files
+    BuildResult sync = build(innames, 0), ahead = build(innames, readahead);
+    bool ok_files = same(sync.events, ahead.events);
+    printf("Link files (%s, ...):\n", innames[0].c_str());
+    print("no read-ahead", sync);
+    print("read-ahead", ahead);
+    print_links(ahead);
+
+    // Synthetic links: consecutive bunch crossings of consecutive orbits, each fragment is
+    // missing with probability 1%, has the error bit with probability 0.5%, or is oversized
+    // with probability 0.1%
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::uniform_int_distribution<int> npuppi(0, NPUPPI_LINK);
+    std::vector<uint64_t> words[NLINKS];
+    std::vector<BuiltEvent> truth;
+    unsigned int run = 3, orbit = 1000, bx = 0;
+    for (unsigned int ievt = 0; ievt < nsynthetic; ievt++)
+    {
+        BuiltEvent t{run, orbit, bx, 0, 0, {}};
+        for (int l = 0; l < NLINKS; l++)
+        {
+            double u = uniform(rng);
+            if (u < 0.01) { t.missing |= (1u << l); continue; }
+            bool error = (u < 0.015), oversized = (u >= 0.015 && u < 0.016);
+            unsigned int n = oversized ? NPUPPI_LINK + 1 : npuppi(rng);
+            if (error || oversized) t.error |= (1u << l);
+            t.headers[l] = header(run, orbit, bx, n, error);
+            words[l].push_back(t.headers[l]);
+            for (unsigned int i = 0; i < n; i++) words[l].push_back(rng());
+        }
+        if (t.missing == (1u << NLINKS) - 1) continue;
+        truth.push_back(t);
+        bx += 1 + (rng() % 3);
+        if (bx >= 3564) { bx = 0; orbit++; }
+    }
+    std::vector<std::string> synthnames;
+    for (int l = 0; l < NLINKS; l++)
+    {
+        char name[] = "/tmp/event_builder_XXXXXX";
+        int fd = mkstemp(name);
+        if (fd < 0 || write(fd, words[l].data(), words[l].size() * sizeof(uint64_t)) != ssize_t(words[l].size() * sizeof(uint64_t)))
+        {
+            printf("Cannot write the synthetic link files\n");
+            return 1;
+        }
+        close(fd);
+        synthnames.push_back(name);
+    }
+
+    BuildResult ssync = build(synthnames, 0), sahead = build(synthnames, readahead);
+    bool ok_synth = same(ssync.events, sahead.events) && same(ssync.events, truth);
+    printf("Synthetic links (%u bunch crossings, %zu events, %s):\n", nsynthetic, truth.size(), keep ? synthnames[0].c_str() : "removed");
+    print("no read-ahead", ssync);
+    print("read-ahead", sahead);
+    print_links(sahead);
+    if (!keep)
+        for (const std::string & name : synthnames) unlink(name.c_str());
+
+    printf("Read-ahead vs no read-ahead: link files %s, synthetic links %s\n", ok_files ? "identical" : "MISMATCH", ok_synth ? "identical and aligned" : "MISMATCH");
+    return (ok_files && ok_synth) ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+# Create a project
+open_project -reset "proj_w3p_chain"
+
+# Specify the name of the top function to synthetize
+set_top w3p_chain
+
+# Load source code for synthesis
+add_files src/w3p_chain.cc
+add_files src/w3p_streamer.cc
+add_files src/event_processor_stream.cc
+
+# Load source code for the testbench
+add_files -tb src/w3p_emulator.cc
+add_files -tb testbench_w3p_chain.cc
+add_files -tb ../data/Puppi_w3p_PU200_a.dump
+add_files -tb ../data/Puppi_w3p_PU200_b.dump
+add_files -tb ../data/Puppi_w3p_PU200_c.dump
+add_files -tb ../data/Puppi_w3p_PU200_d.dump
+
+# Create a solution (i.e. a hardware configuration for synthesis)
+open_solution "solution" -flow_target vitis
+
+# Set board:
+# Alveo U50 --> xcu50-fsvh2104-2-e
+# VUP9      --> xcvu9p-flga2577-2-e
+set_part {xcu50-fsvh2104-2-e}
+
+# Set clock
+# 200 MHz --> period 5      ns
+# 360 MHz --> period 2.7778 ns
+create_clock -period 5
+
+# Run
+#  - the co-simulation runs the NTEST events of the testbench back-to-back and reports
+#    the latency and the interval (II) per event of the whole chain
+csim_design -ldflags "-pthread"
+csynth_design
+cosim_design -ldflags "-pthread"
+exit
@@ -33,9 +33,9 @@ set_part {xcu50-fsvh2104-2-e}
 create_clock -period 5
 
 # Run
-csim_design
+csim_design -ldflags "-pthread"
 csynth_design
-#cosim_design
+#cosim_design -ldflags "-pthread"
 #export_design -flow syn -format xo
 #export_design -flow impl -format xo
 #export_design -flow impl -format ip_catalog -rtl vhdl
@@ -0,0 +1,203 @@
+// Timing and check of the SIMD sorting backend of the emulator (src/simd_sort.h)
+//
+// Usage:
+//   simd_sort_report [-r nrandom] [-n repeat] [link_a.dump link_b.dump link_c.dump link_d.dump]
+//
+//  - the emulator (w3p_emulator, SIMD backend) is compared with the former std::stable_sort
+//    emulator on the events of the dump files (default: the bundled PU200 links, run from the
+//    data directory), and both are timed over repeat passes
+//  - on nrandom random events with many candidates of the same pT, the AVX2 and scalar networks
+//    and the std::stable_sort emulator must give the same links, and the selected candidates
+//    must be the same as w3p_streamer, bit by bit
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "src/w3p_streamer.h"
+#include "src/w3p_emulator.h"
+#include "src/simd_sort.h"
+#include "../utils/dump_reader.h"
+#include "../utils/puppi_soa.h"
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [-r nrandom] [-n repeat] [link_a.dump link_b.dump link_c.dump link_d.dump]\n", name);
+}
+
+// Former emulator: mask, std::stable_sort of each link and of the concatenated links
+static void w3p_emulator_stable_sort(const std::vector<uint64_t> input_stream[NLINKS], std::vector<Puppi> output_stream[NLINKS], std::vector<Puppi> & output_sel)
+{
+    Puppi dummy;
+    dummy.clear();
+    auto puppiComparator = [](const Puppi & a, const Puppi & b) { return a.hwPt > b.hwPt; };
+    for (int nfifo = 0; nfifo < NLINKS; nfifo++)
+    {
+        PuppiEventSoA<NPUPPI_LINK> soa;
+        soa.unpack(input_stream[nfifo].data(), NPUPPI_LINK);
+        for (int i = 0; i < NPUPPI_LINK; ++i)
+        {
+            bool badEta = ( std::abs(soa.eta[i]) > Puppi::ETA_CUT );
+            bool badID  = ( soa.id[i] < 2 || soa.id[i] > 5 );
+            output_stream[nfifo].at(i) = (badEta || badID) ? dummy : soa.get<Puppi>(i);
+        }
+        std::stable_sort(output_stream[nfifo].begin(), output_stream[nfifo].end(), puppiComparator);
+    }
+    output_sel.clear();
+    for (int nfifo = 0; nfifo < NLINKS; nfifo++)
+        output_sel.insert(output_sel.end(), output_stream[nfifo].begin(), output_stream[nfifo].end());
+    std::stable_sort(output_sel.begin(), output_sel.end(), puppiComparator);
+    output_sel.resize(NPUPPI_SEL);
+}
+
+// Same candidates, bit by bit
+static bool same(const std::vector<Puppi> & a, const std::vector<Puppi> & b)
+{
+    if (a.size() != b.size()) return false;
+    for (unsigned int i = 0; i < a.size(); i++)
+        if (a[i].pack() != b[i].pack()) return false;
+    return true;
+}
+
+// Both emulators on one event
+struct EmulatorOutput {
+    std::vector<Puppi> links[NLINKS];
+    std::vector<Puppi> sel;
+    EmulatorOutput() { for (int i = 0; i < NLINKS; i++) links[i].resize(NPUPPI_LINK); }
+    bool operator==(const EmulatorOutput & o) const
+    {
+        for (int i = 0; i < NLINKS; i++)
+            if (!same(links[i], o.links[i])) return false;
+        return same(sel, o.sel);
+    }
+};
+
+// Random event: pT in a narrow range (many ties), a third of the candidates masked
+static void random_event(std::mt19937 & rng, std::vector<uint64_t> input[NLINKS])
+{
+    std::uniform_int_distribution<int> pt(0, 40), eta(-600, 600), phi(-720, 719), id(0, 7), z0(-512, 511);
+    for (int l = 0; l < NLINKS; l++)
+    {
+        input[l].assign(NPUPPI_LINK, 0);
+        for (int i = 0; i < NPUPPI_LINK; i++)
+        {
+            Puppi p;
+            p.hwPt(13,0) = pt(rng);
+            p.hwEta = eta(rng);
+            p.hwPhi = phi(rng);
+            p.hwID = id(rng);
+            p.hwZ0 = z0(rng);
+            input[l][i] = p.pack();
+        }
+    }
+}
+
+// AVX2 and scalar networks give the same keys
+static bool check_backends(const std::vector<uint64_t> input[NLINKS])
+{
+    simdSort::key_t simd[NPUPPI_LINK][NLINKS], scalar[NPUPPI_LINK][NLINKS];
+    for (int l = 0; l < NLINKS; l++)
+        for (int i = 0; i < NPUPPI_LINK; i++)
+            simd[i][l] = scalar[i][l] = simdSort::makeKey(input[l][i], i);
+    simdSort::sortLinks(simd, true);
+    simdSort::sortLinks(scalar, false);
+    return std::equal(&simd[0][0], &simd[0][0] + NPUPPI_LINK*NLINKS, &scalar[0][0]);
+}
+
+// Selected candidates of w3p_streamer
+static std::vector<Puppi> run_streamer(const std::vector<uint64_t> input[NLINKS])
+{
+    w3p_stream<uint64_t> inFifo[NLINKS];
+    w3p_stream<PuppiFrame> outFifo;
+    for (int l = 0; l < NLINKS; l++)
+        for (int i = 0; i < NPUPPI_LINK; i++)
+            inFifo[l] << input[l][i];
+    w3p_streamer(inFifo, outFifo);
+    std::vector<Puppi> sel(NPUPPI_SEL);
+    for (int i = 0; i < NPUPPI_SEL; i++)
+        sel[i] = outFifo.read().puppi;
+    return sel;
+}
+
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    unsigned int nrandom = 1000, repeat = 200;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-r") && i+1 < argc) nrandom = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i+1 < argc) repeat = atoi(argv[++i]);
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU200_a.dump", "Puppi_w3p_PU200_b.dump", "Puppi_w3p_PU200_c.dump", "Puppi_w3p_PU200_d.dump"};
+    if (innames.size() != NLINKS) { usage(argv[0]); return 1; }
+
+    // Events of the dump files
+    DumpReader inDumps[NLINKS];
+    size_t nevents = ~size_t(0);
+    for (int l = 0; l < NLINKS; l++)
+    {
+        inDumps[l].open(innames[l]);
+        nevents = std::min(nevents, inDumps[l].size());
+    }
+    std::vector< std::vector<uint64_t> > inputs(nevents * NLINKS);
+    for (size_t ievt = 0; ievt < nevents; ++ievt)
+        for (int l = 0; l < NLINKS; l++)
+        {
+            DumpEvent event = inDumps[l].event(ievt);
+            inputs[ievt*NLINKS + l].assign(NPUPPI_LINK, 0);
+            std::copy(event.begin(), event.end(), inputs[ievt*NLINKS + l].begin());
+        }
+
+    // Compare and time the two emulators
+    bool ok_data = true;
+    EmulatorOutput simd, ref;
+    for (size_t ievt = 0; ievt < nevents; ++ievt)
+    {
+        w3p_emulator(&inputs[ievt*NLINKS], simd.links, simd.sel);
+        w3p_emulator_stable_sort(&inputs[ievt*NLINKS], ref.links, ref.sel);
+        ok_data = ok_data && (simd == ref) && check_backends(&inputs[ievt*NLINKS]);
+    }
+    auto time_per_event = [&](void (*emulator)(const std::vector<uint64_t> *, std::vector<Puppi> *, std::vector<Puppi> &)) {
+        EmulatorOutput out;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int irep = 0; irep < repeat; ++irep)
+            for (size_t ievt = 0; ievt < nevents; ++ievt)
+                emulator(&inputs[ievt*NLINKS], out.links, out.sel);
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (repeat * nevents);
+    };
+    double t_ref = time_per_event(w3p_emulator_stable_sort);
+    double t_simd = time_per_event(w3p_emulator);
+
+    // Random events with ties
+    std::mt19937 rng(12345);
+    bool ok_random = true, ok_firmware = true;
+    for (unsigned int itest = 0; itest < nrandom; ++itest)
+    {
+        std::vector<uint64_t> input[NLINKS];
+        random_event(rng, input);
+        w3p_emulator(input, simd.links, simd.sel);
+        w3p_emulator_stable_sort(input, ref.links, ref.sel);
+        ok_random = ok_random && (simd == ref) && check_backends(input);
+        ok_firmware = ok_firmware && same(simd.sel, run_streamer(input));
+    }
+
+    printf("SIMD sorting backend: %d links of %d candidates, %d comparators (depth %d) per link, AVX2 %s\n",
+           NLINKS, NPUPPI_LINK, simdSort::LinkNetwork::ncomp, hybridBitonicSort::prunedCost<simdSort::LinkNetwork>().depth,
+           simdSort::hasAvx2() ? "used" : "not available (scalar network)");
+    printf("Emulator time per event (%zu events x %u): std::stable_sort %.2f us, SIMD %.2f us (x%.1f)\n",
+           nevents, repeat, t_ref, t_simd, t_ref / t_simd);
+    printf("SIMD vs std::stable_sort emulator and scalar network: dump files %s, %u random events %s\n",
+           ok_data ? "identical" : "MISMATCH", nrandom, ok_random ? "identical" : "MISMATCH");
+    printf("SIMD emulator vs w3p_streamer selected candidates: %u random events %s\n", nrandom, ok_firmware ? "identical" : "MISMATCH");
+
+    return (ok_data && ok_random && ok_firmware) ? 0 : 1;
+}
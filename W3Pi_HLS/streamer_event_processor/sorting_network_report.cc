@@ -0,0 +1,163 @@
+// Comparators and depth of the sorting networks of src/bitonic_hybrid.h
+//
+// Usage:
+//   sorting_network_report
+//
+//  - for each size, the compile-time cost (SortCost<N>) of the bitonic, hybrid (optimal networks
+//    up to 16 elements) and odd-even merge sorters, and the one picked by bestSorter
+//  - every sorter is checked in both directions: on all the 0/1 inputs up to 16 elements
+//    (0-1 principle), and on random inputs with ties above
+//  - for a few (N, K), the cost of the first K of N elements (TopKCost<N,K>): full sort, pruned
+//    best sorter and pruned bitonic selection network, with the comparators saved by topK;
+//    both pruned networks are checked in both directions as above
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "src/data.h"
+#include "src/bitonic_hybrid.h"
+
+using namespace hybridBitonicSort;
+
+// Sizes in the report: all up to 32, and the chunks of the streamer
+typedef std::integer_sequence<int, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+                              25, 26, 27, 28, 29, 30, 31, 32, NPUPPI_LINK, 64> ReportSizes;
+
+// Sort a copy of in with Sorter, compare with std::sort
+template<typename Sorter, int N, int dir>
+bool check_one(const int in[N])
+{
+    int a[N], ref[N];
+    std::copy(in, in+N, a);
+    std::copy(in, in+N, ref);
+    Sorter::run(a, 0);
+    if (dir) std::sort(ref, ref+N);
+    else     std::sort(ref, ref+N, std::greater<int>());
+    return std::equal(a, a+N, ref);
+}
+
+template<int N, int dir>
+bool check_dir(std::mt19937 & rng)
+{
+    bool ok = true;
+    int in[N];
+    auto check_all = [&]() {
+        return check_one<bitonicSorter<int, N, dir, false>, N, dir>(in) &&
+               check_one<bitonicSorter<int, N, dir, true>, N, dir>(in) &&
+               check_one<oddEvenMergeSorter<int, N, dir>, N, dir>(in) &&
+               check_one<bestSorter<int, N, dir>, N, dir>(in);
+    };
+    if (N <= 16)
+    {
+        for (unsigned int bits = 0; bits < (1u << N) && ok; ++bits)
+        {
+            for (int i = 0; i < N; ++i) in[i] = (bits >> i) & 1;
+            ok = check_all();
+        }
+    }
+    else
+    {
+        std::uniform_int_distribution<int> value(0, N/2);
+        for (int itest = 0; itest < 10000 && ok; ++itest)
+        {
+            for (int i = 0; i < N; ++i) in[i] = value(rng);
+            ok = check_all();
+        }
+    }
+    return ok;
+}
+
+template<int N>
+bool report_size(std::mt19937 & rng)
+{
+    typedef SortCost<N> C;
+    bool ok = check_dir<N, 0>(rng) && check_dir<N, 1>(rng);
+    printf("%4d | %6d %5d | %6d %5d | %6d %5d | %-14s %6d %5d | %s\n", N,
+           C::bitonic.comparators, C::bitonic.depth, C::hybrid.comparators, C::hybrid.depth,
+           C::oddEvenMerge.comparators, C::oddEvenMerge.depth,
+           sortAlgoName(C::bestAlgo), C::best.comparators, C::best.depth, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+template<int... Ns>
+bool report_all(std::integer_sequence<int, Ns...>, std::mt19937 & rng)
+{
+    bool ok = true;
+    for (bool r : {report_size<Ns>(rng)...}) ok = ok && r;
+    return ok;
+}
+
+// Top-K: first K of a copy of in with topK, compare with std::sort
+template<int N, int K, int dir, int algo>
+bool check_topk_one(const int in[N])
+{
+    int a[N], ref[N];
+    std::copy(in, in+N, a);
+    std::copy(in, in+N, ref);
+    topK<int, N, K, dir, algo>::run(a, 0);
+    if (dir) std::sort(ref, ref+N);
+    else     std::sort(ref, ref+N, std::greater<int>());
+    return std::equal(a, a+K, ref);
+}
+
+template<int N, int K, int dir>
+bool check_topk_dir(std::mt19937 & rng)
+{
+    bool ok = true;
+    int in[N];
+    auto check_all = [&]() {
+        return check_topk_one<N, K, dir, TOPK_SORT>(in) && check_topk_one<N, K, dir, TOPK_SELECT>(in);
+    };
+    if (N <= 16)
+    {
+        for (unsigned int bits = 0; bits < (1u << N) && ok; ++bits)
+        {
+            for (int i = 0; i < N; ++i) in[i] = (bits >> i) & 1;
+            ok = check_all();
+        }
+    }
+    else
+    {
+        std::uniform_int_distribution<int> value(0, N/2);
+        for (int itest = 0; itest < 10000 && ok; ++itest)
+        {
+            for (int i = 0; i < N; ++i) in[i] = value(rng);
+            ok = check_all();
+        }
+    }
+    return ok;
+}
+
+template<int N, int K>
+bool report_topk(std::mt19937 & rng)
+{
+    typedef TopKCost<N,K> C;
+    bool ok = check_topk_dir<N, K, 0>(rng) && check_topk_dir<N, K, 1>(rng);
+    printf("%4d %3d | %6d %5d | %6d %5d | %6d %5d | %-11s %6d %5d %5d %6d | %s\n", N, K,
+           C::sort.comparators, C::sort.depth, C::prunedSort.comparators, C::prunedSort.depth,
+           C::selection.comparators, C::selection.depth, topKAlgoName(C::bestAlgo),
+           C::best.comparators, C::best.depth, C::half, C::saved, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main() {
+
+    printf("%4s | %12s | %12s | %12s | %26s |\n", "N", "bitonic", "hybrid", "odd-even", "best");
+    printf("%4s | %6s %5s | %6s %5s | %6s %5s | %-14s %6s %5s | %s\n", "", "comp", "depth", "comp", "depth", "comp", "depth", "algo", "comp", "depth", "check");
+    std::mt19937 rng(12345);
+    bool ok = report_all(ReportSizes(), rng);
+    printf("%s\n", ok ? "All the sorters are correct" : "Some sorters are NOT correct");
+
+    // Top-K: streamer chunks and links (NMERGE = 8), and a few other sizes
+    printf("\n%4s %3s | %12s | %12s | %12s | %37s |\n", "N", "K", "full sort", "pruned sort", "selection", "topK");
+    printf("%4s %3s | %6s %5s | %6s %5s | %6s %5s | %-11s %6s %5s %5s %6s | %s\n", "", "", "comp", "depth", "comp", "depth",
+           "comp", "depth", "algo", "comp", "depth", "half", "saved", "check");
+    bool ok_topk = report_topk<8, 1>(rng) && report_topk<16, 4>(rng) && report_topk<16, 8>(rng) &&
+                   report_topk<NSORTING, NPUPPI_SEL>(rng) && report_topk<NSORTING, 8>(rng) && report_topk<32, 8>(rng) &&
+                   report_topk<NPUPPI_LINK, NPUPPI_SEL>(rng) && report_topk<NPUPPI_LINK, 8>(rng) && report_topk<64, 16>(rng) &&
+                   report_topk<NPUPPI_MAX, NPUPPI_SEL>(rng);
+    printf("%s\n", ok_topk ? "All the top-K networks are correct" : "Some top-K networks are NOT correct");
+    return (ok && ok_topk) ? 0 : 1;
+}
@@ -17,7 +17,7 @@
  */
 
 /*    T -> Type template specialization will be constructed against
- *    USE_HYBRID -> use low input template specialization optimized for depth. Impl. n=2,3,4,5,6,7,12,13 (TODO known<=16)
+ *    USE_HYBRID -> use low input template specialization optimized for depth. Impl. n=2..16 (best known networks)
  */   
 
 
@@ -35,6 +35,10 @@ namespace hybridBitonicSort {
         return PowerOf2LessEqualThan(n-1);
     }
 
+    static constexpr int PowerOf2GreaterEqualThan(int n){ //  to be called for n>0
+        return (n && !(n&(n-1))) ? n : PowerOf2GreaterEqualThan(n+1);
+    }
+
     template<typename T>
     static void myswap(T& a, T&b)
     {
@@ -91,6 +95,204 @@ namespace hybridBitonicSort {
     };
 
 
+    /*********************************************
+    *             bitonicTopMerger               *
+    *********************************************/
+
+    /* First N elements of the merge of two sequences of N elements, both sorted
+       in the direction dir (N must be a power of 2), i.e. the N largest for dir=0.
+       The half-cleaner keeps the first of in1[i] and in2[N-1-i], which gives the
+       result as a bitonic sequence, then sorted by bitonicMerger:
+       N comparisons plus a merger of N, instead of a merger of 2N.*/
+    template<typename T, int N, int dir>
+    struct bitonicTopMerger {
+        static_assert(N > 0 && !(N&(N-1)), "bitonicTopMerger: N must be a power of 2");
+        inline static void run(const T in1[], const T in2[], T out[]) {
+            #pragma HLS inline
+            #pragma HLS array_partition variable=in1 complete
+            #pragma HLS array_partition variable=in2 complete
+            #pragma HLS array_partition variable=out complete
+            for (int i=0; i<N; i++){
+                #pragma HLS unroll
+                if (dir) out[i] = (in2[N-1-i] < in1[i]) ? in2[N-1-i] : in1[i];
+                else     out[i] = (in1[i] < in2[N-1-i]) ? in2[N-1-i] : in1[i];
+            }
+            bitonicMerger<T,N,dir>::run(out, 0);
+        }
+    };
+
+
+    /*********************************************
+    *             Sorting networks               *
+    *********************************************/
+
+    /* A network is a list of comparators (i,j), i < j, applied in order:
+       after compAndSwap<T,dir>(a, i, j), a[i] comes before a[j] in the direction dir.*/
+    struct Comparator {
+        int i;
+        int j;
+    };
+
+    template<int NCOMP>
+    struct ComparatorTable {
+        Comparator c[NCOMP > 0 ? NCOMP : 1];
+        int ncomp;
+
+        // Append (i,j), only counted beyond NCOMP (NCOMP=0 to get the size of a table)
+        constexpr void add(int i, int j) {
+            if (ncomp < NCOMP) c[ncomp] = Comparator{i, j};
+            ncomp++;
+        }
+    };
+
+    /* Best known networks for n=3..16. From Knuth vol. III (n=3..6, 12, 13) and from the list
+       of B. Dobbelaere, https://bertdobbelaere.github.io/sorting_networks.html (n=7..11, 14..16):
+       optimal number of comparators for n<=11, 14 and 16, optimal depth for n<=11 and 15.
+       Each line is one layer of independent comparators.*/
+    static constexpr int OPTIMAL_NETWORK_MAX = 16;
+
+    static constexpr Comparator OPTIMAL_NETWORK_3[] = {
+        {0,1}, {1,2}, {0,1} };
+    static constexpr Comparator OPTIMAL_NETWORK_4[] = {
+        {0,1}, {2,3},
+        {0,2}, {1,3},
+        {1,2} };
+    static constexpr Comparator OPTIMAL_NETWORK_5[] = {
+        {0,1}, {2,3},
+        {1,3}, {2,4},
+        {0,2}, {1,4},
+        {1,2}, {3,4},
+        {2,3} };
+    static constexpr Comparator OPTIMAL_NETWORK_6[] = {
+        {0,3}, {1,2},
+        {0,1}, {2,3}, {4,5},
+        {0,3}, {1,4}, {2,5},
+        {0,1}, {2,4}, {3,5},
+        {1,2}, {3,4} };
+    static constexpr Comparator OPTIMAL_NETWORK_7[] = {
+        {0,6}, {2,3}, {4,5},
+        {0,2}, {1,4}, {3,6},
+        {0,1}, {2,5}, {3,4},
+        {1,2}, {4,6},
+        {2,3}, {4,5},
+        {1,2}, {3,4}, {5,6} };
+    static constexpr Comparator OPTIMAL_NETWORK_8[] = {
+        {0,2}, {1,3}, {4,6}, {5,7},
+        {0,4}, {1,5}, {2,6}, {3,7},
+        {0,1}, {2,3}, {4,5}, {6,7},
+        {2,4}, {3,5},
+        {1,4}, {3,6},
+        {1,2}, {3,4}, {5,6} };
+    static constexpr Comparator OPTIMAL_NETWORK_9[] = {
+        {0,3}, {1,7}, {2,5}, {4,8},
+        {0,7}, {2,4}, {3,8}, {5,6},
+        {0,2}, {1,3}, {4,5}, {7,8},
+        {1,4}, {3,6}, {5,7},
+        {0,1}, {2,4}, {3,5}, {6,8},
+        {2,3}, {4,5}, {6,7},
+        {1,2}, {3,4}, {5,6} };
+    static constexpr Comparator OPTIMAL_NETWORK_10[] = {
+        {0,8}, {1,9}, {2,7}, {3,5}, {4,6},
+        {0,2}, {1,4}, {5,8}, {7,9},
+        {0,3}, {2,4}, {5,7}, {6,9},
+        {0,1}, {3,6}, {8,9},
+        {1,5}, {2,3}, {4,8}, {6,7},
+        {1,2}, {3,5}, {4,6}, {7,8},
+        {2,3}, {4,5}, {6,7},
+        {3,4}, {5,6} };
+    static constexpr Comparator OPTIMAL_NETWORK_11[] = {
+        {0,9}, {1,6}, {2,4}, {3,7}, {5,8},
+        {0,1}, {3,5}, {4,10}, {6,9}, {7,8},
+        {1,3}, {2,5}, {4,7}, {8,10},
+        {0,4}, {1,2}, {3,7}, {5,9}, {6,8},
+        {0,1}, {2,6}, {4,5}, {7,8}, {9,10},
+        {2,4}, {3,6}, {5,7}, {8,9},
+        {1,2}, {3,4}, {5,6}, {7,8},
+        {2,3}, {4,5}, {6,7} };
+    static constexpr Comparator OPTIMAL_NETWORK_12[] = {
+        {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11},
+        {0,2}, {1,3}, {4,6}, {5,7}, {8,10}, {9,11},
+        {0,4}, {1,5}, {2,6}, {7,11}, {9,10},
+        {1,2}, {6,10}, {5,9}, {4,8}, {3,7},
+        {2,6}, {1,5}, {0,4}, {9,10}, {7,11}, {3,8},
+        {1,4}, {7,10}, {2,3}, {5,6}, {8,9},
+        {2,4}, {3,5}, {6,8}, {7,9},
+        {3,4}, {5,6}, {7,8} };
+    static constexpr Comparator OPTIMAL_NETWORK_13[] = {
+        {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11},
+        {0,2}, {1,3}, {4,6}, {5,7}, {8,10}, {9,11},
+        {0,4}, {1,5}, {2,6}, {3,7}, {8,12},
+        {0,8}, {1,9}, {2,10}, {3,11}, {4,12},
+        {1,2}, {3,12}, {7,11}, {4,8}, {5,10}, {6,9},
+        {1,4}, {2,8}, {6,12}, {3,10}, {5,9},
+        {2,4}, {3,5}, {6,8}, {7,9}, {10,12},
+        {3,6}, {5,8}, {7,10}, {9,12},
+        {3,4}, {5,6}, {7,8}, {9,10}, {11,12} };
+    static constexpr Comparator OPTIMAL_NETWORK_14[] = {
+        {0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11}, {12,13},
+        {0,2}, {1,3}, {4,8}, {5,9}, {10,12}, {11,13},
+        {0,4}, {1,2}, {3,7}, {5,8}, {6,10}, {9,13}, {11,12},
+        {0,6}, {1,5}, {3,9}, {4,10}, {7,13}, {8,12},
+        {2,10}, {3,11}, {4,6}, {7,9},
+        {1,3}, {2,8}, {5,11}, {6,7}, {10,12},
+        {1,4}, {2,6}, {3,5}, {7,11}, {8,10}, {9,12},
+        {2,4}, {3,6}, {5,8}, {7,10}, {9,11},
+        {3,4}, {5,6}, {7,8}, {9,10},
+        {6,7} };
+    static constexpr Comparator OPTIMAL_NETWORK_15[] = {
+        {0,6}, {1,10}, {2,14}, {3,9}, {4,12}, {5,13}, {7,11},
+        {0,7}, {2,5}, {3,4}, {6,11}, {8,10}, {9,12}, {13,14},
+        {1,13}, {2,3}, {4,6}, {5,9}, {7,8}, {10,14}, {11,12},
+        {0,3}, {1,4}, {5,7}, {6,13}, {8,9}, {10,11}, {12,14},
+        {0,2}, {1,5}, {3,8}, {4,6}, {7,10}, {9,11}, {12,13},
+        {0,1}, {2,5}, {3,10}, {4,8}, {6,7}, {9,12}, {11,13},
+        {1,2}, {3,4}, {5,6}, {7,9}, {8,10}, {11,12},
+        {3,5}, {4,6}, {7,8}, {9,10},
+        {2,3}, {4,5}, {6,7}, {8,9}, {10,11} };
+    static constexpr Comparator OPTIMAL_NETWORK_16[] = {
+        {0,13}, {1,12}, {2,15}, {3,14}, {4,8}, {5,6}, {7,11}, {9,10},
+        {0,5}, {1,7}, {2,9}, {3,4}, {6,13}, {8,14}, {10,15}, {11,12},
+        {0,1}, {2,3}, {4,5}, {6,8}, {7,9}, {10,11}, {12,13}, {14,15},
+        {0,2}, {1,3}, {4,10}, {5,11}, {6,7}, {8,9}, {12,14}, {13,15},
+        {1,2}, {3,12}, {4,6}, {5,7}, {8,10}, {9,11}, {13,14},
+        {1,4}, {2,6}, {5,8}, {7,10}, {9,13}, {11,14},
+        {2,4}, {3,6}, {9,12}, {11,13},
+        {3,5}, {6,8}, {7,9}, {10,12},
+        {3,4}, {5,6}, {7,8}, {9,10}, {11,12},
+        {6,7}, {8,9} };
+
+    template<int N>
+    struct OptimalNetwork {
+        static constexpr bool known = false;
+    };
+
+    #define HYBRID_OPTIMAL_NETWORK(N) \
+    template<> struct OptimalNetwork<N> { \
+        static constexpr bool known = true; \
+        static constexpr int ncomp = sizeof(OPTIMAL_NETWORK_##N) / sizeof(Comparator); \
+        static constexpr const Comparator * comparators() { return OPTIMAL_NETWORK_##N; } \
+    };
+    HYBRID_OPTIMAL_NETWORK(3)  HYBRID_OPTIMAL_NETWORK(4)  HYBRID_OPTIMAL_NETWORK(5)  HYBRID_OPTIMAL_NETWORK(6)
+    HYBRID_OPTIMAL_NETWORK(7)  HYBRID_OPTIMAL_NETWORK(8)  HYBRID_OPTIMAL_NETWORK(9)  HYBRID_OPTIMAL_NETWORK(10)
+    HYBRID_OPTIMAL_NETWORK(11) HYBRID_OPTIMAL_NETWORK(12) HYBRID_OPTIMAL_NETWORK(13) HYBRID_OPTIMAL_NETWORK(14)
+    HYBRID_OPTIMAL_NETWORK(15) HYBRID_OPTIMAL_NETWORK(16)
+    #undef HYBRID_OPTIMAL_NETWORK
+
+    /* Apply the comparators of the network Net (OptimalNetwork or OddEvenMergeNetwork)
+       to the elements starting at index position low*/
+    template<typename T, typename Net, int dir>
+    struct networkSorter {
+        inline static void run(T a[], int low) {
+            #pragma HLS inline
+            #pragma HLS array_partition variable=a complete
+            for (int k=0; k<Net::ncomp; k++){
+                #pragma HLS unroll
+                compAndSwap<T,dir>(a, low+Net::comparators()[k].i, low+Net::comparators()[k].j);
+            }
+        }
+    };
+
+
     /*********************************************
     *             bitonicSorter                  *
     *********************************************/
@@ -142,198 +344,383 @@ namespace hybridBitonicSort {
         }
     };
 
-    /******************* N=3 ********************/
-    template<typename T, int dir>
-    struct bitonicSorter<T, 3, dir, true> {
-        inline static void run(T a[], int low){
-            #pragma HLS inline
-            #pragma HLS array_partition variable=a complete
-            compAndSwap<T,dir>(a, low+0, low+1); 
-            compAndSwap<T,dir>(a, low+1, low+2); 
-            //---
-            compAndSwap<T,dir>(a, low+0, low+1); 
-        }
+    /******************* N=3..16 ********************/
+    template<typename T, int dir> struct bitonicSorter<T,  3, dir, true> : networkSorter<T, OptimalNetwork<3>,  dir> {};
+    template<typename T, int dir> struct bitonicSorter<T,  4, dir, true> : networkSorter<T, OptimalNetwork<4>,  dir> {};
+    template<typename T, int dir> struct bitonicSorter<T,  5, dir, true> : networkSorter<T, OptimalNetwork<5>,  dir> {};
+    template<typename T, int dir> struct bitonicSorter<T,  6, dir, true> : networkSorter<T, OptimalNetwork<6>,  dir> {};
+    template<typename T, int dir> struct bitonicSorter<T,  7, dir, true> : networkSorter<T, OptimalNetwork<7>,  dir> {};
+    template<typename T, int dir> struct bitonicSorter<T,  8, dir, true> : networkSorter<T, OptimalNetwork<8>,  dir> {};
+    template<typename T, int dir> struct bitonicSorter<T,  9, dir, true> : networkSorter<T, OptimalNetwork<9>,  dir> {};
+    template<typename T, int dir> struct bitonicSorter<T, 10, dir, true> : networkSorter<T, OptimalNetwork<10>, dir> {};
+    template<typename T, int dir> struct bitonicSorter<T, 11, dir, true> : networkSorter<T, OptimalNetwork<11>, dir> {};
+    template<typename T, int dir> struct bitonicSorter<T, 12, dir, true> : networkSorter<T, OptimalNetwork<12>, dir> {};
+    template<typename T, int dir> struct bitonicSorter<T, 13, dir, true> : networkSorter<T, OptimalNetwork<13>, dir> {};
+    template<typename T, int dir> struct bitonicSorter<T, 14, dir, true> : networkSorter<T, OptimalNetwork<14>, dir> {};
+    template<typename T, int dir> struct bitonicSorter<T, 15, dir, true> : networkSorter<T, OptimalNetwork<15>, dir> {};
+    template<typename T, int dir> struct bitonicSorter<T, 16, dir, true> : networkSorter<T, OptimalNetwork<16>, dir> {};
+
+
+    /*********************************************
+    *             oddEvenMergeSorter             *
+    *********************************************/
+
+    /* Batcher's odd-even merge sort for any N (iterative form): same comparators as the
+       network of the next power of 2, without the ones beyond N.
+       Same depth as bitonicSorter for a power of 2, with less comparators.*/
+    template<int NCOMP>
+    constexpr ComparatorTable<NCOMP> makeOddEvenMergeNetwork(int n) {
+        ComparatorTable<NCOMP> t{};
+        int k = 0;
+        for (int p = 1; p < n; p += p)
+            for (int q = p; q > 0; q /= 2)
+                for (int j = q % p; j + q < n; j += q + q)
+                    for (int i = 0; i < q && i + j + q < n; i++)
+                        if ((i + j) / (p + p) == (i + j + q) / (p + p)) {
+                            if (k < NCOMP) t.c[k] = Comparator{i + j, i + j + q};
+                            k++;
+                        }
+        t.ncomp = k;
+        return t;
+    }
+
+    template<int N>
+    struct OddEvenMergeNetwork {
+        static constexpr bool known = true;
+        static constexpr int ncomp = makeOddEvenMergeNetwork<0>(N).ncomp;
+        static constexpr ComparatorTable<ncomp> table = makeOddEvenMergeNetwork<ncomp>(N);
+        static constexpr const Comparator * comparators() { return table.c; }
     };
+    template<int N> constexpr int OddEvenMergeNetwork<N>::ncomp;
+    template<int N> constexpr ComparatorTable<OddEvenMergeNetwork<N>::ncomp> OddEvenMergeNetwork<N>::table;
 
-    /******************* N=4 ********************/
-    template<typename T, int dir>
-    struct bitonicSorter<T, 4, dir, true> {
-        inline static void run(T a[], int low){
-            #pragma HLS inline
-            #pragma HLS array_partition variable=a complete
-            compAndSwap<T,dir>(a, low+0, low+1); 
-            compAndSwap<T,dir>(a, low+2, low+3); 
-            //---
-            compAndSwap<T,dir>(a, low+0, low+2); 
-            compAndSwap<T,dir>(a, low+1, low+3); 
-            //---
-            compAndSwap<T,dir>(a, low+1, low+2); 
-        }
+    template<typename T, int N, int dir>
+    struct oddEvenMergeSorter : networkSorter<T, OddEvenMergeNetwork<N>, dir> {};
+
+
+    /*********************************************
+    *             Comparators and depth          *
+    *********************************************/
+
+    /* Number of comparators and depth (comparators on the longest path) of each sorter,
+       evaluated at compile time by replaying its comparators on the time of each wire,
+       e.g. static_assert(SortCost<26>::best.depth <= 14, "") */
+    struct NetworkCost {
+        int comparators;
+        int depth;
     };
 
-    /******************* N=5 ********************/
-    template<typename T, int dir>
-    struct bitonicSorter<T, 5, dir, true> {
-        inline static void run(T a[], int low){
-            #pragma HLS inline
-            #pragma HLS array_partition variable=a complete
-            compAndSwap<T,dir>(a, low+0, low+1); 
-            compAndSwap<T,dir>(a, low+2, low+3); 
-            //---
-            compAndSwap<T,dir>(a, low+1, low+3); 
-            compAndSwap<T,dir>(a, low+2, low+4); 
-            //---
-            compAndSwap<T,dir>(a, low+0, low+2); 
-            compAndSwap<T,dir>(a, low+1, low+4); 
-            //--
-            compAndSwap<T,dir>(a, low+1, low+2); 
-            compAndSwap<T,dir>(a, low+3, low+4); 
-            //--
-            compAndSwap<T,dir>(a, low+2, low+3); 
+    static constexpr int MAX_WIRES = 256;
+
+    struct WireTimes {
+        int t[MAX_WIRES];
+        int comparators;
+        int depth;
+
+        constexpr void add(int i, int j) {
+            int d = (t[i] > t[j] ? t[i] : t[j]) + 1;
+            t[i] = d;
+            t[j] = d;
+            comparators++;
+            if (d > depth) depth = d;
         }
+        constexpr void add(const Comparator c[], int ncomp, int low) {
+            for (int k = 0; k < ncomp; k++) add(low + c[k].i, low + c[k].j);
+        }
+        constexpr NetworkCost cost() const { return NetworkCost{comparators, depth}; }
     };
 
-    /******************* N=6 ********************/
-    template<typename T, int dir>
-    struct bitonicSorter<T, 6, dir, true> {
-        inline static void run(T a[], int low){
-            #pragma HLS inline
-            #pragma HLS array_partition variable=a complete
-            //---
-            compAndSwap<T,dir>(a, low+0, low+3); 
-            compAndSwap<T,dir>(a, low+1, low+2); 
-            //---
-            compAndSwap<T,dir>(a, low+0, low+1); 
-            compAndSwap<T,dir>(a, low+2, low+3); 
-            compAndSwap<T,dir>(a, low+4, low+5); 
-            //---
-            compAndSwap<T,dir>(a, low+0, low+3); 
-            compAndSwap<T,dir>(a, low+1, low+4); 
-            compAndSwap<T,dir>(a, low+2, low+5); 
-            //---
-            compAndSwap<T,dir>(a, low+0, low+1); 
-            compAndSwap<T,dir>(a, low+2, low+4); 
-            compAndSwap<T,dir>(a, low+3, low+5); 
-            //---
-            compAndSwap<T,dir>(a, low+1, low+2); 
-            compAndSwap<T,dir>(a, low+3, low+4); 
+    constexpr const Comparator * optimalNetwork(int n) {
+        return n ==  3 ? OPTIMAL_NETWORK_3  : n ==  4 ? OPTIMAL_NETWORK_4  : n ==  5 ? OPTIMAL_NETWORK_5  :
+               n ==  6 ? OPTIMAL_NETWORK_6  : n ==  7 ? OPTIMAL_NETWORK_7  : n ==  8 ? OPTIMAL_NETWORK_8  :
+               n ==  9 ? OPTIMAL_NETWORK_9  : n == 10 ? OPTIMAL_NETWORK_10 : n == 11 ? OPTIMAL_NETWORK_11 :
+               n == 12 ? OPTIMAL_NETWORK_12 : n == 13 ? OPTIMAL_NETWORK_13 : n == 14 ? OPTIMAL_NETWORK_14 :
+               n == 15 ? OPTIMAL_NETWORK_15 : OPTIMAL_NETWORK_16;
+    }
+
+    constexpr int optimalNetworkSize(int n) {
+        return n ==  3 ? OptimalNetwork<3>::ncomp  : n ==  4 ? OptimalNetwork<4>::ncomp  : n ==  5 ? OptimalNetwork<5>::ncomp  :
+               n ==  6 ? OptimalNetwork<6>::ncomp  : n ==  7 ? OptimalNetwork<7>::ncomp  : n ==  8 ? OptimalNetwork<8>::ncomp  :
+               n ==  9 ? OptimalNetwork<9>::ncomp  : n == 10 ? OptimalNetwork<10>::ncomp : n == 11 ? OptimalNetwork<11>::ncomp :
+               n == 12 ? OptimalNetwork<12>::ncomp : n == 13 ? OptimalNetwork<13>::ncomp : n == 14 ? OptimalNetwork<14>::ncomp :
+               n == 15 ? OptimalNetwork<15>::ncomp : OptimalNetwork<16>::ncomp;
+    }
+
+    // Same comparators as bitonicMerger<T,n,dir>::run(a, low)
+    constexpr void mergerWires(WireTimes & w, int low, int n) {
+        if (n > 1) {
+            int k = PowerOf2LessThan(n);
+            for (int i = low; i < low + k; i++)
+                if (i + k < low + n) w.add(i, i + k);
+            mergerWires(w, low, k);
+            mergerWires(w, low + k, n - k);
+        }
+    }
+
+    // Same comparators as bitonicSorter<T,n,dir,hybrid>::run(a, low)
+    constexpr void sorterWires(WireTimes & w, int low, int n, bool hybrid) {
+        if (n == 2) {
+            w.add(low, low + 1);
+        }
+        else if (hybrid && n >= 3 && n <= OPTIMAL_NETWORK_MAX) {
+            w.add(optimalNetwork(n), optimalNetworkSize(n), low);
         }
+        else if (n > 1) {
+            sorterWires(w, low, n/2, hybrid);
+            sorterWires(w, low + n/2, n - n/2, hybrid);
+            mergerWires(w, low, n);
+        }
+    }
+
+    constexpr NetworkCost bitonicCost(int n, bool hybrid) {
+        WireTimes w{};
+        sorterWires(w, 0, n, hybrid);
+        return w.cost();
+    }
+
+    template<typename Net>
+    constexpr NetworkCost networkCost() {
+        WireTimes w{};
+        w.add(Net::comparators(), Net::ncomp, 0);
+        return w.cost();
+    }
+
+    // Sorting algorithms, in order of preference for the same cost
+    enum SortAlgo { SORT_OPTIMAL = 0, SORT_HYBRID = 1, SORT_ODDEVEN = 2, SORT_BITONIC = 3 };
+
+    static constexpr const char * sortAlgoName(int algo) {
+        return algo == SORT_OPTIMAL ? "optimal" : algo == SORT_HYBRID ? "hybrid" : algo == SORT_ODDEVEN ? "odd-even merge" : "bitonic";
+    }
+
+    constexpr bool lessCost(NetworkCost a, NetworkCost b) {
+        return a.depth < b.depth || (a.depth == b.depth && a.comparators < b.comparators);
+    }
+
+    template<int N>
+    struct SortCost {
+        static constexpr NetworkCost bitonic = bitonicCost(N, false);
+        static constexpr NetworkCost hybrid = bitonicCost(N, true);
+        static_assert(N <= MAX_WIRES, "SortCost: too many wires");
+        static constexpr NetworkCost oddEvenMerge = networkCost<OddEvenMergeNetwork<N>>();
+        static constexpr bool optimalKnown = (N >= 3 && N <= OPTIMAL_NETWORK_MAX);
+        // Lowest depth, then lowest number of comparators (the optimal networks are the hybrid sorter up to 16)
+        static constexpr int bestAlgo = lessCost(oddEvenMerge, hybrid) && !lessCost(bitonic, oddEvenMerge) ? SORT_ODDEVEN :
+                                        lessCost(bitonic, hybrid) ? SORT_BITONIC :
+                                        optimalKnown ? SORT_OPTIMAL : SORT_HYBRID;
+        static constexpr NetworkCost best = bestAlgo == SORT_ODDEVEN ? oddEvenMerge : bestAlgo == SORT_BITONIC ? bitonic : hybrid;
     };
+    template<int N> constexpr NetworkCost SortCost<N>::bitonic;
+    template<int N> constexpr NetworkCost SortCost<N>::hybrid;
+    template<int N> constexpr NetworkCost SortCost<N>::oddEvenMerge;
+    template<int N> constexpr NetworkCost SortCost<N>::best;
 
-    /******************* N=12 ********************/
-    template<typename T, int dir>
-    struct bitonicSorter<T, 12, dir, true> {
-        inline static void run(T a[], int low){
-            #pragma HLS inline
-            #pragma HLS array_partition variable=a complete
-            for(int i=0;i<12;i+=2){
-                #pragma HLS unroll
-                compAndSwap<T,dir>(a, low+i, low+i+1); 
-            }
-            //---
-            for(int i=0;i<12;i+=4){
-                #pragma HLS unroll
-                compAndSwap<T,dir>(a, low+i+0, low+i+2); 
-                compAndSwap<T,dir>(a, low+i+1, low+i+3); 
+
+    /*********************************************
+    *             bestSorter                     *
+    *********************************************/
+
+    /* Sorter with the lowest depth for N elements, chosen at compile time
+       among the optimal/hybrid, odd-even merge and bitonic networks (see SortCost)*/
+    template<typename T, int N, int dir, int algo = SortCost<N>::bestAlgo>
+    struct bestSorter : bitonicSorter<T, N, dir, true> {};
+
+    template<typename T, int N, int dir>
+    struct bestSorter<T, N, dir, SORT_ODDEVEN> : oddEvenMergeSorter<T, N, dir> {};
+
+    template<typename T, int N, int dir>
+    struct bestSorter<T, N, dir, SORT_BITONIC> : bitonicSorter<T, N, dir, false> {};
+
+
+    /*********************************************
+    *             Top-K selection                *
+    *********************************************/
+
+    /* When only the first K outputs of a sorter are used (e.g. the leading candidates of a link),
+       the comparators that are not on a path to them are pruned at compile time: walking the
+       network backwards from the outputs 0..K-1, a comparator is kept if one of its outputs is
+       needed, and then both its inputs are needed. A comparator with a single needed output
+       is a half comparator (one multiplexer instead of two).
+       Two networks are pruned, and topK picks the one with the lowest depth (see TopKCost):
+        - TOPK_SORT: the best sorter of N elements (bestSorter), pruned
+        - TOPK_SELECT: bitonic selection network, the input is split in blocks of KP (K rounded
+          up to a power of 2), each block is sorted (hybrid sorter) and the blocks are merged two
+          by two keeping the first KP (half-cleaner and merger of KP, as bitonicTopMerger)
+       Comparators (i,j) may have i > j here: after compAndSwap<T,dir>(a, i, j), a[i] comes
+       first in the direction dir whatever the order of i and j.*/
+    enum TopKAlgo { TOPK_SORT = 0, TOPK_SELECT = 1 };
+
+    static constexpr const char * topKAlgoName(int algo) {
+        return algo == TOPK_SORT ? "pruned sort" : "selection";
+    }
+
+    // Outputs of a comparator that are needed
+    enum { KEEP_BOTH = 0, KEEP_FIRST = 1, KEEP_SECOND = 2 };
+
+    struct PrunedComparator {
+        int i;
+        int j;
+        int keep;
+    };
+
+    template<int NCOMP>
+    struct PrunedTable {
+        PrunedComparator c[NCOMP > 0 ? NCOMP : 1];
+        int ncomp;
+        int nhalf;
+    };
+
+    // Same comparators as bitonicMerger<T,n,dir>::run(a, low), reversed if rev (notDir)
+    template<typename Table>
+    constexpr void mergerComparators(Table & t, int low, int n, bool rev) {
+        if (n > 1) {
+            int k = PowerOf2LessThan(n);
+            for (int i = low; i < low + k; i++)
+                if (i + k < low + n) {
+                    if (rev) t.add(i + k, i);
+                    else     t.add(i, i + k);
+                }
+            mergerComparators(t, low, k, rev);
+            mergerComparators(t, low + k, n - k, rev);
+        }
+    }
+
+    // Same comparators as bitonicSorter<T,n,dir,hybrid>::run(a, low), reversed if rev (notDir)
+    template<typename Table>
+    constexpr void sorterComparators(Table & t, int low, int n, bool hybrid, bool rev) {
+        if (n == 2) {
+            if (rev) t.add(low + 1, low);
+            else     t.add(low, low + 1);
+        }
+        else if (hybrid && n >= 3 && n <= OPTIMAL_NETWORK_MAX) {
+            const Comparator * c = optimalNetwork(n);
+            for (int k = 0; k < optimalNetworkSize(n); k++) {
+                if (rev) t.add(low + c[k].j, low + c[k].i);
+                else     t.add(low + c[k].i, low + c[k].j);
             }
-            //---
-            compAndSwap<T,dir>(a, low+0, low+4); 
-            compAndSwap<T,dir>(a, low+1, low+5); 
-            compAndSwap<T,dir>(a, low+2, low+6); 
-            compAndSwap<T,dir>(a, low+7, low+11); 
-            compAndSwap<T,dir>(a, low+9, low+10); 
-            //---
-            compAndSwap<T,dir>(a, low+1, low+2); 
-            compAndSwap<T,dir>(a, low+6, low+10); 
-            compAndSwap<T,dir>(a, low+5, low+9); 
-            compAndSwap<T,dir>(a, low+4, low+8); 
-            compAndSwap<T,dir>(a, low+3, low+7); 
-            //---
-            compAndSwap<T,dir>(a, low+2, low+6); 
-            compAndSwap<T,dir>(a, low+1, low+5); 
-            compAndSwap<T,dir>(a, low+0, low+4); 
-            compAndSwap<T,dir>(a, low+9, low+10); 
-            compAndSwap<T,dir>(a, low+7, low+11); 
-            compAndSwap<T,dir>(a, low+3, low+8); 
-            //---
-            compAndSwap<T,dir>(a, low+1, low+4); 
-            compAndSwap<T,dir>(a, low+7, low+10); 
-            compAndSwap<T,dir>(a, low+2, low+3); 
-            compAndSwap<T,dir>(a, low+5, low+6); 
-            compAndSwap<T,dir>(a, low+8, low+9); 
-            //---
-            compAndSwap<T,dir>(a, low+2, low+4); 
-            compAndSwap<T,dir>(a, low+3, low+5); 
-            compAndSwap<T,dir>(a, low+6, low+8); 
-            compAndSwap<T,dir>(a, low+7, low+9); 
-            //---
-            compAndSwap<T,dir>(a, low+3, low+4); 
-            compAndSwap<T,dir>(a, low+5, low+6); 
-            compAndSwap<T,dir>(a, low+7, low+8); 
         }
+        else if (n > 1) {
+            sorterComparators(t, low, n/2, hybrid, !rev);
+            sorterComparators(t, low + n/2, n - n/2, hybrid, rev);
+            mergerComparators(t, low, n, rev);
+        }
+    }
+
+    // Comparators of the unpruned network: sorter algo (SortAlgo), or bitonic selection of k
+    template<int NCOMP>
+    constexpr ComparatorTable<NCOMP> makeTopKSource(int n, int k, int topk, int algo) {
+        ComparatorTable<NCOMP> t{};
+        if (topk == TOPK_SORT && algo == SORT_ODDEVEN) {
+            t = makeOddEvenMergeNetwork<NCOMP>(n);
+        }
+        else if (topk == TOPK_SORT) {
+            sorterComparators(t, 0, n, algo != SORT_BITONIC, false);
+        }
+        else {
+            int kp = PowerOf2GreaterEqualThan(k);
+            for (int b = 0; b < n; b += kp)
+                sorterComparators(t, b, (n - b < kp) ? n - b : kp, true, false);
+            // Merge block b+s into block b: half-cleaner then merger of the bitonic block b,
+            // the missing elements of a partial block are the last ones (never first)
+            for (int s = kp; s < n; s += s)
+                for (int b = 0; b + s < n; b += s + s) {
+                    for (int i = 0; i < kp; i++)
+                        if (b + s + kp - 1 - i < n) t.add(b + i, b + s + kp - 1 - i);
+                    mergerComparators(t, b, kp, false);
+                }
+        }
+        return t;
+    }
+
+    // Keep the comparators on a path to the first k outputs
+    template<int NCOMP, int NSRC>
+    constexpr PrunedTable<NCOMP> pruneNetwork(const ComparatorTable<NSRC> & src, int k) {
+        PrunedTable<NCOMP> t{};
+        bool needed[MAX_WIRES] = {};
+        int keep[NSRC > 0 ? NSRC : 1] = {};
+        for (int w = 0; w < k; w++) needed[w] = true;
+        for (int c = src.ncomp - 1; c >= 0; c--) {
+            int i = src.c[c].i, j = src.c[c].j;
+            keep[c] = (needed[i] && needed[j]) ? KEEP_BOTH : needed[i] ? KEEP_FIRST : needed[j] ? KEEP_SECOND : -1;
+            if (needed[i] || needed[j]) needed[i] = needed[j] = true;
+        }
+        for (int c = 0; c < src.ncomp; c++)
+            if (keep[c] >= 0) {
+                if (t.ncomp < NCOMP) t.c[t.ncomp] = PrunedComparator{src.c[c].i, src.c[c].j, keep[c]};
+                t.ncomp++;
+                if (keep[c] != KEEP_BOTH) t.nhalf++;
+            }
+        return t;
+    }
+
+    template<int N, int K, int topk>
+    struct TopKNetwork {
+        static_assert(K > 0 && K <= N, "TopKNetwork: K must be in [1,N]");
+        static_assert(N <= MAX_WIRES, "TopKNetwork: too many wires");
+        static constexpr int nsrc = makeTopKSource<0>(N, K, topk, SortCost<N>::bestAlgo).ncomp;
+        static constexpr ComparatorTable<nsrc> source = makeTopKSource<nsrc>(N, K, topk, SortCost<N>::bestAlgo);
+        static constexpr int ncomp = pruneNetwork<0>(source, K).ncomp;
+        static constexpr PrunedTable<ncomp> table = pruneNetwork<ncomp>(source, K);
+        static constexpr int nhalf = table.nhalf;
+        static constexpr const PrunedComparator * comparators() { return table.c; }
     };
+    template<int N, int K, int topk> constexpr int TopKNetwork<N,K,topk>::nsrc;
+    template<int N, int K, int topk> constexpr ComparatorTable<TopKNetwork<N,K,topk>::nsrc> TopKNetwork<N,K,topk>::source;
+    template<int N, int K, int topk> constexpr int TopKNetwork<N,K,topk>::ncomp;
+    template<int N, int K, int topk> constexpr PrunedTable<TopKNetwork<N,K,topk>::ncomp> TopKNetwork<N,K,topk>::table;
 
-    /******************* N=13 ********************/
+    template<typename Net>
+    constexpr NetworkCost prunedCost() {
+        WireTimes w{};
+        for (int k = 0; k < Net::ncomp; k++) w.add(Net::comparators()[k].i, Net::comparators()[k].j);
+        return w.cost();
+    }
+
+    /* Cost of the first K of N elements, e.g. static_assert(TopKCost<26,8>::saved > 0, "")
+       sort: full sort (bestSorter), saved: comparators saved by topK w.r.t. the full sort,
+       half: half comparators of topK*/
+    template<int N, int K>
+    struct TopKCost {
+        static constexpr NetworkCost sort = SortCost<N>::best;
+        static constexpr NetworkCost prunedSort = prunedCost<TopKNetwork<N,K,TOPK_SORT>>();
+        static constexpr NetworkCost selection = prunedCost<TopKNetwork<N,K,TOPK_SELECT>>();
+        static constexpr int bestAlgo = lessCost(selection, prunedSort) ? TOPK_SELECT : TOPK_SORT;
+        static constexpr NetworkCost best = bestAlgo == TOPK_SELECT ? selection : prunedSort;
+        static constexpr int half = bestAlgo == TOPK_SELECT ? TopKNetwork<N,K,TOPK_SELECT>::nhalf : TopKNetwork<N,K,TOPK_SORT>::nhalf;
+        static constexpr int saved = sort.comparators - best.comparators;
+    };
+    template<int N, int K> constexpr NetworkCost TopKCost<N,K>::sort;
+    template<int N, int K> constexpr NetworkCost TopKCost<N,K>::prunedSort;
+    template<int N, int K> constexpr NetworkCost TopKCost<N,K>::selection;
+    template<int N, int K> constexpr NetworkCost TopKCost<N,K>::best;
+
+    // compAndSwap with only the needed outputs (keep, constant once unrolled)
     template<typename T, int dir>
-    struct bitonicSorter<T, 13, dir, true> {
-        inline static void run(T a[], int low){
+    static void compAndKeep(T a[], int i, int j, int keep)
+    {
+        #pragma HLS inline
+        #pragma HLS array_partition variable=a complete
+        bool swap = dir ? (a[j] < a[i]) : (a[i] < a[j]);
+        if (keep == KEEP_BOTH) { if (swap) myswap(a[i],a[j]); }
+        else if (keep == KEEP_FIRST) { if (swap) a[i] = a[j]; }
+        else { if (swap) a[j] = a[i]; }
+    }
+
+    /* First K of the N elements starting at index position low, sorted in the direction dir,
+       in a[low..low+K). The other elements are left in an unspecified state.*/
+    template<typename T, int N, int K, int dir, int algo = TopKCost<N,K>::bestAlgo>
+    struct topK {
+        inline static void run(T a[], int low) {
             #pragma HLS inline
             #pragma HLS array_partition variable=a complete
-            for(int i=0;i+1<13;i+=2){
+            typedef TopKNetwork<N,K,algo> Net;
+            for (int k=0; k<Net::ncomp; k++){
                 #pragma HLS unroll
-                compAndSwap<T,dir>(a, low+i, low+i+1); 
+                compAndKeep<T,dir>(a, low+Net::comparators()[k].i, low+Net::comparators()[k].j, Net::comparators()[k].keep);
             }
-            //---
-            for(int i=0;i+3<13;i+=4){
-                #pragma HLS unroll
-                compAndSwap<T,dir>(a, low+i+0, low+i+2); 
-                compAndSwap<T,dir>(a, low+i+1, low+i+3); 
-            }
-            //---
-            compAndSwap<T,dir>(a, low+0, low+4); 
-            compAndSwap<T,dir>(a, low+1, low+5); 
-            compAndSwap<T,dir>(a, low+2, low+6); 
-            compAndSwap<T,dir>(a, low+3, low+7); 
-            compAndSwap<T,dir>(a, low+8, low+12); 
-            //---
-            compAndSwap<T,dir>(a, low+0, low+8); 
-            compAndSwap<T,dir>(a, low+1, low+9); 
-            compAndSwap<T,dir>(a, low+2, low+10); 
-            compAndSwap<T,dir>(a, low+3, low+11); 
-            compAndSwap<T,dir>(a, low+4, low+12); 
-            //---
-            compAndSwap<T,dir>(a, low+1, low+2); 
-            compAndSwap<T,dir>(a, low+3, low+12); 
-            compAndSwap<T,dir>(a, low+7, low+11); 
-            compAndSwap<T,dir>(a, low+4, low+8); 
-            compAndSwap<T,dir>(a, low+5, low+10); 
-            compAndSwap<T,dir>(a, low+6, low+9); 
-            //---
-            compAndSwap<T,dir>(a, low+1, low+4); 
-            compAndSwap<T,dir>(a, low+2, low+8); 
-            compAndSwap<T,dir>(a, low+6, low+12); 
-            compAndSwap<T,dir>(a, low+3, low+10); 
-            compAndSwap<T,dir>(a, low+5, low+9); 
-            //---
-            compAndSwap<T,dir>(a, low+2, low+4); 
-            compAndSwap<T,dir>(a, low+3, low+5); 
-            compAndSwap<T,dir>(a, low+6, low+8); 
-            compAndSwap<T,dir>(a, low+7, low+9); 
-            compAndSwap<T,dir>(a, low+10, low+12); 
-            //---
-            compAndSwap<T,dir>(a, low+3, low+6); 
-            compAndSwap<T,dir>(a, low+5, low+8); 
-            compAndSwap<T,dir>(a, low+7, low+10); 
-            compAndSwap<T,dir>(a, low+9, low+12); 
-            //---
-            compAndSwap<T,dir>(a, low+3, low+4); 
-            compAndSwap<T,dir>(a, low+5, low+6); 
-            compAndSwap<T,dir>(a, low+7, low+8); 
-            compAndSwap<T,dir>(a, low+9, low+10); 
-            compAndSwap<T,dir>(a, low+11, low+12); 
         }
     };
 
+
     // Just and interface
     template<int NIN,int NOUT,bool hybrid=false,int dir=0, typename T>
     void sort(T in[], T out[]) 
@@ -350,6 +737,22 @@ namespace hybridBitonicSort {
         }
     }
 
+    // Same interface, only the first NOUT are computed (topK)
+    template<int NIN,int NOUT,int dir=0, typename T>
+    void selectK(T in[], T out[])
+    {
+        #pragma HLS inline
+        #pragma HLS array_partition variable=in complete
+        #pragma HLS array_partition variable=out complete
+        #pragma HLS interface ap_none port=out
+
+        topK<T,NIN,NOUT,dir>::run(in,0);
+
+        for(int i=0;i<NOUT;++i){
+            out[i] = in[i];
+        }
+    }
+
 } // namespace
 
 #endif
@@ -1,9 +1,8 @@
 #ifndef DATA_H
 #define DATA_H
 
-#include "ap_int.h"
-#include "ap_fixed.h"
-#include "hls_stream.h"
+#include "../../utils/w3p_types.h"
+#include "../../utils/w3p_stream.h"
 #include "math.h"
 #include <cstdint>
 #include <fstream>
@@ -15,33 +14,34 @@
 #define NSORTING ( NPUPPI_LINK / NCHUNKS )  //  [26] : Number of Puppi per chunk
 #define NPUPPI_SEL 7                        //   [7] : Number of selected non-masked ordered candidates
 #define NTRIPLETS 8                         //   [8] : Number of triplets
+#define NMERGE 8                            //   [8] : Leading candidates of each link in the merge tree (NPUPPI_SEL rounded up to a power of 2)
 
-// Index type - should always be able to cover [0,NPUPPI_MAX] !
-typedef ap_uint<8> idx_t; // [0,255]
-
-// DeltaR type
-typedef ap_uint<24> dr2_t;
+// Depth of the streams between decoder, masker and sorter of each link (2: HLS default)
+#ifndef LINK_STREAM_DEPTH
+#define LINK_STREAM_DEPTH 2
+#endif
 
-// Cosine and Hyperbolic-Cosine types
-typedef ap_int<10> cos_t;
-typedef ap_uint<10> cosh_t;
+// Key-index sort in the streamer: sort the (pT, index) keys, then gather the candidates (see PuppiKey)
+#ifndef W3P_KEY_SORT
+#define W3P_KEY_SORT 1
+#endif
 
-#define COSCOSH_LSB 256
-#define COSCOSH_LUT_SIZE 1024
+// Index type - should always be able to cover [0,NPUPPI_MAX] !
+typedef w3p_uint<8> idx_t; // [0,255]
 
-// Invariant mass types
-typedef ap_ufixed<15,12,AP_RND,AP_SAT> mass_t; // [0, 4095] with LSB = 0.125 GeV
+// DeltaR type
+typedef w3p_uint<24> dr2_t;
 
 // Puppi class
 struct Puppi {
     // data types and constants
-    typedef ap_ufixed<14,12,AP_RND,AP_SAT> pt_t;
-    typedef ap_int<12> eta_t;
-    typedef ap_int<11> phi_t;
-    typedef ap_int<10> z0_t;
-    static constexpr int INT_PI = 360;
+    typedef w3p_ufixed<14,12,AP_RND,AP_SAT> pt_t;
+    typedef w3p_int<12> eta_t;
+    typedef w3p_int<11> phi_t;
+    typedef w3p_int<10> z0_t;
+    static constexpr int INT_PI = 720;
     static constexpr int INT_2PI = 2*INT_PI;
-    static constexpr float ETAPHI_LSB = M_PI/(2*INT_PI); // pi / 720 = 1/4 deg = 3.14159 / 720 = 0.0043633194
+    static constexpr float ETAPHI_LSB = M_PI/INT_PI; // pi / 720 = 1/4 deg = 3.14159 / 720 = 0.0043633194
     static constexpr float ETA_CUT = 2.4/ETAPHI_LSB;
     static constexpr float Z0_LSB = 0.5; // mm
     enum PID {H0=0, Gamma=1, HMinus=2, HPlus=3, EMinus=4, EPlus=5, MuMinus=6, MuPlus=7};
@@ -50,10 +50,29 @@ struct Puppi {
     pt_t hwPt;
     eta_t hwEta;
     phi_t hwPhi;
-    ap_uint<3> hwID;
+    w3p_uint<3> hwID;
     z0_t hwZ0;
 
     // pack and unpack
+#ifdef W3P_NATIVE_TYPES
+    // raw bits of the native types: shifts and masks, the signed fields are sign-extended
+    // by set_raw_bits (same layout as PuppiEventSoA::unpack)
+    uint64_t pack() const {
+        return   hwPt.raw_bits()
+             | (hwEta.raw_bits() << 14)
+             | (hwPhi.raw_bits() << 26)
+             | (hwID.raw_bits()  << 37)
+             | (hwZ0.raw_bits()  << 40);
+    }
+    Puppi & unpack(uint64_t packed) {
+        hwPt.set_raw_bits(packed & 0x3FFF);
+        hwEta.set_raw_bits((packed >> 14) & 0xFFF);
+        hwPhi.set_raw_bits((packed >> 26) & 0x7FF);
+        hwID.set_raw_bits((packed >> 37) & 0x7);
+        hwZ0.set_raw_bits((packed >> 40) & 0x3FF);
+        return *this;
+    }
+#else
     uint64_t pack() const {
         ap_uint<64> ret;
         ret(13,0)  = hwPt(13,0);
@@ -72,6 +91,7 @@ struct Puppi {
        hwZ0(9,0)   = packed(49,40);
        return *this;
     }
+#endif
 
     // clear candidate, i.e. fill with zeros
     void clear() {
@@ -127,4 +147,55 @@ struct Puppi {
     }
 };
 
+// Sort key of a candidate: pT, then index (lower index first for the same pT)
+// The keys are all different: sorting them gives a total order, the same as std::stable_sort
+// in decreasing pT of the candidates in index order. The sorting networks compare and move
+// 22-bit keys instead of whole candidates, which are gathered by index at the end.
+struct PuppiKey {
+    static constexpr int WIDTH = 14 + 8;
+    static constexpr int MAX_INDEX = 255;
+    w3p_uint<WIDTH> key;
+
+    void set(const Puppi & p, idx_t index) {
+        idx_t rindex = MAX_INDEX - index;
+        key(21,8) = p.hwPt(13,0);
+        key(7,0)  = rindex(7,0);
+    }
+    idx_t index() const {
+        idx_t rindex;
+        rindex(7,0) = key(7,0);
+        return MAX_INDEX - rindex;
+    }
+
+    // Overload "less" operator (strict: no ties)
+    bool operator < (const PuppiKey& a) const
+    {
+        return ( key < a.key );
+    }
+};
+
+// Puppi candidate with end-of-event flag, for the streams between kernels
+struct PuppiFrame {
+    Puppi puppi;
+    bool last; // last candidate of the event
+};
+
+// Triplet of selected candidates with end-of-event flag
+// Each event gives NTRIPLETS frames: the passing triplets first (valid), then empty ones
+struct TripletFrame {
+    Puppi puppi0; // pivot
+    Puppi puppi1; // pT(puppi1) >= pT(puppi2)
+    Puppi puppi2;
+    bool valid;
+    bool last;    // last triplet of the event
+
+    // Overload ostream operator
+    friend std::ostream& operator << (std::ostream& os, const TripletFrame& a)
+    {
+        if (a.valid) os << a.puppi0 << "-" << a.puppi1 << "-" << a.puppi2;
+        else os << "x";
+        return os;
+    }
+};
+
 #endif
@@ -0,0 +1,124 @@
+#include "event_processor_stream.h"
+#include "../../utils/triplet_mass.h"
+
+// Pairs (i,j), 0 < i < j < NPUPPI_SEL, of the non-pivot candidates
+static constexpr int NPAIRS = (NPUPPI_SEL-1)*(NPUPPI_SEL-2)/2;
+
+//---------------------------------------------------------
+// Read the candidates of one event (at most NPUPPI_SEL, up to the frame flagged as last)
+void event_reader (w3p_stream<PuppiFrame> &inFifo, Puppi selPuppi[NPUPPI_SEL])
+{
+    #pragma HLS array_partition variable=selPuppi complete
+
+    bool last = false;
+    LOOP_EVENT_READER: for (int i = 0; i < NPUPPI_SEL; i++)
+    {
+        #pragma HLS pipeline
+        if (!last)
+        {
+            PuppiFrame frame = inFifo.read();
+            selPuppi[i] = frame.puppi;
+            last = frame.last;
+        }
+        else
+        {
+            selPuppi[i].clear();
+        }
+    }
+
+    // Resynchronize on the end of the event if it is longer than NPUPPI_SEL
+    LOOP_EVENT_DRAIN: while (!last)
+    {
+        #pragma HLS pipeline
+        last = inFifo.read().last;
+    }
+}
+
+//---------------------------------------------------------
+// Build and filter all the triplets of the pivot (candidate 0) with pairs of the other candidates,
+// and keep the first NTRIPLETS passing ones
+void build_triplets (const Puppi selPuppi[NPUPPI_SEL], TripletFrame triplets[NTRIPLETS])
+{
+    #pragma HLS array_partition variable=selPuppi complete
+    #pragma HLS array_partition variable=triplets complete
+    #pragma HLS pipeline
+
+    // Seed selection (masker already applied ID and eta selections)
+    bool masked[NPUPPI_SEL];
+    #pragma HLS array_partition variable=masked complete
+    LOOP_BT_MASK: for (int i = 0; i < NPUPPI_SEL; i++)
+    {
+        #pragma HLS unroll
+        masked[i] = (selPuppi[i].hwPt <= 3);
+    }
+
+    // Evaluate all the pairs in parallel
+    idx_t pairIdx1[NPAIRS], pairIdx2[NPAIRS];
+    bool pass[NPAIRS];
+    #pragma HLS array_partition variable=pairIdx1 complete
+    #pragma HLS array_partition variable=pairIdx2 complete
+    #pragma HLS array_partition variable=pass complete
+    int ipair = 0;
+    LOOP_BT_PAIRS1: for (int i = 1; i < NPUPPI_SEL-1; i++)
+    {
+        #pragma HLS unroll
+        LOOP_BT_PAIRS2: for (int j = i+1; j < NPUPPI_SEL; j++)
+        {
+            #pragma HLS unroll
+            // Input is pT-sorted: pT_i >= pT_j
+            pairIdx1[ipair] = i;
+            pairIdx2[ipair] = j;
+            pass[ipair] = !masked[0] && !masked[i] && !masked[j] &&
+                          triplet_selection(selPuppi[0], selPuppi[i], selPuppi[j]);
+            ipair++;
+        }
+    }
+
+    // Compact the passing triplets in pair order
+    LOOP_BT_CLEAR: for (int k = 0; k < NTRIPLETS; k++)
+    {
+        #pragma HLS unroll
+        triplets[k].puppi0 = selPuppi[0];
+        triplets[k].puppi1.clear();
+        triplets[k].puppi2.clear();
+        triplets[k].valid = false;
+        triplets[k].last = (k == NTRIPLETS-1);
+    }
+    int ntriplets = 0;
+    LOOP_BT_COMPACT: for (int p = 0; p < NPAIRS; p++)
+    {
+        #pragma HLS unroll
+        if (pass[p] && ntriplets < NTRIPLETS)
+        {
+            triplets[ntriplets].puppi1 = selPuppi[pairIdx1[p]];
+            triplets[ntriplets].puppi2 = selPuppi[pairIdx2[p]];
+            triplets[ntriplets].valid = true;
+            ntriplets++;
+        }
+    }
+}
+
+//---------------------------------------------------------
+// Write the NTRIPLETS frames of the event
+void triplet_writer (const TripletFrame triplets[NTRIPLETS], w3p_stream<TripletFrame> &outFifo)
+{
+    LOOP_TRIPLET_WRITER: for (int k = 0; k < NTRIPLETS; k++)
+    {
+        #pragma HLS pipeline
+        outFifo << triplets[k];
+    }
+}
+
+//---------------------------------------------------------
+// Top function
+void event_processor_stream (w3p_stream<PuppiFrame> &inFifo, w3p_stream<TripletFrame> &outFifo)
+{
+    #pragma HLS DATAFLOW
+
+    Puppi selPuppi[NPUPPI_SEL];
+    TripletFrame triplets[NTRIPLETS];
+
+    event_reader(inFifo, selPuppi);
+    build_triplets(selPuppi, triplets);
+    triplet_writer(triplets, outFifo);
+}
@@ -0,0 +1,18 @@
+#ifndef EVENT_PROCESSOR_STREAM_H
+#define EVENT_PROCESSOR_STREAM_H
+
+#include "data.h"
+
+// --------------------
+// ----- FIRMWARE -----
+// --------------------
+// Stream variant of event_processor, consuming the NPUPPI_SEL pT-sorted candidates of w3p_streamer:
+//  - the pivot is the first (highest pT) candidate
+//  - triplets are built with all the pairs of the other candidates, and filtered on
+//    charge, pT and mass as in filter_triplets
+//  - NTRIPLETS frames per event are written, the passing triplets first
+// No isolation is computed: the neutral and out-of-acceptance candidates needed for it are
+// already dropped by the streamer masker.
+void event_processor_stream(w3p_stream<PuppiFrame> & input, w3p_stream<TripletFrame> & output);
+
+#endif
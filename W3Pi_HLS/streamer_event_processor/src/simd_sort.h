@@ -0,0 +1,136 @@
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+#include "data.h"
+#include "bitonic_hybrid.h"
+#include "../../utils/puppi_soa.h"
+#include <cstdint>
+
+/**************************************************
+ * SIMD backend of the sorting networks of bitonic_hybrid.h, for the C++ emulators
+ *
+ * Each candidate is a 64-bit key, larger for the candidates that come first:
+ *
+ * bits     field
+ * 57-44    pt      raw pt_t bits
+ * 43-36    MAX_INDEX - index (as PuppiKey: lower index first for the same pT)
+ * 35-0     eta, phi, id, z0 (bits 49-14 of the packed word)
+ *
+ * The keys are all different, so the order is total: the same as the key-index sort of
+ * w3p_streamer and as std::stable_sort in decreasing pT, ties included. The candidate is
+ * carried by the key, so there is nothing to gather after the sort.
+ * The keys of the NLINKS links are sorted at once, one link per 64-bit lane (one AVX2
+ * register per position): each comparator of the network is a compare and two blends.
+ * Without AVX2, the same network is applied lane by lane.
+ **************************************************/
+
+namespace simdSort {
+
+    typedef uint64_t key_t;
+
+    static constexpr int PAYLOAD_BITS = 36, INDEX_LOW = 36, PT_LOW = 44;
+    static constexpr key_t PAYLOAD_MASK = (key_t(1) << PAYLOAD_BITS) - 1;
+    static_assert(NLINKS == 4, "simdSort: one link per 64-bit lane of an AVX2 register");
+
+    // Full sort of a link: best sorter of NPUPPI_LINK (nothing pruned with K = N)
+    typedef hybridBitonicSort::TopKNetwork<NPUPPI_LINK, NPUPPI_LINK, hybridBitonicSort::TOPK_SORT> LinkNetwork;
+
+    // Key of the packed candidate w at index i, and of a masked (cleared) candidate
+    inline key_t makeKey(uint64_t w, unsigned int i)
+    {
+        return ((w & 0x3FFF) << PT_LOW) | (key_t(PuppiKey::MAX_INDEX - i) << INDEX_LOW) | ((w >> 14) & PAYLOAD_MASK);
+    }
+    inline key_t maskedKey(unsigned int i) { return key_t(PuppiKey::MAX_INDEX - i) << INDEX_LOW; }
+
+    // Same key with another index
+    inline key_t reindex(key_t k, unsigned int i)
+    {
+        return (k & ~(key_t(0xFF) << INDEX_LOW)) | (key_t(PuppiKey::MAX_INDEX - i) << INDEX_LOW);
+    }
+
+    inline Puppi toPuppi(key_t k)
+    {
+        Puppi p;
+        p.unpack(((k >> PT_LOW) & 0x3FFF) | ((k & PAYLOAD_MASK) << 14));
+        return p;
+    }
+
+    // Scalar network, lane by lane
+    template<typename Net, int N>
+    inline void sortScalar(key_t keys[N][NLINKS])
+    {
+        for (int l = 0; l < NLINKS; l++)
+            for (int k = 0; k < Net::ncomp; k++)
+            {
+                const hybridBitonicSort::PrunedComparator & c = Net::comparators()[k];
+                key_t a = keys[c.i][l], b = keys[c.j][l];
+                if (c.keep != hybridBitonicSort::KEEP_SECOND) keys[c.i][l] = a < b ? b : a;
+                if (c.keep != hybridBitonicSort::KEEP_FIRST)  keys[c.j][l] = a < b ? a : b;
+            }
+    }
+
+#if PUPPI_SOA_X86
+    // AVX2 network, all the lanes at once (the keys are below 2^63: signed compare)
+    template<typename Net, int N>
+    __attribute__((target("avx2")))
+    inline void sortAvx2(key_t keys[N][NLINKS])
+    {
+        __m256i a[N];
+        for (int i = 0; i < N; i++)
+            a[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys[i]));
+        for (int k = 0; k < Net::ncomp; k++)
+        {
+            const hybridBitonicSort::PrunedComparator & c = Net::comparators()[k];
+            __m256i swap = _mm256_cmpgt_epi64(a[c.j], a[c.i]);
+            __m256i first = _mm256_blendv_epi8(a[c.i], a[c.j], swap);
+            __m256i second = _mm256_blendv_epi8(a[c.j], a[c.i], swap);
+            if (c.keep != hybridBitonicSort::KEEP_SECOND) a[c.i] = first;
+            if (c.keep != hybridBitonicSort::KEEP_FIRST)  a[c.j] = second;
+        }
+        for (int i = 0; i < N; i++)
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(keys[i]), a[i]);
+    }
+#endif
+
+    // AVX2 network available at run time
+    inline bool hasAvx2()
+    {
+#if PUPPI_SOA_X86
+        return puppi_soa::has_avx2();
+#else
+        return false;
+#endif
+    }
+
+    // Sort the keys of each link (keys[i][link]) in decreasing order
+    inline void sortLinks(key_t keys[NPUPPI_LINK][NLINKS], bool simd = true)
+    {
+#if PUPPI_SOA_X86
+        if (simd && hasAvx2())
+        {
+            sortAvx2<LinkNetwork, NPUPPI_LINK>(keys);
+            return;
+        }
+#endif
+        sortScalar<LinkNetwork, NPUPPI_LINK>(keys);
+    }
+
+    // Global top NPUPPI_SEL of the sorted links: same merge tree and keys as the merger of w3p_streamer
+    inline void mergeLinks(const key_t keys[NPUPPI_LINK][NLINKS], key_t selected[NPUPPI_SEL])
+    {
+        key_t linkKeys[NLINKS][NMERGE];
+        for (int l = 0; l < NLINKS; l++)
+            for (int r = 0; r < NMERGE; r++)
+                linkKeys[l][r] = reindex(keys[r][l], l*NMERGE + r);
+
+        key_t merged01[NMERGE], merged23[NMERGE], merged[NMERGE];
+        hybridBitonicSort::bitonicTopMerger<key_t, NMERGE, 0>::run(linkKeys[0], linkKeys[1], merged01);
+        hybridBitonicSort::bitonicTopMerger<key_t, NMERGE, 0>::run(linkKeys[2], linkKeys[3], merged23);
+        hybridBitonicSort::bitonicTopMerger<key_t, NMERGE, 0>::run(merged01, merged23, merged);
+        for (int i = 0; i < NPUPPI_SEL; i++)
+            selected[i] = merged[i];
+    }
+
+} // namespace
+
+#endif
@@ -0,0 +1,29 @@
+#include "w3p_chain.h"
+#include "w3p_streamer.h"
+#include "event_processor_stream.h"
+
+//---------------------------------------------------------
+// Top function
+// Events are framed on the internal stream (last flag), so with ap_ctrl_chain consecutive
+// calls overlap and back-to-back events flow through both kernels without array handoff.
+void w3p_chain (w3p_stream<uint64_t> inFifo[NLINKS], w3p_stream<TripletFrame> &outFifo)
+{
+    #pragma HLS interface ap_ctrl_chain port=return
+    #pragma HLS DATAFLOW
+
+    // Selected candidates, one event = NPUPPI_SEL frames
+    w3p_stream<PuppiFrame> selected_stream;
+    #pragma HLS stream variable=selected_stream depth=2*NPUPPI_SEL
+
+#ifdef W3P_THREADED_DATAFLOW
+    // C-simulation: both kernels run at the same time on the bounded stream (see w3p_stream.h)
+    selected_stream.configure("w3p_chain.selected_stream", 2*NPUPPI_SEL);
+    w3p_dataflow::Region region;
+    region.spawn([&]() { w3p_streamer(inFifo, selected_stream); });
+    region.spawn([&]() { event_processor_stream(selected_stream, outFifo); });
+    region.join();
+#else
+    w3p_streamer(inFifo, selected_stream);
+    event_processor_stream(selected_stream, outFifo);
+#endif
+}
@@ -0,0 +1,12 @@
+#ifndef W3P_CHAIN_H
+#define W3P_CHAIN_H
+
+#include "data.h"
+
+// --------------------
+// ----- FIRMWARE -----
+// --------------------
+// w3p_streamer feeding event_processor_stream in a single dataflow region
+void w3p_chain( w3p_stream<uint64_t> input[NLINKS], w3p_stream<TripletFrame> & output);
+
+#endif
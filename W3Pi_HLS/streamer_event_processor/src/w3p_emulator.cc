@@ -1,49 +1,43 @@
 #include "w3p_emulator.h"
+#include "../../utils/puppi_soa.h"
+#include "../../utils/triplet_mass.h"
+#include "simd_sort.h"
+#include "../../utils/stage_stats.h"
 #include <algorithm>
 
 #define DEBUG 0
 #define DEEP_DEBUG 0
 
 // ------------------------------------------------------------------
-bool puppiComparator (Puppi a, Puppi b)
+void w3p_emulator(const std::vector<uint64_t> input_stream[NLINKS], std::vector<Puppi> output_stream[NLINKS], std::vector<Puppi> & output_sel)
 {
-    return (a.hwPt > b.hwPt);
-}
 
-// ------------------------------------------------------------------
-void w3p_emulator(const std::vector<uint64_t> input_stream[NLINKS], std::vector<Puppi> output_stream[NLINKS])
-{
+    W3P_STATS_CLOCK(clock);
+    W3P_STATS_ONLY(unsigned int nunmasked = 0);
+
+    // Keys of the masked candidates (see simd_sort.h), one lane per link
+    simdSort::key_t keys[NPUPPI_LINK][NLINKS];
 
     for (int nfifo = 0; nfifo < NLINKS; nfifo++)
     {
-        // Unpack and mask
+        // Bulk unpack of the link into arrays of raw integers
+        PuppiEventSoA<NPUPPI_LINK> soa;
+        soa.unpack(input_stream[nfifo].data(), NPUPPI_LINK);
+
+        // Mask
         for (int i = 0; i < NPUPPI_LINK; ++i)
         {
-            // Unpack data into puppi candidates
-            Puppi unpackedPuppi;
-            unpackedPuppi.unpack(input_stream[nfifo][i]);
-
-            // Dummy puppi candidate
-            Puppi dummy;
-            dummy.clear();
-
             // Apply selections
-            bool badEta = ( std::abs(unpackedPuppi.hwEta) > Puppi::ETA_CUT );
-            bool badID  = ( unpackedPuppi.hwID < 2 || unpackedPuppi.hwID > 5 );
+            bool badEta = ( std::abs(soa.eta[i]) > Puppi::ETA_CUT );
+            bool badID  = ( soa.id[i] < 2 || soa.id[i] > 5 );
 
-            if (badEta || badID)
-            {
-                output_stream[nfifo].at(i) = dummy;
-            }
-            else
-            {
-                output_stream[nfifo].at(i) = unpackedPuppi;
-            }
+            keys[i][nfifo] = (badEta || badID) ? simdSort::maskedKey(i) : simdSort::makeKey(input_stream[nfifo][i], i);
+            W3P_STATS_ONLY(nunmasked += !(badEta || badID));
 
             // Debug printouts of puppi candidates
             if (DEBUG)
             {
-                Puppi myoutput = output_stream[nfifo].at(i);
+                Puppi myoutput = simdSort::toPuppi(keys[i][nfifo]);
                 printf("  %3u/%3u : pT %6.2f  eta %+6.3f  phi %+6.3f  pid %1u  Z0 %+6.3f\n",
                         i, NPUPPI_LINK, myoutput.floatPt(), myoutput.floatEta(),
                         myoutput.floatPhi(), myoutput.hwID.to_uint(), myoutput.floatZ0());
@@ -61,10 +55,78 @@ void w3p_emulator(const std::vector<uint64_t> input_stream[NLINKS], std::vector<
             }
         }
 
-        // Sorting
-        std::stable_sort(output_stream[nfifo].begin(), output_stream[nfifo].end(), puppiComparator);
-
     } // end loop on NLINKS
+    W3P_STATS_LAP(clock, "emu.mask");
+    W3P_STATS_COUNT("emu.unmasked", nunmasked);
+
+    // Sorting: all the links at once, same order as std::stable_sort in decreasing pT
+    simdSort::sortLinks(keys);
+    for (int nfifo = 0; nfifo < NLINKS; nfifo++)
+        for (int i = 0; i < NPUPPI_LINK; ++i)
+            output_stream[nfifo].at(i) = simdSort::toPuppi(keys[i][nfifo]);
+    W3P_STATS_LAP(clock, "emu.sort");
+
+    // Merge: global top NPUPPI_SEL of the sorted links, candidates with the same pT in link order
+    simdSort::key_t selected[NPUPPI_SEL];
+    simdSort::mergeLinks(keys, selected);
+    output_sel.resize(NPUPPI_SEL);
+    for (int i = 0; i < NPUPPI_SEL; ++i)
+        output_sel[i] = simdSort::toPuppi(selected[i]);
+    W3P_STATS_LAP(clock, "emu.merge");
 }
 
+// ------------------------------------------------------------------
+void event_processor_stream_emulator(const std::vector<Puppi> & input_sel, std::vector<TripletFrame> & output)
+{
+    W3P_STATS_CLOCK(clock);
+    W3P_STATS_ONLY(bool truncated = false);
+    output.clear();
+
+    // Pivot and pairs of non-masked candidates, pT ordered
+    for (int i = 1; i < NPUPPI_SEL-1; ++i)
+        for (int j = i+1; j < NPUPPI_SEL; ++j)
+        {
+            if (input_sel[0].hwPt <= 3 || input_sel[i].hwPt <= 3 || input_sel[j].hwPt <= 3)
+                continue;
+            if (!triplet_selection(input_sel[0], input_sel[i], input_sel[j]))
+                continue;
+            // Only a passing triplet that does not fit counts as truncation
+            if (output.size() == NTRIPLETS)
+            {
+                W3P_STATS_ONLY(truncated = true);
+                break;
+            }
+
+            TripletFrame triplet;
+            triplet.puppi0 = input_sel[0];
+            triplet.puppi1 = input_sel[i];
+            triplet.puppi2 = input_sel[j];
+            triplet.valid = true;
+            output.push_back(triplet);
+        }
+    W3P_STATS_COUNT("emu.triplets", output.size());
+    W3P_STATS_COUNT("emu.triplets_truncated", truncated);
 
+    // Empty frames up to NTRIPLETS, last one flagged
+    TripletFrame empty;
+    empty.puppi0 = input_sel[0];
+    empty.puppi1.clear();
+    empty.puppi2.clear();
+    empty.valid = false;
+    output.resize(NTRIPLETS, empty);
+    for (int k = 0; k < NTRIPLETS; ++k)
+        output[k].last = (k == NTRIPLETS-1);
+    W3P_STATS_LAP(clock, "emu.build_triplets");
+}
+
+// ------------------------------------------------------------------
+void w3p_chain_emulator(const std::vector<uint64_t> input_stream[NLINKS], std::vector<TripletFrame> & output)
+{
+    std::vector<Puppi> output_links[NLINKS];
+    for (int nfifo = 0; nfifo < NLINKS; nfifo++)
+        output_links[nfifo].resize(NPUPPI_LINK);
+    std::vector<Puppi> output_sel;
+
+    w3p_emulator(input_stream, output_links, output_sel);
+    event_processor_stream_emulator(output_sel, output);
+}
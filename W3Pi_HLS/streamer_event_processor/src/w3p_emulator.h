@@ -12,6 +12,13 @@
 // ---------------------
 // ----- REFERENCE -----
 // ---------------------
-void w3p_emulator(const std::vector<uint64_t> input_stream[NLINKS], std::vector<Puppi> output_stream[NLINKS]);
+// Masked and sorted candidates of each link (output_stream) and global top NPUPPI_SEL (output_sel)
+void w3p_emulator(const std::vector<uint64_t> input_stream[NLINKS], std::vector<Puppi> output_stream[NLINKS], std::vector<Puppi> & output_sel);
+
+// Triplets of the pivot (first candidate) with the pairs of the other NPUPPI_SEL candidates (NTRIPLETS frames)
+void event_processor_stream_emulator(const std::vector<Puppi> & input_sel, std::vector<TripletFrame> & output);
+
+// Chained emulator of w3p_chain: w3p_emulator followed by event_processor_stream_emulator
+void w3p_chain_emulator(const std::vector<uint64_t> input_stream[NLINKS], std::vector<TripletFrame> & output);
 
 #endif
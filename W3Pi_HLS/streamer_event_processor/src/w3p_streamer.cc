@@ -3,7 +3,7 @@
 
 //---------------------------------------------------------
 // Read input stream and decode uint64_t into Pupppi candidate
-inline void decoder (hls::stream<uint64_t> &inFifo, hls::stream<Puppi> &outFifo)
+inline void decoder (w3p_stream<uint64_t> &inFifo, w3p_stream<Puppi> &outFifo)
 {
     // Output Puppi
     Puppi tmpPuppi;
@@ -26,7 +26,7 @@ inline void decoder (hls::stream<uint64_t> &inFifo, hls::stream<Puppi> &outFifo)
 
 // ------------------------------------------------------------------
 // Masker method (apply selections)
-void masker (hls::stream<Puppi> &inPuppi, hls::stream<Puppi> &maskedPuppi)
+void masker (w3p_stream<Puppi> &inPuppi, w3p_stream<Puppi> &maskedPuppi)
 {
     // Dummy Puppi candidate
     Puppi dummyPuppi;
@@ -58,34 +58,67 @@ void masker (hls::stream<Puppi> &inPuppi, hls::stream<Puppi> &maskedPuppi)
 }
 
 //---------------------------------------------------------
-// Merging methods
-// get_bitonic_sequence
-void get_bitonic_sequenceA(const Puppi in1[NSORTING], const Puppi in2[NSORTING], Puppi bitonic[2*NSORTING])
+// Only the first NMERGE candidates of each link can enter the global top NPUPPI_SEL,
+// so the links are only sorted up to NMERGE candidates (NPUPPI_SEL rounded up to a power of 2)
+static_assert(NMERGE == hybridBitonicSort::PowerOf2GreaterEqualThan(NPUPPI_SEL), "sorter: NMERGE must be NPUPPI_SEL rounded up to a power of 2");
+static_assert(NMERGE <= NSORTING, "sorter: NPUPPI_SEL too large for the chunks");
+
+//---------------------------------------------------------
+// Sort Puppi candidates
+// The first NMERGE of each chunk are selected (topK: the comparators of the other outputs
+// are pruned), then the two chunks are merged keeping the first NMERGE
+#if W3P_KEY_SORT
+// Key-index sort: the keys (pT, index in the link) are sorted, then the NMERGE leading
+// candidates are gathered from the buffer by index
+static_assert(NPUPPI_LINK <= PuppiKey::MAX_INDEX + 1, "sorter: too many candidates per link for PuppiKey");
+
+void sorter (w3p_stream<Puppi> &inPuppi, Puppi sortedPuppi[NMERGE])
 {
-    #pragma HLS array_partition variable=in1 complete
-    #pragma HLS array_partition variable=in2 complete
-    #pragma HLS array_partition variable=bitonic complete
-    LOOP_MAKE_BITONIC: for (int id = 0, ia=NSORTING-1; id<NSORTING; id++, ia--)
+    // Buffer to read input Puppi, and sort keys of each chunk
+    Puppi bufferPuppi[NPUPPI_LINK];
+    #pragma HLS array_partition variable=bufferPuppi complete
+    PuppiKey keys[NCHUNKS][NSORTING];
+
+    // Fill buffer with first half of input Puppi
+    LOOP_SORTER_HALF1: for (unsigned int i = 0; i < NSORTING; ++i)
     {
-        #pragma HLS UNROLL
-        bitonic[id] = in1[ia];
-        bitonic[id+(NSORTING)] = in2[id];
+        #pragma HLS pipeline
+        Puppi tmpPuppi = inPuppi.read();
+        bufferPuppi[i] = tmpPuppi;
+        keys[0][i].set(tmpPuppi, i);
     }
-}
 
-// merge_sort
-void merge_sortA(const Puppi in1[NSORTING], const Puppi in2[NSORTING], Puppi sorted_out[2*NSORTING])
-{
-    #pragma HLS array_partition variable=in1 complete
-    #pragma HLS array_partition variable=in2 complete
-    #pragma HLS array_partition variable=sorted_out complete
-    get_bitonic_sequenceA(in1, in2, sorted_out);
-    hybridBitonicSort::bitonicMerger<Puppi, 2*NSORTING, 0>::run(sorted_out, 0);
-}
+    // Sort first half and fill second half in parallel
+    LOOP_SORTER_CHUNKS: for (unsigned int i = 1; i < NCHUNKS; ++i)
+    {
+        // Select first half
+        hybridBitonicSort::topK<PuppiKey, NSORTING, NMERGE, 0>::run(keys[0], 0);
 
-//---------------------------------------------------------
-// Sort Puppi candidates
-void sorter (hls::stream<Puppi> &inPuppi, Puppi sortedPuppi[NPUPPI_LINK])
+        // Fill second half
+        LOOP_SORTER_HALF2: for (unsigned int j = 0; j < NSORTING; ++j) {
+            #pragma HLS pipeline
+            Puppi tmpPuppi = inPuppi.read();
+            bufferPuppi[i*NSORTING + j] = tmpPuppi;
+            keys[i][j].set(tmpPuppi, i*NSORTING + j);
+        }
+    }
+
+    // Select second half
+    hybridBitonicSort::topK<PuppiKey, NSORTING, NMERGE, 0>::run(keys[1], 0);
+
+    // Merge selected halves
+    PuppiKey sortedKeys[NMERGE];
+    hybridBitonicSort::bitonicTopMerger<PuppiKey, NMERGE, 0>::run(keys[0], keys[1], sortedKeys);
+
+    // Gather the candidates
+    LOOP_SORTER_GATHER: for (int k = 0; k < NMERGE; k++)
+    {
+        #pragma HLS unroll
+        sortedPuppi[k] = bufferPuppi[sortedKeys[k].index()];
+    }
+}
+#else
+void sorter (w3p_stream<Puppi> &inPuppi, Puppi sortedPuppi[NMERGE])
 {
     // Buffer to read input Puppi
     Puppi accumulatedPuppi[NCHUNKS][NSORTING];
@@ -100,8 +133,8 @@ void sorter (hls::stream<Puppi> &inPuppi, Puppi sortedPuppi[NPUPPI_LINK])
     // Sort first half and fill second half in parallel
     LOOP_SORTER_CHUNKS: for (unsigned int i = 1; i < NCHUNKS; ++i)
     {
-        // Sort first half
-        hybridBitonicSort::bitonicSorter<Puppi, NSORTING, 0, true>::run(accumulatedPuppi[0], 0);
+        // Select first half
+        hybridBitonicSort::topK<Puppi, NSORTING, NMERGE, 0>::run(accumulatedPuppi[0], 0);
 
         // Fill second half
         LOOP_SORTER_HALF2: for (unsigned int j = 0; j < NSORTING; ++j) {
@@ -110,42 +143,119 @@ void sorter (hls::stream<Puppi> &inPuppi, Puppi sortedPuppi[NPUPPI_LINK])
         }
     }
 
-    // Sort second half
-    hybridBitonicSort::bitonicSorter<Puppi, NSORTING, 0, true>::run(accumulatedPuppi[1], 0);
+    // Select second half
+    hybridBitonicSort::topK<Puppi, NSORTING, NMERGE, 0>::run(accumulatedPuppi[1], 0);
+
+    // Merge selected halves
+    hybridBitonicSort::bitonicTopMerger<Puppi, NMERGE, 0>::run(accumulatedPuppi[0], accumulatedPuppi[1], sortedPuppi);
+}
+#endif
+
+//---------------------------------------------------------
+// Merge the sorted links into the global top NPUPPI_SEL candidates
+// Each level of the tree keeps NMERGE candidates
+static_assert(NLINKS == 4, "merger: the merge tree is written for 4 links");
+
+void merger (Puppi sortedPuppi[NLINKS][NMERGE], Puppi selectedPuppi[NPUPPI_SEL])
+{
+    #pragma HLS array_partition variable=selectedPuppi complete
+
+#if W3P_KEY_SORT
+    // Keys of the sorted links, indexed by link then rank: same order as the links
+    // concatenated in link order for the candidates with the same pT
+    PuppiKey linkKeys[NLINKS][NMERGE];
+    LOOP_MERGER_KEYS: for (int l = 0; l < NLINKS; l++)
+    {
+        #pragma HLS unroll
+        LOOP_MERGER_KEYS_RANK: for (int r = 0; r < NMERGE; r++)
+        {
+            #pragma HLS unroll
+            linkKeys[l][r].set(sortedPuppi[l][r], l*NMERGE + r);
+        }
+    }
+
+    // First level: links 0+1 and 2+3
+    PuppiKey merged01[NMERGE], merged23[NMERGE];
+    hybridBitonicSort::bitonicTopMerger<PuppiKey, NMERGE, 0>::run(linkKeys[0], linkKeys[1], merged01);
+    hybridBitonicSort::bitonicTopMerger<PuppiKey, NMERGE, 0>::run(linkKeys[2], linkKeys[3], merged23);
 
-    // Merge sorted halves
-    merge_sortA(accumulatedPuppi[0], accumulatedPuppi[1], sortedPuppi);
+    // Second level: global top
+    PuppiKey merged[NMERGE];
+    hybridBitonicSort::bitonicTopMerger<PuppiKey, NMERGE, 0>::run(merged01, merged23, merged);
+
+    // Gather the candidates
+    LOOP_MERGER: for (int i = 0; i < NPUPPI_SEL; i++)
+    {
+        #pragma HLS unroll
+        idx_t index = merged[i].index();
+        selectedPuppi[i] = sortedPuppi[index / NMERGE][index % NMERGE];
+    }
+#else
+    // First level: links 0+1 and 2+3
+    Puppi merged01[NMERGE], merged23[NMERGE];
+    hybridBitonicSort::bitonicTopMerger<Puppi, NMERGE, 0>::run(sortedPuppi[0], sortedPuppi[1], merged01);
+    hybridBitonicSort::bitonicTopMerger<Puppi, NMERGE, 0>::run(sortedPuppi[2], sortedPuppi[3], merged23);
+
+    // Second level: global top
+    Puppi merged[NMERGE];
+    hybridBitonicSort::bitonicTopMerger<Puppi, NMERGE, 0>::run(merged01, merged23, merged);
+
+    LOOP_MERGER: for (int i = 0; i < NPUPPI_SEL; i++)
+    {
+        #pragma HLS unroll
+        selectedPuppi[i] = merged[i];
+    }
+#endif
 }
 
 //---------------------------------------------------------
-// Write to output stream
-void writer (Puppi sortedPuppi[NPUPPI_LINK], hls::stream<Puppi> &outFifo)
+// Write to output stream, flagging the last candidate of the event
+void writer (Puppi selectedPuppi[NPUPPI_SEL], w3p_stream<PuppiFrame> &outFifo)
 {
-    LOOP_WRITER: for (size_t i = 0; i < NPUPPI_LINK; i++)
+    LOOP_WRITER: for (size_t i = 0; i < NPUPPI_SEL; i++)
     {
         #pragma HLS pipeline
-        outFifo << sortedPuppi[i];
+        PuppiFrame frame;
+        frame.puppi = selectedPuppi[i];
+        frame.last = (i == NPUPPI_SEL-1);
+        outFifo << frame;
     }
 }
 
 //---------------------------------------------------------
 // Top function
-void w3p_streamer (hls::stream<uint64_t> inFifo[NLINKS], hls::stream<Puppi> outFifo[NLINKS])
+void w3p_streamer (w3p_stream<uint64_t> inFifo[NLINKS], w3p_stream<PuppiFrame> &outFifo)
 {
     #pragma HLS DATAFLOW
 
     // Utility streams
-    // Using depth=NPUPPI_LINK you gain one clock in latency, but loose a bit of resources
-    // #pragma HLS stream variable=decoded_stream depth=NPUPPI_LINK
-    // #pragma HLS stream variable=masked_stream  depth=NPUPPI_LINK
-    hls::stream<Puppi> decoded_stream[NLINKS];
-    hls::stream<Puppi> masked_stream[NLINKS];
+    // Using depth=NPUPPI_LINK (-DLINK_STREAM_DEPTH=NPUPPI_LINK) you gain one clock in latency,
+    // but loose a bit of resources
+    w3p_stream<Puppi> decoded_stream[NLINKS];
+    w3p_stream<Puppi> masked_stream[NLINKS];
+    #pragma HLS stream variable=decoded_stream depth=LINK_STREAM_DEPTH
+    #pragma HLS stream variable=masked_stream  depth=LINK_STREAM_DEPTH
 
-    // Array of sorted Puppi candidates
+    // Array of the leading sorted Puppi candidates of each link
     // This array is automatically partitioned as:
     // #pragma HLS ARRAY_PARTITION variable=sortedPuppi type=complete dim=2
-    Puppi sortedPuppi[NLINKS][NPUPPI_LINK];
+    Puppi sortedPuppi[NLINKS][NMERGE];
 
+#ifdef W3P_THREADED_DATAFLOW
+    // C-simulation: one thread per process and bounded streams (see w3p_stream.h), the
+    // sorted links are handed to the merger when all the sorters are done
+    {
+        w3p_dataflow::Region region;
+        for (int i = 0; i < NLINKS; i++)
+        {
+            decoded_stream[i].configure("w3p_streamer.decoded_stream[" + std::to_string(i) + "]", LINK_STREAM_DEPTH);
+            masked_stream[i].configure("w3p_streamer.masked_stream[" + std::to_string(i) + "]", LINK_STREAM_DEPTH);
+            region.spawn([&, i]() { decoder(inFifo[i], decoded_stream[i]); });
+            region.spawn([&, i]() { masker (decoded_stream[i], masked_stream[i]); });
+            region.spawn([&, i]() { sorter (masked_stream[i], sortedPuppi[i]); });
+        }
+    }
+#else
     // Loop on input streams and process data
     LOOP_NLINKS: for (int i = 0; i < NLINKS; i++)
     {
@@ -155,8 +265,11 @@ void w3p_streamer (hls::stream<uint64_t> inFifo[NLINKS], hls::stream<Puppi> outF
         decoder(inFifo[i], decoded_stream[i]);
         masker (decoded_stream[i], masked_stream[i]);
         sorter (masked_stream[i], sortedPuppi[i]);
-
-        // Copy to output stream
-        writer(sortedPuppi[i], outFifo[i]);
     }
-}
\ No newline at end of file
+#endif
+
+    // Merge links and copy to output stream
+    Puppi selectedPuppi[NPUPPI_SEL];
+    merger(sortedPuppi, selectedPuppi);
+    writer(selectedPuppi, outFifo);
+}
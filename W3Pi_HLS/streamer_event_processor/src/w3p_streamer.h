@@ -6,6 +6,8 @@
 // --------------------
 // ----- FIRMWARE -----
 // --------------------
-void w3p_streamer( hls::stream<uint64_t> input[NLINKS], hls::stream<Puppi> output[NLINKS]);
+// Decode, mask and sort each link, then merge them into the global top NPUPPI_SEL candidates
+// (NPUPPI_SEL frames per event, the last one flagged)
+void w3p_streamer( w3p_stream<uint64_t> input[NLINKS], w3p_stream<PuppiFrame> & output);
 
 #endif
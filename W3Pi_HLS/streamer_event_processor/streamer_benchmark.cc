@@ -0,0 +1,187 @@
+// Microbenchmarks of the streamer kernels, their emulators and the sorting networks
+//
+// Usage:
+//   streamer_benchmark [-n repeat] [-s nsynthetic] [-o results.jsonl] [link_a.dump link_b.dump link_c.dump link_d.dump]
+//
+//  - inputs: the events of the NLINKS dump files (default: the bundled PU200 links, run from
+//    the data directory), named PU200, and nsynthetic synthetic events of NLINKS full links of
+//    NPUPPI_LINK candidates (default 200)
+//  - each benchmark runs repeat times (default 5) over the events of each input, and prints
+//    ns/event, events/s and the percentiles of the time per event (see utils/benchmark.h)
+//  - the sorting networks take a few ns per call: they are timed by batches of events, and
+//    one "event" is one chunk (NSORTING) or all the links (NLINKS x NPUPPI_LINK)
+//  - with -o, the same results are written as JSON Lines, to compare them across commits
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "src/w3p_streamer.h"
+#include "src/w3p_chain.h"
+#include "src/w3p_emulator.h"
+#include "src/simd_sort.h"
+#include "../utils/dump_reader.h"
+#include "../utils/puppi_soa.h"
+#include "../utils/benchmark.h"
+
+// Events timed together for the sorting networks
+#define NETWORK_BATCH 64
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [-n repeat] [-s nsynthetic] [-o results.jsonl] [link_a.dump link_b.dump link_c.dump link_d.dump]\n", name);
+}
+
+// One event of the NLINKS links, in all the input formats
+struct BenchEvent {
+    std::vector<uint64_t> links[NLINKS];
+    Puppi chunk[NSORTING];                        // first chunk of the first link
+    PuppiKey chunkKeys[NSORTING];
+    simdSort::key_t keys[NPUPPI_LINK][NLINKS];
+
+    void fill(const std::vector<uint64_t> words[NLINKS])
+    {
+        for (int l = 0; l < NLINKS; l++)
+        {
+            links[l] = words[l];
+            links[l].resize(NPUPPI_LINK, 0);
+            for (int i = 0; i < NPUPPI_LINK; i++)
+                keys[i][l] = simdSort::makeKey(links[l][i], i);
+        }
+        for (int i = 0; i < NSORTING; i++)
+        {
+            chunk[i].unpack(links[0][i]);
+            chunkKeys[i].set(chunk[i], i);
+        }
+    }
+};
+
+// All the benchmarks on one input
+static void run_input(w3p_bench::BenchSuite & suite, const std::string & input, std::vector<BenchEvent> & events)
+{
+    size_t n = events.size();
+
+    suite.run("w3p_emulator", input, n, [&](size_t i) {
+        std::vector<Puppi> out_links[NLINKS], sel;
+        for (int l = 0; l < NLINKS; l++) out_links[l].resize(NPUPPI_LINK);
+        w3p_emulator(events[i].links, out_links, sel);
+        w3p_bench::do_not_optimize(sel.data());
+    });
+    suite.run("w3p_chain_emulator", input, n, [&](size_t i) {
+        std::vector<TripletFrame> out;
+        w3p_chain_emulator(events[i].links, out);
+        w3p_bench::do_not_optimize(out.data());
+    });
+    suite.run("w3p_streamer (C-sim)", input, n, [&](size_t i) {
+        w3p_stream<uint64_t> inFifo[NLINKS];
+        w3p_stream<PuppiFrame> outFifo;
+        for (int l = 0; l < NLINKS; l++)
+            for (int k = 0; k < NPUPPI_LINK; k++)
+                inFifo[l] << events[i].links[l][k];
+        w3p_streamer(inFifo, outFifo);
+        for (int k = 0; k < NPUPPI_SEL; k++)
+            w3p_bench::do_not_optimize(outFifo.read().last);
+    });
+    suite.run("w3p_chain (C-sim)", input, n, [&](size_t i) {
+        w3p_stream<uint64_t> inFifo[NLINKS];
+        w3p_stream<TripletFrame> outFifo;
+        for (int l = 0; l < NLINKS; l++)
+            for (int k = 0; k < NPUPPI_LINK; k++)
+                inFifo[l] << events[i].links[l][k];
+        w3p_chain(inFifo, outFifo);
+        for (int k = 0; k < NTRIPLETS; k++)
+            w3p_bench::do_not_optimize(outFifo.read().last);
+    });
+
+    // Sorting networks, on copies of the inputs
+    suite.run("bestSorter<Puppi," + std::to_string(NSORTING) + "> (chunk)", input, n, [&](size_t i) {
+        Puppi a[NSORTING];
+        std::copy(events[i].chunk, events[i].chunk + NSORTING, a);
+        hybridBitonicSort::bestSorter<Puppi, NSORTING, 0>::run(a, 0);
+        w3p_bench::do_not_optimize(a);
+    }, NETWORK_BATCH);
+    suite.run("topK<PuppiKey," + std::to_string(NSORTING) + "," + std::to_string(NMERGE) + "> (chunk)", input, n, [&](size_t i) {
+        PuppiKey a[NSORTING];
+        std::copy(events[i].chunkKeys, events[i].chunkKeys + NSORTING, a);
+        hybridBitonicSort::topK<PuppiKey, NSORTING, NMERGE, 0>::run(a, 0);
+        w3p_bench::do_not_optimize(a);
+    }, NETWORK_BATCH);
+    suite.run("simdSort::sortLinks (scalar)", input, n, [&](size_t i) {
+        simdSort::key_t keys[NPUPPI_LINK][NLINKS];
+        std::copy(&events[i].keys[0][0], &events[i].keys[0][0] + NPUPPI_LINK*NLINKS, &keys[0][0]);
+        simdSort::sortLinks(keys, false);
+        w3p_bench::do_not_optimize(keys);
+    }, NETWORK_BATCH);
+    if (simdSort::hasAvx2())
+    {
+        suite.run("simdSort::sortLinks (avx2)", input, n, [&](size_t i) {
+            simdSort::key_t keys[NPUPPI_LINK][NLINKS];
+            std::copy(&events[i].keys[0][0], &events[i].keys[0][0] + NPUPPI_LINK*NLINKS, &keys[0][0]);
+            simdSort::sortLinks(keys, true);
+            w3p_bench::do_not_optimize(keys);
+        }, NETWORK_BATCH);
+    }
+}
+
+int main(int argc, char **argv) {
+
+    // Parse arguments
+    unsigned int repeat = 5, nsynthetic = 200;
+    std::string outname;
+    std::vector<std::string> innames;
+    for (int i = 1; i < argc; ++i)
+    {
+        if      (!strcmp(argv[i], "-n") && i+1 < argc) repeat = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i+1 < argc) nsynthetic = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i+1 < argc) outname = argv[++i];
+        else if (argv[i][0] == '-') { usage(argv[0]); return 1; }
+        else innames.push_back(argv[i]);
+    }
+    if (innames.empty())
+        innames = {"Puppi_w3p_PU200_a.dump", "Puppi_w3p_PU200_b.dump", "Puppi_w3p_PU200_c.dump", "Puppi_w3p_PU200_d.dump"};
+    if (innames.size() != NLINKS) { usage(argv[0]); return 1; }
+
+    w3p_bench::BenchSuite suite("streamer", repeat, outname);
+
+    // Events of the dump files, the input is named after the first file
+    DumpReader inDumps[NLINKS];
+    size_t nevents = ~size_t(0);
+    for (int l = 0; l < NLINKS; l++)
+    {
+        inDumps[l].open(innames[l]);
+        nevents = std::min(nevents, inDumps[l].size());
+    }
+    std::vector<BenchEvent> events(nevents);
+    for (size_t ievt = 0; ievt < nevents; ++ievt)
+    {
+        std::vector<uint64_t> words[NLINKS];
+        for (int l = 0; l < NLINKS; l++)
+        {
+            DumpEvent event = inDumps[l].event(ievt);
+            words[l].assign(event.begin(), std::min(event.end(), event.begin() + NPUPPI_LINK));
+        }
+        events[ievt].fill(words);
+    }
+    std::string input = innames[0].substr(innames[0].find_last_of('/') + 1);
+    input = input.substr(0, input.find(".dump"));
+    if (input.compare(0, 10, "Puppi_w3p_") == 0) input = input.substr(10);
+    if (input.size() > 2 && input[input.size()-2] == '_') input.resize(input.size()-2);
+    run_input(suite, input, events);
+
+    // Synthetic events: full links of NPUPPI_LINK candidates
+    std::mt19937 rng(12345);
+    events.assign(nsynthetic, BenchEvent());
+    for (BenchEvent & e : events)
+    {
+        std::vector<uint64_t> words[NLINKS];
+        for (int l = 0; l < NLINKS; l++)
+            w3p_bench::synthetic_event(rng, NPUPPI_LINK, words[l]);
+        e.fill(words);
+    }
+    run_input(suite, "synthetic", events);
+
+    return 0;
+}
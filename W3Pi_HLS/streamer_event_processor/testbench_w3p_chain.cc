@@ -0,0 +1,166 @@
+// Standar includes
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+// Vitis includes
+#include "hls_stream.h"
+
+// Project includes
+#include "src/w3p_chain.h"
+#include "src/w3p_streamer.h"
+#include "src/w3p_emulator.h"
+#include "../utils/event_builder.h"
+#include "../utils/stage_stats.h"
+
+#define OUTPUT_DEBUG 1
+#define NTEST 20
+
+// -------------------------------------------------------------
+// Same frames (candidates, valid and last flags)
+bool sameTriplets(const std::vector<TripletFrame> & a, const std::vector<TripletFrame> & b)
+{
+    if (a.size() != b.size()) return false;
+    for (unsigned int k = 0; k < a.size(); k++)
+    {
+        if (a[k].valid != b[k].valid || a[k].last != b[k].last) return false;
+        if (a[k].valid && (a[k].puppi0.pack() != b[k].puppi0.pack() || a[k].puppi1.pack() != b[k].puppi1.pack() || a[k].puppi2.pack() != b[k].puppi2.pack()))
+            return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------------------
+// Main testbench function
+// All the events are written in the input streams before calling w3p_chain back-to-back
+// (as in co-simulation, where consecutive calls overlap). Checks:
+//  - event framing of the output
+//  - chain output vs event_processor_stream_emulator run on the w3p_streamer output
+//  - selected candidates of w3p_streamer vs w3p_emulator
+//  - chain output vs the full chained emulator
+// Without the key-index sort (W3P_KEY_SORT=0), candidates with the same pT can be ordered or
+// selected differently by the firmware sorter and the emulator: only the pT of the selected
+// candidates is checked, and the comparison with the chained emulator is only printed.
+int main(int argc, char **argv) {
+
+    // Build the events of the input links, aligned on (run, orbit, bx)
+    EventBuilder<NLINKS> builder({"Puppi_w3p_PU200_a.dump", "Puppi_w3p_PU200_b.dump", "Puppi_w3p_PU200_c.dump", "Puppi_w3p_PU200_d.dump"}, NPUPPI_LINK);
+    assert(builder.good());
+
+    // Fill firmware-input streams (chain and standalone streamer) and run the emulators,
+    // on the first NTEST complete events
+    w3p_stream<uint64_t> inFifo[NLINKS], inFifoStreamer[NLINKS];
+    std::vector< std::vector<Puppi> > sel_ref;
+    std::vector< std::vector<TripletFrame> > out_ref;
+    LinkEvent<NLINKS> event;
+    int ntest = 0;
+    while (ntest < NTEST && builder.next(event))
+    {
+        if (!event.complete())
+        {
+            std::cout << "     Skipping incomplete event " << event.index << " (run " << event.run << ", orbit " << event.orbit << ", bx " << event.bx
+                      << "): missing links 0x" << std::hex << event.missing << ", error links 0x" << event.error << std::dec << std::endl;
+            continue;
+        }
+        std::vector<uint64_t> inData[NLINKS];
+        for (int j = 0; j < NLINKS; j++)
+        {
+            // Copy actual data in uint64_t vectors (the rest is zero-padded)
+            inData[j] = std::vector<uint64_t>(NPUPPI_LINK, 0);
+            std::copy(event.link(j).begin(), event.link(j).end(), inData[j].begin());
+            for (int i = 0; i < NPUPPI_LINK; i++)
+            {
+                inFifo[j] << inData[j][i];
+                inFifoStreamer[j] << inData[j][i];
+            }
+        }
+        std::vector<Puppi> out_links[NLINKS];
+        for (int j = 0; j < NLINKS; j++)
+            out_links[j].resize(NPUPPI_LINK);
+        sel_ref.emplace_back();
+        out_ref.emplace_back();
+        w3p_emulator(inData, out_links, sel_ref.back());
+        w3p_chain_emulator(inData, out_ref.back());
+        ntest++;
+    }
+
+    // Firmware calls, back-to-back
+    w3p_stream<TripletFrame> outFifo;
+    w3p_stream<PuppiFrame> selFifo;
+    for (int itest = 0; itest < ntest; ++itest)
+    {
+        w3p_chain(inFifo, outFifo);
+        w3p_streamer(inFifoStreamer, selFifo);
+    }
+
+    // Read and check the framed outputs
+    int nvalid = 0, nsame = 0;
+    for (int itest = 0; itest < ntest; ++itest)
+    {
+        std::vector<TripletFrame> out_fwr(NTRIPLETS);
+        for (int k = 0; k < NTRIPLETS; k++)
+        {
+            outFifo >> out_fwr[k];
+            nvalid += out_fwr[k].valid;
+            if (out_fwr[k].last != (k == NTRIPLETS-1))
+            {
+                std::cout << "     Wrong event framing in event " << itest << " at triplet " << k << std::endl;
+                return 1;
+            }
+        }
+
+        // Stream event_processor on the firmware selected candidates
+        std::vector<Puppi> sel_fwr(NPUPPI_SEL);
+        for (int i = 0; i < NPUPPI_SEL; i++)
+            sel_fwr[i] = selFifo.read().puppi;
+        std::vector<TripletFrame> out_sel;
+        event_processor_stream_emulator(sel_fwr, out_sel);
+        if (!sameTriplets(out_fwr, out_sel))
+        {
+            std::cout << "     Different triplets from the selected candidates in event " << itest << std::endl;
+            return 1;
+        }
+        for (int i = 0; i < NPUPPI_SEL; i++)
+        {
+            bool same = W3P_KEY_SORT ? (sel_fwr[i].pack() == sel_ref[itest][i].pack()) : (sel_fwr[i].hwPt == sel_ref[itest][i].hwPt);
+            if (!same)
+            {
+                std::cout << "     Different selected Puppi in event " << itest << " at i: " << i << " -> FW: " << sel_fwr[i] << " REF: " << sel_ref[itest][i] << std::endl;
+                return 1;
+            }
+        }
+
+        bool same = sameTriplets(out_fwr, out_ref[itest]);
+        nsame += same;
+        if (OUTPUT_DEBUG)
+        {
+            std::cout << "*** itest " << itest << (same ? "" : " (differs from the chained emulator)") << std::endl;
+            std::cout << "  FW :"; for (int k = 0; k < NTRIPLETS; k++) std::cout << " " << out_fwr[k]; std::cout << std::endl;
+            std::cout << "  REF:"; for (int k = 0; k < NTRIPLETS; k++) std::cout << " " << out_ref[itest][k]; std::cout << std::endl;
+        }
+        if (W3P_KEY_SORT && !same)
+        {
+            std::cout << "     Different triplets from the chained emulator in event " << itest << std::endl;
+            return 1;
+        }
+    }
+
+    // Nothing left in the streams
+    for (int j = 0; j < NLINKS; j++)
+        assert(inFifo[j].empty() && inFifoStreamer[j].empty());
+    assert(outFifo.empty() && selFifo.empty());
+
+    std::cout << "Chain test passed: " << ntest << " events, " << nvalid << " triplets, "
+              << nsame << " events identical to the chained emulator" << std::endl;
+#ifdef W3P_THREADED_DATAFLOW
+    // Occupancy and stalls of the internal streams, to size their depth
+    w3p_dataflow::print_stream_stats();
+#endif
+#ifdef W3P_STAGE_STATS
+    // Per-stage counters and timing of the emulator
+    w3p_stats::print_stats();
+#endif
+    return 0;
+}
@@ -10,6 +10,8 @@
 // Project includes
 #include "src/w3p_streamer.h"
 #include "src/w3p_emulator.h"
+#include "../utils/event_builder.h"
+#include "../utils/stage_stats.h"
 
 #define HEADER_DEBUG 0
 #define OUTPUT_DEBUG 1
@@ -44,70 +46,43 @@ void printVector(std::vector<T> A)
 // Main testbench function
 int main(int argc, char **argv) {
 
-    // Read input stream
-    std::fstream inFstreams[4];
-    inFstreams[0].open("Puppi_w3p_PU200_a.dump", std::ios::in | std::ios::binary);
-    inFstreams[1].open("Puppi_w3p_PU200_b.dump", std::ios::in | std::ios::binary);
-    inFstreams[2].open("Puppi_w3p_PU200_c.dump", std::ios::in | std::ios::binary);
-    inFstreams[3].open("Puppi_w3p_PU200_d.dump", std::ios::in | std::ios::binary);
-
-    // Loop on input data in chunks
-    for (int itest = 0, ntest = NTEST;
-         itest < ntest && inFstreams[0].good() && inFstreams[1].good() && inFstreams[2].good() && inFstreams[3].good();
-         ++itest)
+    // Build the events of the input links, aligned on (run, orbit, bx)
+    EventBuilder<NLINKS> builder({"Puppi_w3p_PU200_a.dump", "Puppi_w3p_PU200_b.dump", "Puppi_w3p_PU200_c.dump", "Puppi_w3p_PU200_d.dump"}, NPUPPI_LINK);
+    assert(builder.good());
+
+    // Loop on input events
+    LinkEvent<NLINKS> event;
+    for (int itest = 0, ntest = NTEST; itest < ntest && builder.next(event); ++itest)
     {
         std::cout << "--------------------" << std::endl;
 
-        // Read header
-        uint64_t headers[NLINKS];
-        for (int i = 0; i < NLINKS; i++)
-        {
-            inFstreams[i].read(reinterpret_cast<char *>(&headers[i]), sizeof(uint64_t));
-        }
-
-        // Read header quantities
-        // bits 	size 	meaning
-        // 63-62 	2 	    10 = valid event header
-        // 61 	    1 	    error bit
-        // 60-56 	6 	    (local) run number
-        // 55-24 	32 	    orbit number
-        // 23-12 	12 	    bunch crossing number (0-3563)
-        // 11-07 	4 	    must be set to 0
-        // 07-00 	8 	    number of Puppi candidates
+        // Header quantities (see dump_reader.h)
         unsigned int npuppis[NLINKS];
         for (int i = 0; i < NLINKS; i++)
         {
-            npuppis[i] = headers[i] & 0xFF;                  // 8 bits
+            npuppis[i] = event.link(i).npuppi();
         }
-        //unsigned int beZero = (header >> 8)  & 0xF       ; // 4 bits
-        //unsigned int bxNum  = (header >> 12) & 0xFFF     ; // 12 bits
-        //unsigned int orbitN = (header >> 24) & 0xFFFFFFFF; // 32 bits
-        //unsigned int runN   = (header >> 56) & 0x3F      ; // 6 bits
-        //unsigned int error  = (header >> 62) & 0x1       ; // 1
-        //unsigned int validH = (header >> 63) & 0x3       ; // 2 bits
 
         // Print header quantities
         std::cout << "*** itest " << itest << " / ntest " << ntest \
-                  << " (npuppiA = " << npuppis[0] << ", npuppiB = " << npuppis[1] << ", npuppiC = " << npuppis[2] << ", npuppiD = " << npuppis[3] << ")" << std::endl;
+                  << " (run " << event.run << ", orbit " << event.orbit << ", bx " << event.bx \
+                  << ", npuppiA = " << npuppis[0] << ", npuppiB = " << npuppis[1] << ", npuppiC = " << npuppis[2] << ", npuppiD = " << npuppis[3] << ")" << std::endl;
         if (HEADER_DEBUG)
         {
             for (int i = 0; i < NLINKS; i++)
             {
-                std::cout << " - header" << i << ": " << std::bitset<64>(headers[i]) << " : " << headers[i] << std::endl;
-                std::cout << " - npuppi" << i << ": " << std::bitset<64>(npuppis[i]) << " : " << npuppis[i] << std::endl;
+                const DumpHeader & header = event.link(i).header;
+                std::cout << " - header" << i << ": " << std::bitset<64>(header.word) << " : " << header.word << std::endl;
+                std::cout << "   npuppi " << header.npuppi() << ", beZero " << header.beZero() << ", bx " << header.bx() << ", orbit " << header.orbit()
+                          << ", run " << header.run() << ", error " << header.error() << ", valid " << header.valid() << std::endl;
             }
-            //std::cout << " - beZero: " << std::bitset<64>(beZero) << " : " << beZero << std::endl;
-            //std::cout << " - bxNum : " << std::bitset<64>(bxNum)  << " : " << bxNum  << std::endl;
-            //std::cout << " - orbitN: " << std::bitset<64>(orbitN) << " : " << orbitN << std::endl;
-            //std::cout << " - runN  : " << std::bitset<64>(runN  ) << " : " << runN   << std::endl;
-            //std::cout << " - error : " << std::bitset<64>(error ) << " : " << error  << std::endl;
-            //std::cout << " - validH: " << std::bitset<64>(validH) << " : " << validH << std::endl;
         }
 
-        // Minimal asserts on npuppi to guarantee correct reading of fstream
-        for (int i = 0; i < NLINKS; i++)
+        // Incomplete events (missing fragments, error bits or too many candidates) are not processed
+        if (!event.complete())
         {
-            assert(npuppis[i] <= NPUPPI_LINK);
+            std::cout << "     Incomplete event: missing links 0x" << std::hex << event.missing << ", error links 0x" << event.error << std::dec << std::endl;
+            continue;
         }
 
         // Declare data vectors for buffering input fstreams
@@ -117,17 +92,14 @@ int main(int argc, char **argv) {
             inData[i] = std::vector<uint64_t>(NPUPPI_LINK, 0);
         }
 
-        // Read actual data and store it in uint64_t vectors
+        // Copy actual data in uint64_t vectors (the rest is zero-padded)
         for (int j = 0; j < NLINKS; j++)
         {
-            for (int i = 0; i < npuppis[j]; ++i)
-            {
-                inFstreams[j].read(reinterpret_cast<char *>(&inData[j][i]), sizeof(uint64_t));
-            }
+            std::copy(event.link(j).begin(), event.link(j).end(), inData[j].begin());
         }
 
         // Copy data in firmware-input streams
-        hls::stream<uint64_t> inFifo[NLINKS];
+        w3p_stream<uint64_t> inFifo[NLINKS];
         for (int j = 0; j < NLINKS; j++)
         {
             for (int i = 0; i < NPUPPI_LINK; i++)
@@ -139,12 +111,12 @@ int main(int argc, char **argv) {
         if (DUT == 1)
         {
             // Output declaration
-            hls::stream<Puppi> outFifo[NLINKS];
-            std::vector<Puppi> out_fwr[NLINKS];
+            w3p_stream<PuppiFrame> outFifo;
+            std::vector<Puppi> out_fwr(NPUPPI_SEL);
             std::vector<Puppi> out_ref[NLINKS];
+            std::vector<Puppi> sel_ref;
             for (int i = 0; i < NLINKS; i++)
             {
-                out_fwr[i].resize(NPUPPI_LINK);
                 out_ref[i].resize(NPUPPI_LINK);
             }
 
@@ -152,14 +124,17 @@ int main(int argc, char **argv) {
             w3p_streamer(inFifo, outFifo);
 
             // Reference call
-            w3p_emulator(inData, out_ref);
+            w3p_emulator(inData, out_ref, sel_ref);
 
             // Copy data from output firmware stream into output vector for checks and printout
-            for (int j = 0; j < NLINKS; j++)
+            for (int i = 0; i < NPUPPI_SEL; i++)
             {
-                for (int i = 0; i < NPUPPI_LINK; i++)
+                PuppiFrame frame = outFifo.read();
+                out_fwr.at(i) = frame.puppi;
+                if (frame.last != (i == NPUPPI_SEL-1))
                 {
-                    outFifo[j] >> out_fwr[j].at(i);
+                    std::cout << "     Wrong event framing at i: " << i << std::endl;
+                    return 1;
                 }
             }
 
@@ -169,27 +144,35 @@ int main(int argc, char **argv) {
                 std::cout << "- Streamer:" << std::endl;
                 for (int i = 0; i < NLINKS; i++)
                 {
-                    std::cout << "  FW"  << i <<" :"; printVector<Puppi>(out_fwr[i]);
                     std::cout << "  REF" << i << ":"; printVector<Puppi>(out_ref[i]);
-
                 }
+                std::cout << "  FW  SEL:"; printVector<Puppi>(out_fwr);
+                std::cout << "  REF SEL:"; printVector<Puppi>(sel_ref);
             }
 
-            // Test firmware vs reference
-            // FIXME: temporarily commented out because sorting in firmware and emulator does not take into account puppi with same pT
-            //for (int j = 0; j < NLINKS; j++)
-            //{
-            //    std::cout << "---> LINK: " << j << std::endl;
-            //    for (unsigned int i = 0; i < NPUPPI_LINK; i++)
-            //    {
-            //        if (out_fwr[j][i] != out_ref[j][i])
-            //        {
-            //            std::cout << "     Different Puppi at i: " << i << " -> FW: " << out_fwr[j][i] << " REF: " << out_ref[j][i] << std::endl;
-            //            return 1;
-            //        }
-            //    }
-            //}
+            // Test selected candidates
+            // With the key-index sort the candidates with the same pT are ordered by link and index,
+            // as by std::stable_sort in the emulator: the candidates must be identical. Otherwise
+            // only the pT sequence is independent of the ordering of candidates with same pT.
+            for (unsigned int i = 0; i < NPUPPI_SEL; i++)
+            {
+                bool same = W3P_KEY_SORT ? (out_fwr[i].pack() == sel_ref[i].pack()) : (out_fwr[i].hwPt == sel_ref[i].hwPt);
+                if (!same)
+                {
+                    std::cout << "     Different selected Puppi at i: " << i << " -> FW: " << out_fwr[i] << " REF: " << sel_ref[i] << std::endl;
+                    return 1;
+                }
+            }
         }
     } // end loop on NTEST
+
+#ifdef W3P_THREADED_DATAFLOW
+    // Occupancy and stalls of the internal streams, to size their depth
+    w3p_dataflow::print_stream_stats();
+#endif
+#ifdef W3P_STAGE_STATS
+    // Per-stage counters and timing of the emulator
+    w3p_stats::print_stats();
+#endif
     return 0;
 }
@@ -0,0 +1,136 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "puppi_soa.h"
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/**************************************************
+ * Minimal microbenchmark harness for the kernels and the CPU references
+ *
+ * BenchSuite::run(name, input, nevents, f) calls f(ievt) on all the events, repeat times
+ * after one warm-up pass, and times every group of `batch` consecutive events (batch > 1
+ * for kernels of a few ns, below the resolution of the clock). For each benchmark:
+ *  - a line of the table on stdout: ns/event (mean), events/s, percentiles of the samples
+ *  - optionally one JSON object per line (JSON Lines) in the output file, with the same
+ *    numbers plus the suite and the types (ap or native), to diff results across commits
+ * Synthetic events are packed 64-bit words (same layout as the dump files), so they can be
+ * fed to PuppiEventSoA::unpack as the events of the dumps.
+ **************************************************/
+
+namespace w3p_bench {
+
+    // Keep a result alive without adding work to the timed code
+    template<typename T>
+    inline void do_not_optimize(const T & value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+#ifdef W3P_NATIVE_TYPES
+    static constexpr const char * TYPES = "native";
+#else
+    static constexpr const char * TYPES = "ap";
+#endif
+
+    struct BenchResult {
+        std::string name, input;
+        size_t samples = 0;
+        unsigned int batch = 1;
+        double mean_ns = 0, p50_ns = 0, p90_ns = 0, p99_ns = 0, min_ns = 0, max_ns = 0;
+        double events_per_s() const { return mean_ns > 0 ? 1e9 / mean_ns : 0; }
+    };
+
+    class BenchSuite {
+      public:
+        BenchSuite(const std::string & suite, unsigned int repeat, const std::string & json_name) :
+            suite_(suite), repeat_(repeat ? repeat : 1), json_(json_name.empty() ? nullptr : fopen(json_name.c_str(), "w"))
+        {
+            if (!json_name.empty() && !json_) printf("Cannot open %s, no JSON output\n", json_name.c_str());
+            printf("%-40s %-10s %10s %12s %10s %10s %10s %10s\n", "benchmark", "input", "ns/event", "events/s", "p50 ns", "p90 ns", "p99 ns", "max ns");
+        }
+        ~BenchSuite() { if (json_) fclose(json_); }
+
+        template<typename F>
+        BenchResult run(const std::string & name, const std::string & input, size_t nevents, F && f, unsigned int batch = 1)
+        {
+            BenchResult r;
+            r.name = name;
+            r.input = input;
+            r.batch = batch ? batch : 1;
+            if (nevents == 0) return r;
+
+            // Warm-up
+            for (size_t ievt = 0; ievt < nevents; ++ievt) f(ievt);
+
+            std::vector<double> samples;
+            samples.reserve(repeat_ * (nevents + r.batch - 1) / r.batch);
+            double total = 0;
+            for (unsigned int irep = 0; irep < repeat_; ++irep)
+                for (size_t first = 0; first < nevents; first += r.batch)
+                {
+                    size_t last = std::min(nevents, first + r.batch);
+                    auto start = std::chrono::steady_clock::now();
+                    for (size_t ievt = first; ievt < last; ++ievt) f(ievt);
+                    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                    samples.push_back(elapsed.count() / (last - first));
+                    total += elapsed.count();
+                }
+
+            std::sort(samples.begin(), samples.end());
+            auto percentile = [&](double p) { return samples[std::min(samples.size() - 1, size_t(p * samples.size()))]; };
+            r.samples = samples.size();
+            r.mean_ns = total / (double(repeat_) * nevents);
+            r.p50_ns = percentile(0.50);
+            r.p90_ns = percentile(0.90);
+            r.p99_ns = percentile(0.99);
+            r.min_ns = samples.front();
+            r.max_ns = samples.back();
+            print(r);
+            return r;
+        }
+
+      private:
+        void print(const BenchResult & r)
+        {
+            printf("%-40s %-10s %10.1f %12.0f %10.1f %10.1f %10.1f %10.1f\n", r.name.c_str(), r.input.c_str(),
+                   r.mean_ns, r.events_per_s(), r.p50_ns, r.p90_ns, r.p99_ns, r.max_ns);
+            if (json_)
+            {
+                fprintf(json_, "{\"suite\": \"%s\", \"benchmark\": \"%s\", \"input\": \"%s\", \"types\": \"%s\", \"samples\": %zu, \"batch\": %u, "
+                               "\"ns_per_event\": %.2f, \"events_per_s\": %.1f, \"p50_ns\": %.2f, \"p90_ns\": %.2f, \"p99_ns\": %.2f, "
+                               "\"min_ns\": %.2f, \"max_ns\": %.2f}\n",
+                        suite_.c_str(), r.name.c_str(), r.input.c_str(), TYPES, r.samples, r.batch,
+                        r.mean_ns, r.events_per_s(), r.p50_ns, r.p90_ns, r.p99_ns, r.min_ns, r.max_ns);
+                fflush(json_);
+            }
+        }
+
+        std::string suite_;
+        unsigned int repeat_;
+        FILE * json_;
+    };
+
+    // Synthetic event of npuppi packed candidates: falling pT spectrum (mean ~2 GeV, up to
+    // ~100 GeV), |eta| < 4, uniform phi, ID and z0
+    inline void synthetic_event(std::mt19937 & rng, unsigned int npuppi, std::vector<uint64_t> & words)
+    {
+        using namespace puppi_soa;
+        std::exponential_distribution<double> pt(0.5);
+        std::uniform_int_distribution<int> eta(-917, 917), phi(-720, 719), id(0, 7), z0(-512, 511);
+        auto bits = [](int v, int n) { return uint64_t(v) & ((uint64_t(1) << n) - 1); };
+        words.resize(npuppi);
+        for (unsigned int i = 0; i < npuppi; ++i)
+        {
+            int rawpt = std::min(int(std::lround(std::min(pt(rng), 100.) * 4)), (1 << PT_BITS) - 1);
+            words[i] = (bits(rawpt, PT_BITS) << PT_LOW) | (bits(eta(rng), ETA_BITS) << ETA_LOW) | (bits(phi(rng), PHI_BITS) << PHI_LOW) |
+                       (bits(id(rng), ID_BITS) << ID_LOW) | (bits(z0(rng), Z0_BITS) << Z0_LOW);
+        }
+    }
+
+} // namespace
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef COSCOSH_LUT_H
+#define COSCOSH_LUT_H
+
+#include <cstdint>
+
+/**************************************************
+ * Compile-time cos/cosh lookup tables for the triplet invariant mass
+ *
+ * Table<T,N>::v[i] = round(f(i*step) * lsb), with f = cos or cosh, evaluated by constexpr
+ * Taylor series (converged to double precision for |x| < 5), so that the tables are
+ * plain constants for both the C++ compiler and the HLS front-end.
+ **************************************************/
+
+namespace coscosh {
+
+    // sum_n (+/-x^2)^n / (2n)! : cosh(x) or cos(x)
+    constexpr double series(double x, bool hyperbolic) {
+        double term = 1, sum = 1;
+        for (int n = 1; n <= 20; ++n) {
+            term *= (hyperbolic ? x*x : -x*x) / ((2*n-1)*(2*n));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr int roundInt(double x) { return x >= 0 ? int(x + 0.5) : -int(-x + 0.5); }
+
+    template<typename T, int N>
+    struct Table {
+        T v[N];
+    };
+
+    template<typename T, int N>
+    constexpr Table<T,N> makeTable(double step, int lsb, bool hyperbolic) {
+        Table<T,N> t{};
+        for (int i = 0; i < N; ++i)
+            t.v[i] = roundInt(series(i*step, hyperbolic) * lsb);
+        return t;
+    }
+
+} // namespace
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef DUMP_READER_H
+#define DUMP_READER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**************************************************
+ * Memory-mapped reader for the Puppi .dump format
+ *
+ * A dump file is a sequence of little-endian 64-bit words: for each event one header
+ * followed by npuppi packed Puppi candidates. The file is mapped read-only and indexed
+ * in a single pass over the headers, then each event is handed out as a zero-copy
+ * view on the mapped words.
+ *
+ * Header quantities
+ * bits     size    meaning
+ * 63-62    2       10 = valid event header
+ * 61       1       error bit
+ * 60-56    5       (local) run number
+ * 55-24    32      orbit number
+ * 23-12    12      bunch crossing number (0-3563)
+ * 11-08    4       must be set to 0
+ * 07-00    8       number of Puppi candidates
+ **************************************************/
+
+// Decoded event header
+struct DumpHeader {
+    uint64_t word;
+
+    DumpHeader(uint64_t w = 0) : word(w) {}
+    unsigned int npuppi() const { return  word        & 0xFF;       }
+    unsigned int beZero() const { return (word >> 8)  & 0xF;        }
+    unsigned int bx()     const { return (word >> 12) & 0xFFF;      }
+    unsigned int orbit()  const { return (word >> 24) & 0xFFFFFFFF; }
+    unsigned int run()    const { return (word >> 56) & 0x1F;       }
+    bool error()          const { return (word >> 61) & 0x1;        }
+    bool valid()          const { return ((word >> 62) & 0x3) == 0x2; }
+};
+
+// View on one event of the mapped file
+struct DumpEvent {
+    DumpHeader header;
+    const uint64_t * data;      // npuppi packed candidates, valid while the reader is open
+
+    unsigned int npuppi() const { return header.npuppi(); }
+    const uint64_t * begin() const { return data; }
+    const uint64_t * end() const { return data + npuppi(); }
+};
+
+// Half-open range of event indexes [begin, end)
+struct DumpRange {
+    size_t begin, end;
+    size_t size() const { return end - begin; }
+};
+
+class DumpReader {
+  public:
+    DumpReader() {}
+    explicit DumpReader(const std::string & name) { open(name); }
+    ~DumpReader() { close(); }
+
+    DumpReader(const DumpReader &) = delete;
+    DumpReader & operator=(const DumpReader &) = delete;
+    DumpReader(DumpReader && o) { *this = std::move(o); }
+    DumpReader & operator=(DumpReader && o)
+    {
+        if (this != &o)
+        {
+            close();
+            name_ = std::move(o.name_);
+            words_ = o.words_; nwords_ = o.nwords_; truncated_ = o.truncated_;
+            offsets_ = std::move(o.offsets_);
+            o.words_ = nullptr; o.nwords_ = 0; o.truncated_ = false;
+        }
+        return *this;
+    }
+
+    // Map the file and build the event index. Returns false if the file cannot be mapped.
+    bool open(const std::string & name)
+    {
+        close();
+        name_ = name;
+
+        int fd = ::open(name.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        nwords_ = st.st_size / sizeof(uint64_t);
+        if (nwords_ > 0)
+        {
+            void * addr = mmap(nullptr, nwords_*sizeof(uint64_t), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) { ::close(fd); nwords_ = 0; return false; }
+            madvise(addr, nwords_*sizeof(uint64_t), MADV_SEQUENTIAL);
+            words_ = static_cast<const uint64_t *>(addr);
+        }
+        ::close(fd);
+
+        // Single pass on the headers: each one tells how many words to skip to the next
+        for (size_t pos = 0; pos < nwords_; pos += 1 + (words_[pos] & 0xFF))
+        {
+            if (pos + 1 + (words_[pos] & 0xFF) > nwords_)
+            {
+                truncated_ = true;
+                break;
+            }
+            offsets_.push_back(pos);
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (words_) munmap(const_cast<uint64_t *>(words_), nwords_*sizeof(uint64_t));
+        words_ = nullptr;
+        nwords_ = 0;
+        truncated_ = false;
+        offsets_.clear();
+    }
+
+    bool good() const { return words_ != nullptr; }
+    const std::string & name() const { return name_; }
+    // True if the last event of the file is incomplete (it is not indexed)
+    bool truncated() const { return truncated_; }
+
+    // Number of complete events in the file
+    size_t size() const { return offsets_.size(); }
+
+    // Random access to one event
+    DumpEvent event(size_t i) const
+    {
+        const uint64_t * h = words_ + offsets_[i];
+        return DumpEvent{DumpHeader(*h), h + 1};
+    }
+    DumpEvent operator[](size_t i) const { return event(i); }
+
+    // Split the events in nranges contiguous ranges of (almost) equal size
+    std::vector<DumpRange> split(size_t nranges) const
+    {
+        std::vector<DumpRange> ranges;
+        for (size_t r = 0; r < nranges; ++r)
+            ranges.push_back({r*size()/nranges, (r+1)*size()/nranges});
+        return ranges;
+    }
+
+    // Split the events in contiguous ranges of grain events (the last one may be shorter)
+    std::vector<DumpRange> chunks(size_t grain) const
+    {
+        std::vector<DumpRange> ranges;
+        for (size_t b = 0; b < size(); b += grain)
+            ranges.push_back({b, b + grain < size() ? b + grain : size()});
+        return ranges;
+    }
+
+    // Split the events in orbits: contiguous ranges of events with the same run and orbit
+    // numbers, of at most max_events events (an orbit has 3564 bunch crossings; files without
+    // orbit numbers are one orbit split in ranges of max_events)
+    std::vector<DumpRange> orbits(size_t max_events = 3564) const
+    {
+        std::vector<DumpRange> ranges;
+        for (size_t b = 0; b < size(); )
+        {
+            DumpHeader first = event(b).header;
+            size_t e = b + 1;
+            while (e < size() && e - b < max_events)
+            {
+                DumpHeader h = event(e).header;
+                if (h.run() != first.run() || h.orbit() != first.orbit()) break;
+                ++e;
+            }
+            ranges.push_back({b, e});
+            b = e;
+        }
+        return ranges;
+    }
+
+  private:
+    std::string name_;
+    const uint64_t * words_ = nullptr;
+    size_t nwords_ = 0;
+    bool truncated_ = false;
+    std::vector<size_t> offsets_;
+};
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef EVENT_BUILDER_H
+#define EVENT_BUILDER_H
+
+#include "dump_reader.h"
+#include "spsc_stream.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**************************************************
+ * Event builder of the NL links of the streamer, one .dump file per link
+ *
+ * The fragments of the links are aligned on the (run, orbit, bx) of their headers: each
+ * event gets the fragments with the lowest (run, orbit, bx) among the next fragment of each
+ * link, so the links may have missing fragments, but each link must be in (run, orbit, bx)
+ * order (fragments with the same key are taken in file order, one per event). For each event:
+ *  - missing: links without a fragment of this (run, orbit, bx), empty in the event
+ *  - error: links whose fragment has the error bit, an invalid header (valid bits, bits 11-8
+ *    not zero) or more than max_npuppi candidates; the fragment is in the event anyway
+ *  - complete(): no missing nor error fragment
+ * The fragments are zero-copy views on the mapped files (see dump_reader.h).
+ *
+ * The events are built by next(). With readahead > 0 one thread per link reads ahead up to
+ * readahead fragments, touching their words so that the page faults are taken there, and
+ * passes their indexes to next() (blocking reads). Both give the same events; on the bundled
+ * and synthetic links (event_builder_report.cc) the read-ahead is not faster than reading the
+ * mapped files directly, hence the default readahead = 0.
+ **************************************************/
+
+// Fragment of one link in an event
+struct LinkFragment {
+    DumpEvent event = DumpEvent{DumpHeader(), nullptr};
+    bool end = false; // no more fragments in the link
+
+    // (run, orbit, bx) as one ordered integer
+    uint64_t key() const { return (uint64_t(event.header.run()) << 44) | (uint64_t(event.header.orbit()) << 12) | event.header.bx(); }
+};
+
+template<int NL>
+struct LinkEvent {
+    unsigned int run = 0, orbit = 0, bx = 0;
+    uint64_t index = 0;         // events built before this one
+    LinkFragment links[NL];     // npuppi = 0 for the missing links
+    uint32_t missing = 0;       // bit l: no fragment of link l
+    uint32_t error = 0;         // bit l: fragment of link l with an error (see above)
+    bool end = false;           // no more events (internal)
+
+    bool complete() const { return !missing && !error; }
+    const DumpEvent & link(int l) const { return links[l].event; }
+};
+
+template<int NL>
+struct EventBuilderStats {
+    uint64_t events = 0, complete = 0;
+    uint64_t fragments[NL] = {}, missing[NL] = {}, error[NL] = {};
+    uint64_t unordered[NL] = {}; // fragments with a lower (run, orbit, bx) than the previous one of the link
+};
+
+template<int NL>
+class EventBuilder {
+  public:
+    static_assert(NL <= 32, "EventBuilder: at most 32 links");
+
+    EventBuilder(const std::vector<std::string> & names, unsigned int max_npuppi, unsigned int readahead = 0) :
+        max_npuppi_(max_npuppi), readahead_(readahead)
+    {
+        good_ = (names.size() == NL);
+        for (int l = 0; l < NL && good_; l++)
+            good_ = readers_[l].open(names[l]);
+        if (good_ && readahead_ > 0) start();
+    }
+    ~EventBuilder()
+    {
+        stop_ = true;
+        region_.join();
+    }
+    EventBuilder(const EventBuilder &) = delete;
+    EventBuilder & operator=(const EventBuilder &) = delete;
+
+    // All the files are mapped
+    bool good() const { return good_; }
+    const DumpReader & reader(int l) const { return readers_[l]; }
+
+    // Next event, false at the end of all the links
+    bool next(LinkEvent<NL> & event)
+    {
+        if (!good_ || done_) return false;
+        if (readahead_ > 0) build(event, [this](int l) { return fragment(l, fragments_[l].read()); });
+        else build(event, [this](int l) { return fragment(l, pos_[l] < readers_[l].size() ? pos_[l]++ : pos_[l]); });
+        done_ = event.end;
+        return !done_;
+    }
+
+    // Counts of the events returned by next()
+    const EventBuilderStats<NL> & stats() const { return stats_; }
+
+  private:
+    // Fragment i of link l (end of the link if i is past the last fragment)
+    LinkFragment fragment(int l, size_t i) const
+    {
+        LinkFragment f;
+        if (i < readers_[l].size()) f.event = readers_[l].event(i);
+        else f.end = true;
+        return f;
+    }
+
+    // Align the next fragment of each link, fetch(l) gives the next fragment of link l
+    template<typename Fetch>
+    void build(LinkEvent<NL> & event, Fetch fetch)
+    {
+        event = LinkEvent<NL>();
+        for (int l = 0; l < NL; l++)
+            if (!loaded_[l]) { head_[l] = fetch(l); loaded_[l] = true; }
+
+        bool any = false;
+        uint64_t key = ~uint64_t(0);
+        for (int l = 0; l < NL; l++)
+            if (!head_[l].end) { any = true; key = std::min(key, head_[l].key()); }
+        if (!any) { event.end = true; return; }
+
+        event.index = stats_.events++;
+        for (int l = 0; l < NL; l++)
+        {
+            if (head_[l].end || head_[l].key() != key)
+            {
+                event.missing |= (1u << l);
+                stats_.missing[l]++;
+                continue;
+            }
+            const DumpHeader & h = head_[l].event.header;
+            event.links[l] = head_[l];
+            event.run = h.run(); event.orbit = h.orbit(); event.bx = h.bx();
+            if (!h.valid() || h.error() || h.beZero() != 0 || h.npuppi() > max_npuppi_)
+            {
+                event.error |= (1u << l);
+                stats_.error[l]++;
+            }
+            if (stats_.fragments[l] > 0 && key < last_[l]) stats_.unordered[l]++;
+            stats_.fragments[l]++;
+            last_[l] = key;
+            loaded_[l] = false;
+        }
+        if (event.complete()) stats_.complete++;
+    }
+
+    // Read-ahead threads, one per link: the indexes of the fragments, then the end index
+    void start()
+    {
+        for (int l = 0; l < NL; l++)
+        {
+            fragments_[l].configure("event_builder.link[" + std::to_string(l) + "]", readahead_);
+            region_.spawn([this, l]() {
+                const DumpReader & reader = readers_[l];
+                for (size_t i = 0; i < reader.size(); i++)
+                {
+                    // Touch the candidates now, not in the consumer
+                    DumpEvent e = reader.event(i);
+                    volatile uint64_t sink = e.header.word;
+                    if (e.npuppi()) sink = e.data[e.npuppi() - 1];
+                    (void) sink;
+                    if (!put(fragments_[l], i)) return;
+                }
+                put(fragments_[l], reader.size());
+            });
+        }
+    }
+
+    // Blocking write that gives up when the builder is destroyed
+    template<typename T>
+    bool put(w3p_dataflow::stream<T> & s, const T & value)
+    {
+        for (unsigned int spin = 0; !s.write_nb(value); ++spin)
+        {
+            if (stop_) return false;
+            w3p_dataflow::backoff(spin);
+        }
+        return true;
+    }
+
+    DumpReader readers_[NL];
+    unsigned int max_npuppi_, readahead_;
+    bool good_ = false, done_ = false;
+
+    // Alignment state
+    size_t pos_[NL] = {};  // next fragment of each link, without readahead
+    LinkFragment head_[NL];
+    bool loaded_[NL] = {};
+    uint64_t last_[NL] = {};
+    EventBuilderStats<NL> stats_;
+
+    w3p_dataflow::stream<size_t> fragments_[NL];
+    std::atomic<bool> stop_{false};
+    w3p_dataflow::Region region_;
+};
+
+#endif
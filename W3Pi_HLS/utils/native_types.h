@@ -0,0 +1,310 @@
+#ifndef NATIVE_TYPES_H
+#define NATIVE_TYPES_H
+
+#include "ap_int.h"
+#include "ap_fixed.h"
+#include <cstdint>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+/**************************************************
+ * Native-integer replacements of ap_int/ap_uint/ap_fixed/ap_ufixed for fast C-simulation
+ *
+ * Values are kept in a plain int64_t, normalized to the declared width after every
+ * operation, so that the arithmetic is bit-exact with the ap_types:
+ *  - +, -, *, / return the same full-precision widths as the ap_types
+ *    (minus is always signed, division keeps the dividend fraction bits)
+ *  - assignments wrap (AP_WRAP) or saturate (AP_SAT), after truncating (AP_TRN) or
+ *    rounding half towards plus infinity (AP_RND) the dropped fraction bits
+ *  - range selection x(hi,lo) reads and writes the raw bits
+ * Only what the W3Pi kernels need is implemented: widths up to 63 bits (64 if signed),
+ * non-negative number of fraction bits, quantization AP_TRN/AP_RND and overflow AP_WRAP/AP_SAT.
+ * Not meant for synthesis: use w3p_types.h to select between these and the ap_types.
+ **************************************************/
+
+namespace native {
+
+    static constexpr int cap(int w) { return w > 64 ? 64 : w; }
+    static constexpr int max(int a, int b) { return a > b ? a : b; }
+
+    inline uint64_t mask(int w) { return w >= 64 ? ~uint64_t(0) : (uint64_t(1) << w) - 1; }
+
+    // Wrap x to W bits (sign-extended if S)
+    template<int W, bool S>
+    inline int64_t wrap(int64_t x)
+    {
+        constexpr int shift = W >= 64 ? 0 : 64 - W;
+        if (S) return int64_t(uint64_t(x) << shift) >> shift;
+        return int64_t(uint64_t(x) & mask(W));
+    }
+
+    // Raw bits [h,l] of a native value
+    template<typename T>
+    struct range_ref {
+        T & x;
+        int h, l;
+
+        range_ref(T & x_, int h_, int l_) : x(x_), h(h_), l(l_) {}
+        uint64_t get() const { return (x.raw_bits() >> l) & mask(h-l+1); }
+        void set(uint64_t v)
+        {
+            uint64_t m = mask(h-l+1) << l;
+            x.set_raw_bits((x.raw_bits() & ~m) | ((v << l) & m));
+        }
+
+        operator uint64_t() const { return get(); }
+        unsigned int to_uint() const { return get(); }
+        int to_int() const { return get(); }
+        uint64_t to_uint64() const { return get(); }
+
+        range_ref & operator=(uint64_t v) { set(v); return *this; }
+        range_ref & operator=(const range_ref & r) { set(r.get()); return *this; }
+        // Range of another native or ap type
+        template<typename R>
+        auto operator=(const R & r) -> decltype(r.to_uint64(), *this) { set(r.to_uint64()); return *this; }
+    };
+
+    /*********************************************
+    *             Integers                       *
+    *********************************************/
+    template<int W, bool S>
+    struct int_base {
+        static_assert(W <= 64 && (S || W < 64), "native int: unsupported width");
+        static constexpr int width = W;
+        static constexpr bool sign_flag = S;
+        int64_t V;
+
+        int_base() : V(0) {}
+        template<int W2, bool S2> int_base(const int_base<W2,S2> & o) : V(wrap<W,S>(o.V)) {}
+        template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        int_base(T v) : V(wrap<W,S>(int64_t(v))) {}
+        int_base(double v) : V(wrap<W,S>(int64_t(std::floor(v)))) {}
+        int_base(float v) : int_base(double(v)) {}
+
+        uint64_t raw_bits() const { return uint64_t(V) & mask(W); }
+        void set_raw_bits(uint64_t b) { V = wrap<W,S>(int64_t(b)); }
+        range_ref<int_base> operator()(int h, int l) { return range_ref<int_base>(*this, h, l); }
+        range_ref<int_base> operator()(int h, int l) const { return range_ref<int_base>(const_cast<int_base &>(*this), h, l); }
+        range_ref<int_base> range(int h, int l) { return (*this)(h, l); }
+        bool operator[](int i) const { return (raw_bits() >> i) & 1; }
+
+        operator long long() const { return V; }
+        int to_int() const { return V; }
+        unsigned int to_uint() const { return V; }
+        long long to_int64() const { return V; }
+        unsigned long long to_uint64() const { return V; }
+        double to_double() const { return V; }
+        float to_float() const { return V; }
+        int length() const { return W; }
+
+        template<typename T> int_base & operator+=(T o) { V = wrap<W,S>(V + int64_t(o)); return *this; }
+        template<typename T> int_base & operator-=(T o) { V = wrap<W,S>(V - int64_t(o)); return *this; }
+        template<typename T> int_base & operator*=(T o) { V = wrap<W,S>(V * int64_t(o)); return *this; }
+        int_base & operator++() { V = wrap<W,S>(V + 1); return *this; }
+        int_base & operator--() { V = wrap<W,S>(V - 1); return *this; }
+        int_base operator++(int) { int_base t = *this; ++*this; return t; }
+        int_base operator--(int) { int_base t = *this; --*this; return t; }
+        int_base<cap(W+1),true> operator-() const { int_base<cap(W+1),true> r; r.V = -V; return r; }
+        bool operator!() const { return V == 0; }
+    };
+
+    template<int W> struct int_t : int_base<W,true> {
+        int_t() {}
+        template<typename T> int_t(T v) : int_base<W,true>(v) {}
+    };
+    template<int W> struct uint_t : int_base<W,false> {
+        uint_t() {}
+        template<typename T> uint_t(T v) : int_base<W,false>(v) {}
+    };
+
+    // C integers behave as ap_int_base of their size
+    template<typename T> struct ctype {
+        typedef int_base<(std::is_same<T,bool>::value ? 1 : 8*sizeof(T)), std::is_signed<T>::value> type;
+    };
+
+    #define NATIVE_PLUS_W  cap(max(W1 + (S2 && !S1), W2 + (S1 && !S2)) + 1)
+    #define NATIVE_INT_BINOP(OP, RW, RS) \
+    template<int W1, bool S1, int W2, bool S2> \
+    int_base<RW, RS> operator OP(const int_base<W1,S1> & a, const int_base<W2,S2> & b) { int_base<RW, RS> r; r.V = wrap<RW, RS>(a.V OP b.V); return r; } \
+    template<int W1, bool S1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> \
+    auto operator OP(const int_base<W1,S1> & a, T b) -> decltype(a OP typename ctype<T>::type(b)) { return a OP typename ctype<T>::type(b); } \
+    template<int W1, bool S1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> \
+    auto operator OP(T b, const int_base<W1,S1> & a) -> decltype(typename ctype<T>::type(b) OP a) { return typename ctype<T>::type(b) OP a; }
+    NATIVE_INT_BINOP(+, NATIVE_PLUS_W, S1 || S2)
+    NATIVE_INT_BINOP(-, NATIVE_PLUS_W, true)
+    NATIVE_INT_BINOP(*, cap(W1 + W2), S1 || S2)
+    NATIVE_INT_BINOP(&, max(W1, W2), S1 && S2)
+    NATIVE_INT_BINOP(|, max(W1, W2), S1 || S2)
+    NATIVE_INT_BINOP(^, max(W1, W2), S1 || S2)
+
+    template<int W1, bool S1> int_base<W1,S1> operator>>(const int_base<W1,S1> & a, int s) { int_base<W1,S1> r; r.V = a.V >> s; return r; }
+    template<int W1, bool S1> int_base<W1,S1> operator<<(const int_base<W1,S1> & a, int s) { int_base<W1,S1> r; r.V = wrap<W1,S1>(a.V << s); return r; }
+
+    #define NATIVE_INT_RELOP(OP) \
+    template<int W1, bool S1, int W2, bool S2> bool operator OP(const int_base<W1,S1> & a, const int_base<W2,S2> & b) { return a.V OP b.V; } \
+    template<int W1, bool S1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> bool operator OP(const int_base<W1,S1> & a, T b) { return a.V OP int64_t(b); } \
+    template<int W1, bool S1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> bool operator OP(T b, const int_base<W1,S1> & a) { return int64_t(b) OP a.V; } \
+    template<int W1, bool S1, typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0> bool operator OP(const int_base<W1,S1> & a, T b) { return double(a.V) OP double(b); } \
+    template<int W1, bool S1, typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0> bool operator OP(T b, const int_base<W1,S1> & a) { return double(b) OP double(a.V); }
+    NATIVE_INT_RELOP(<) NATIVE_INT_RELOP(<=) NATIVE_INT_RELOP(>) NATIVE_INT_RELOP(>=) NATIVE_INT_RELOP(==) NATIVE_INT_RELOP(!=)
+
+    template<int W, bool S> std::ostream & operator<<(std::ostream & os, const int_base<W,S> & a) { return os << (long long)a.V; }
+
+    /*********************************************
+    *             Fixed point                    *
+    *********************************************/
+    template<int W, int I, bool S, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP>
+    struct fixed_base {
+        static_assert(W <= 64 && (S || W < 64) && W >= I, "native fixed: unsupported width");
+        static_assert(Q == AP_TRN || Q == AP_RND, "native fixed: unsupported quantization mode");
+        static_assert(O == AP_WRAP || O == AP_SAT, "native fixed: unsupported overflow mode");
+        static constexpr int width = W;
+        static constexpr int iwidth = I;
+        static constexpr int F = W - I;
+        static constexpr bool sign_flag = S;
+        int64_t V;  // raw value, in units of 2^-F
+
+        // Overflow handling on a raw value with F fraction bits
+        static int64_t overflow(int64_t x)
+        {
+            if (O == AP_SAT)
+            {
+                const int64_t hi = S ? int64_t(mask(W-1)) : int64_t(mask(W));
+                const int64_t lo = S ? -hi - 1 : 0;
+                return x > hi ? hi : (x < lo ? lo : x);
+            }
+            return wrap<W,S>(x);
+        }
+        // Quantization and overflow of a raw value with f2 fraction bits
+        static int64_t from_raw(int64_t x, int f2)
+        {
+            if (f2 > F)
+            {
+                int sh = f2 - F;
+                x = (Q == AP_RND) ? (x + (int64_t(1) << (sh-1))) >> sh : x >> sh;
+            }
+            else
+                x = x << (F - f2);
+            return overflow(x);
+        }
+
+        fixed_base() : V(0) {}
+        template<int W2, int I2, bool S2, ap_q_mode Q2, ap_o_mode O2>
+        fixed_base(const fixed_base<W2,I2,S2,Q2,O2> & o) : V(from_raw(o.V, W2-I2)) {}
+        template<int W2, bool S2>
+        fixed_base(const int_base<W2,S2> & o) : V(from_raw(o.V, 0)) {}
+        template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        fixed_base(T v) : V(from_raw(int64_t(v), 0)) {}
+        fixed_base(double d)
+        {
+            double x = std::ldexp(d, F);
+            V = overflow(int64_t(Q == AP_RND ? std::floor(x + 0.5) : std::floor(x)));
+        }
+        fixed_base(float d) : fixed_base(double(d)) {}
+
+        uint64_t raw_bits() const { return uint64_t(V) & mask(W); }
+        void set_raw_bits(uint64_t b) { V = wrap<W,S>(int64_t(b)); }
+        range_ref<fixed_base> operator()(int h, int l) { return range_ref<fixed_base>(*this, h, l); }
+        range_ref<fixed_base> operator()(int h, int l) const { return range_ref<fixed_base>(const_cast<fixed_base &>(*this), h, l); }
+        range_ref<fixed_base> range(int h, int l) { return (*this)(h, l); }
+
+        double to_double() const { return std::ldexp(double(V), -F); }
+        float to_float() const { return to_double(); }
+        // Integer part, truncated towards zero
+        int to_int() const { return V >= 0 ? (V >> F) : -((-V) >> F); }
+        unsigned int to_uint() const { return to_int(); }
+        int length() const { return W; }
+
+        template<typename T> fixed_base & operator+=(T o) { *this = fixed_base(*this + o); return *this; }
+        template<typename T> fixed_base & operator-=(T o) { *this = fixed_base(*this - o); return *this; }
+        template<typename T> fixed_base & operator*=(T o) { *this = fixed_base(*this * o); return *this; }
+    };
+
+    template<int W, int I, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP>
+    struct fixed_t : fixed_base<W,I,true,Q,O> {
+        fixed_t() {}
+        template<typename T> fixed_t(T v) : fixed_base<W,I,true,Q,O>(v) {}
+    };
+    template<int W, int I, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP>
+    struct ufixed_t : fixed_base<W,I,false,Q,O> {
+        ufixed_t() {}
+        template<typename T> ufixed_t(T v) : fixed_base<W,I,false,Q,O>(v) {}
+    };
+
+    #define NATIVE_FX1 int W1, int I1, bool S1, ap_q_mode Q1, ap_o_mode O1
+    #define NATIVE_FX2 int W2, int I2, bool S2, ap_q_mode Q2, ap_o_mode O2
+    #define NATIVE_FT1 fixed_base<W1,I1,S1,Q1,O1>
+    #define NATIVE_FT2 fixed_base<W2,I2,S2,Q2,O2>
+    #define NATIVE_PLUS_I (max(I1 + (S2 && !S1), I2 + (S1 && !S2)) + 1)
+    #define NATIVE_PLUS_F max(W1-I1, W2-I2)
+    #define NATIVE_DIV_W cap(W1 + max(W2-I2, 0) + S2)
+    #define NATIVE_DIV_I (I1 + (W2-I2) + S2)
+
+    template<NATIVE_FX1, NATIVE_FX2>
+    fixed_base<cap(NATIVE_PLUS_I + NATIVE_PLUS_F), NATIVE_PLUS_I, S1 || S2> operator+(const NATIVE_FT1 & a, const NATIVE_FT2 & b)
+    {
+        fixed_base<cap(NATIVE_PLUS_I + NATIVE_PLUS_F), NATIVE_PLUS_I, S1 || S2> r;
+        r.V = (a.V << (NATIVE_PLUS_F - (W1-I1))) + (b.V << (NATIVE_PLUS_F - (W2-I2)));
+        return r;
+    }
+    template<NATIVE_FX1, NATIVE_FX2>
+    fixed_base<cap(NATIVE_PLUS_I + NATIVE_PLUS_F), NATIVE_PLUS_I, true> operator-(const NATIVE_FT1 & a, const NATIVE_FT2 & b)
+    {
+        fixed_base<cap(NATIVE_PLUS_I + NATIVE_PLUS_F), NATIVE_PLUS_I, true> r;
+        r.V = (a.V << (NATIVE_PLUS_F - (W1-I1))) - (b.V << (NATIVE_PLUS_F - (W2-I2)));
+        return r;
+    }
+    template<NATIVE_FX1, NATIVE_FX2>
+    fixed_base<cap(W1 + W2), I1 + I2, S1 || S2> operator*(const NATIVE_FT1 & a, const NATIVE_FT2 & b)
+    {
+        fixed_base<cap(W1 + W2), I1 + I2, S1 || S2> r;
+        r.V = a.V * b.V;
+        return r;
+    }
+    template<NATIVE_FX1, NATIVE_FX2>
+    fixed_base<NATIVE_DIV_W, NATIVE_DIV_I, S1 || S2> operator/(const NATIVE_FT1 & a, const NATIVE_FT2 & b)
+    {
+        fixed_base<NATIVE_DIV_W, NATIVE_DIV_I, S1 || S2> r;
+        // Division by zero is undefined for the ap_types too: return 0 instead of trapping
+        r.V = b.V == 0 ? 0 : (a.V << max(W2-I2, 0)) / b.V;
+        return r;
+    }
+
+    // Mixed with native and C integers (as fixed with no fraction bits)
+    #define NATIVE_FX_MIX(OP) \
+    template<NATIVE_FX1, int W2, bool S2> auto operator OP(const NATIVE_FT1 & a, const int_base<W2,S2> & b) -> decltype(a OP fixed_base<W2,W2,S2>(b)) { return a OP fixed_base<W2,W2,S2>(b); } \
+    template<NATIVE_FX1, int W2, bool S2> auto operator OP(const int_base<W2,S2> & b, const NATIVE_FT1 & a) -> decltype(fixed_base<W2,W2,S2>(b) OP a) { return fixed_base<W2,W2,S2>(b) OP a; } \
+    template<NATIVE_FX1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> \
+    auto operator OP(const NATIVE_FT1 & a, T b) -> decltype(a OP typename ctype<T>::type(b)) { return a OP typename ctype<T>::type(b); } \
+    template<NATIVE_FX1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> \
+    auto operator OP(T b, const NATIVE_FT1 & a) -> decltype(typename ctype<T>::type(b) OP a) { return typename ctype<T>::type(b) OP a; }
+    NATIVE_FX_MIX(+) NATIVE_FX_MIX(-) NATIVE_FX_MIX(*) NATIVE_FX_MIX(/)
+
+    // Comparisons on aligned raw values
+    template<NATIVE_FX1, NATIVE_FX2>
+    int compare(const NATIVE_FT1 & a, const NATIVE_FT2 & b)
+    {
+        const int F = max(W1-I1, W2-I2);
+        int64_t x = a.V << (F - (W1-I1)), y = b.V << (F - (W2-I2));
+        return x < y ? -1 : (x > y ? 1 : 0);
+    }
+    #define NATIVE_FX_RELOP(OP) \
+    template<NATIVE_FX1, NATIVE_FX2> bool operator OP(const NATIVE_FT1 & a, const NATIVE_FT2 & b) { return compare(a, b) OP 0; } \
+    template<NATIVE_FX1, int W2, bool S2> bool operator OP(const NATIVE_FT1 & a, const int_base<W2,S2> & b) { return compare(a, fixed_base<W2,W2,S2>(b)) OP 0; } \
+    template<NATIVE_FX1, int W2, bool S2> bool operator OP(const int_base<W2,S2> & b, const NATIVE_FT1 & a) { return compare(fixed_base<W2,W2,S2>(b), a) OP 0; } \
+    template<NATIVE_FX1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> \
+    bool operator OP(const NATIVE_FT1 & a, T b) { return compare(a, fixed_base<64,64,true>(int64_t(b))) OP 0; } \
+    template<NATIVE_FX1, typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> \
+    bool operator OP(T b, const NATIVE_FT1 & a) { return compare(fixed_base<64,64,true>(int64_t(b)), a) OP 0; } \
+    template<NATIVE_FX1, typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0> \
+    bool operator OP(const NATIVE_FT1 & a, T b) { return a.to_double() OP double(b); } \
+    template<NATIVE_FX1, typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0> \
+    bool operator OP(T b, const NATIVE_FT1 & a) { return double(b) OP a.to_double(); }
+    NATIVE_FX_RELOP(<) NATIVE_FX_RELOP(<=) NATIVE_FX_RELOP(>) NATIVE_FX_RELOP(>=) NATIVE_FX_RELOP(==) NATIVE_FX_RELOP(!=)
+
+    template<NATIVE_FX1> std::ostream & operator<<(std::ostream & os, const NATIVE_FT1 & a) { return os << a.to_double(); }
+
+} // namespace
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef PUPPI_SOA_H
+#define PUPPI_SOA_H
+
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PUPPI_SOA_X86 1
+#else
+#define PUPPI_SOA_X86 0
+#endif
+
+/**************************************************
+ * Structure-of-arrays container for the Puppi candidates of one event
+ *
+ * Raw hardware integers in contiguous arrays (same bits as the Puppi fields of both
+ * data.h variants), filled with a bulk unpack of the packed 64-bit words:
+ *
+ * bits     field   type
+ * 13-0     pt      uint16_t   raw pt_t bits (LSB = 0.25 GeV)
+ * 25-14    eta     int16_t    sign-extended
+ * 36-26    phi     int16_t    sign-extended
+ * 39-37    id      uint8_t
+ * 49-40    z0      int16_t    sign-extended (zero where the Puppi has no hwZ0)
+ *
+ * The arrays are zero-padded up to a multiple of PUPPI_SOA_PAD, so that vectorized
+ * kernels can always run on full registers (padding candidates have pT = 0).
+ * Adapters convert to any Puppi struct with hwPt/hwEta/hwPhi/hwID (and hwZ0 if present).
+ **************************************************/
+
+#define PUPPI_SOA_PAD 16
+
+namespace puppi_soa {
+
+    // Bit fields of the packed word
+    static constexpr int PT_LOW  = 0,  PT_BITS  = 14;
+    static constexpr int ETA_LOW = 14, ETA_BITS = 12;
+    static constexpr int PHI_LOW = 26, PHI_BITS = 11;
+    static constexpr int ID_LOW  = 37, ID_BITS  = 3;
+    static constexpr int Z0_LOW  = 40, Z0_BITS  = 10;
+
+    inline unsigned int field(uint64_t w, int low, int bits) { return (w >> low) & ((1u << bits) - 1); }
+    inline int sfield(uint64_t w, int low, int bits) { return int32_t(uint32_t(w >> low) << (32-bits)) >> (32-bits); }
+
+    // hwZ0 only exists in the streamer Puppi
+    template<typename P> auto setZ0(P & p, int z0, int) -> decltype(p.hwZ0, void()) { p.hwZ0 = z0; }
+    template<typename P> void setZ0(P &, int, long) {}
+
+#if PUPPI_SOA_X86
+    // Low 32 bits of the 8 words in a (words 0-3) and b (words 4-7), as 8 x 32-bit lanes
+    __attribute__((target("avx2")))
+    inline __m256i low32x8(__m256i a, __m256i b)
+    {
+        const __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+        return _mm256_permute2x128_si256(_mm256_permutevar8x32_epi32(a, idx), _mm256_permutevar8x32_epi32(b, idx), 0x20);
+    }
+
+    // One field of 8 words: shift, then mask (unsigned) or sign-extend (signed)
+    template<int LOW, int BITS, bool SIGNED>
+    __attribute__((target("avx2")))
+    inline __m256i field8(__m256i a, __m256i b)
+    {
+        __m256i x = low32x8(_mm256_srli_epi64(a, LOW), _mm256_srli_epi64(b, LOW));
+        if (SIGNED) return _mm256_srai_epi32(_mm256_slli_epi32(x, 32-BITS), 32-BITS);
+        return _mm256_and_si256(x, _mm256_set1_epi32((1 << BITS) - 1));
+    }
+
+    // Store 8 x 32-bit lanes as 8 x 16 bits
+    __attribute__((target("avx2")))
+    inline void store16x8(void * dst, __m256i x)
+    {
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(x, x), _MM_SHUFFLE(3,1,2,0));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm256_castsi256_si128(p));
+    }
+
+    inline bool has_avx2()
+    {
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+    }
+#endif
+
+} // namespace
+
+template<int NMAX>
+struct PuppiEventSoA {
+    static constexpr int NPADDED = (NMAX + PUPPI_SOA_PAD - 1) / PUPPI_SOA_PAD * PUPPI_SOA_PAD;
+
+    unsigned int n = 0;
+    alignas(64) uint16_t pt[NPADDED];
+    alignas(64) int16_t eta[NPADDED];
+    alignas(64) int16_t phi[NPADDED];
+    alignas(64) int16_t z0[NPADDED];
+    alignas(64) uint8_t id[NPADDED];
+
+    // n rounded up to PUPPI_SOA_PAD
+    unsigned int npadded() const { return (n + PUPPI_SOA_PAD - 1) / PUPPI_SOA_PAD * PUPPI_SOA_PAD; }
+
+    // Bulk unpack of npuppi packed words (npuppi <= NMAX)
+    void unpack(const uint64_t * words, unsigned int npuppi)
+    {
+        n = npuppi;
+        unsigned int i = 0;
+#if PUPPI_SOA_X86
+        if (puppi_soa::has_avx2())
+            i = unpack_avx2(words, npuppi);
+#endif
+        for (; i < npuppi; ++i)
+            unpack_one(i, words[i]);
+        clear_padding();
+    }
+
+    // Scalar unpack of one word in position i
+    void unpack_one(unsigned int i, uint64_t w)
+    {
+        using namespace puppi_soa;
+        pt[i]  = field(w, PT_LOW, PT_BITS);
+        eta[i] = sfield(w, ETA_LOW, ETA_BITS);
+        phi[i] = sfield(w, PHI_LOW, PHI_BITS);
+        id[i]  = field(w, ID_LOW, ID_BITS);
+        z0[i]  = sfield(w, Z0_LOW, Z0_BITS);
+    }
+
+    // Adapters to the Puppi struct of either data.h
+    template<typename P>
+    void get(unsigned int i, P & p) const
+    {
+        p.hwPt(P::pt_t::width-1, 0) = pt[i];
+        p.hwEta = eta[i];
+        p.hwPhi = phi[i];
+        p.hwID  = id[i];
+        puppi_soa::setZ0(p, z0[i], 0);
+    }
+
+    template<typename P>
+    P get(unsigned int i) const
+    {
+        P p;
+        get(i, p);
+        return p;
+    }
+
+    // Fill output[0, n) and clear output[n, nclear)
+    template<typename P>
+    void to_puppi(P output[], unsigned int nclear = 0) const
+    {
+        for (unsigned int i = 0; i < n; ++i)
+            get(i, output[i]);
+        for (unsigned int i = n; i < nclear; ++i)
+            output[i].clear();
+    }
+
+  private:
+    void clear_padding()
+    {
+        for (unsigned int i = n; i < npadded(); ++i)
+        {
+            pt[i] = 0; eta[i] = 0; phi[i] = 0; id[i] = 0; z0[i] = 0;
+        }
+    }
+
+#if PUPPI_SOA_X86
+    // 8 words per iteration, returns the number of unpacked words
+    __attribute__((target("avx2")))
+    unsigned int unpack_avx2(const uint64_t * words, unsigned int npuppi)
+    {
+        using namespace puppi_soa;
+        unsigned int i = 0;
+        for (; i + 8 <= npuppi; i += 8)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i + 4));
+            store16x8(&pt[i],  field8<PT_LOW,  PT_BITS,  false>(a, b));
+            store16x8(&eta[i], field8<ETA_LOW, ETA_BITS, true >(a, b));
+            store16x8(&phi[i], field8<PHI_LOW, PHI_BITS, true >(a, b));
+            store16x8(&z0[i],  field8<Z0_LOW,  Z0_BITS,  true >(a, b));
+            __m256i vid = field8<ID_LOW, ID_BITS, false>(a, b);
+            __m128i id16 = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packs_epi32(vid, vid), _MM_SHUFFLE(3,1,2,0)));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(&id[i]), _mm_packus_epi16(id16, id16));
+        }
+        return i;
+    }
+#endif
+};
+
+#endif
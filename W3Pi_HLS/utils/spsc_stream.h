@@ -0,0 +1,288 @@
+#ifndef SPSC_STREAM_H
+#define SPSC_STREAM_H
+
+/**************************************************
+ * Bounded single-producer single-consumer streams for host-side threads
+ *
+ * w3p_dataflow::stream<T> has the interface of hls::stream (read, write, the non-blocking
+ * variants, <<, >>, empty, full, size), with one producer and one consumer thread:
+ *  - it is bounded to the depth given with configure() (0, the default: unbounded); a thread
+ *    blocks when it writes to a full stream or reads from an empty one
+ *  - a thread blocked for more than W3P_STREAM_TIMEOUT_MS (default 10 s) is a deadlock, or a
+ *    stream too shallow: the stream is printed and the program aborts
+ *  - each configured stream records its writes, high-water mark (largest occupancy), write
+ *    stalls (writes finding it full) and read stalls (reads finding it empty); the numbers are
+ *    summed over all the streams with the same name, and printed by print_stream_stats()
+ * It is a lock-free queue, with the number of elements written and read as the only shared
+ * state: a configured stream (depth > 0) is a ring of depth slots allocated by configure(); an
+ * unbounded one (e.g. the testbench input FIFOs) is a list of blocks of BLOCK elements.
+ * w3p_dataflow::Region runs processes in their own threads, and joins them.
+ **************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef W3P_STREAM_TIMEOUT_MS
+#define W3P_STREAM_TIMEOUT_MS 10000
+#endif
+
+namespace w3p_dataflow {
+
+    struct StreamStats {
+        std::string name;
+        unsigned int depth = 0;        // 0: unbounded
+        unsigned int instances = 0;    // streams (calls) summed in these numbers
+        uint64_t writes = 0, high_water = 0, write_stalls = 0, read_stalls = 0;
+    };
+
+    // Statistics of all the configured streams, by name
+    inline std::map<std::string, StreamStats> & stream_stats()
+    {
+        static std::map<std::string, StreamStats> stats;
+        return stats;
+    }
+    inline std::mutex & stream_stats_mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    inline void record_stream_stats(const StreamStats & s)
+    {
+        std::lock_guard<std::mutex> lock(stream_stats_mutex());
+        StreamStats & tot = stream_stats()[s.name];
+        tot.name = s.name;
+        tot.depth = s.depth;
+        tot.instances += 1;
+        tot.writes += s.writes;
+        tot.high_water = std::max(tot.high_water, s.high_water);
+        tot.write_stalls += s.write_stalls;
+        tot.read_stalls += s.read_stalls;
+    }
+
+    inline void reset_stream_stats()
+    {
+        std::lock_guard<std::mutex> lock(stream_stats_mutex());
+        stream_stats().clear();
+    }
+
+    inline void print_stream_stats(FILE * out = stdout)
+    {
+        std::lock_guard<std::mutex> lock(stream_stats_mutex());
+        fprintf(out, "%-36s %6s %6s %10s %10s %12s %12s\n", "stream", "depth", "calls", "writes", "high-water", "write stalls", "read stalls");
+        for (const auto & it : stream_stats())
+        {
+            const StreamStats & s = it.second;
+            fprintf(out, "%-36s %6u %6u %10llu %10llu %12llu %12llu\n", s.name.c_str(), s.depth, s.instances,
+                    (unsigned long long) s.writes, (unsigned long long) s.high_water,
+                    (unsigned long long) s.write_stalls, (unsigned long long) s.read_stalls);
+        }
+    }
+
+    // Busy wait: spin, then yield, then sleep, so that idle threads leave the cores to the others
+    inline void backoff(unsigned int spin)
+    {
+        if (spin < 64) return;
+        if (spin < 1024) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+
+    // Wait for ready(), abort after W3P_STREAM_TIMEOUT_MS
+    template<typename Ready>
+    inline void wait_for(Ready ready, const std::string & name, const char * what)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int spin = 0; !ready(); ++spin)
+        {
+            backoff(spin);
+            if ((spin & 255) == 0 && std::chrono::steady_clock::now() - start > std::chrono::milliseconds(W3P_STREAM_TIMEOUT_MS))
+            {
+                fprintf(stderr, "w3p_stream %s: blocked on %s for more than %d ms (deadlock, or stream too shallow)\n",
+                        name.empty() ? "(unnamed)" : name.c_str(), what, W3P_STREAM_TIMEOUT_MS);
+                std::abort();
+            }
+        }
+    }
+
+    template<typename T>
+    class stream {
+      public:
+        static constexpr uint64_t BLOCK = 64;
+
+        stream() : head_(new Block), tail_(head_) {}
+        explicit stream(const char * name) : stream() { stats_.name = name; }
+        stream(const stream &) = delete;
+        stream & operator=(const stream &) = delete;
+        ~stream()
+        {
+            if (configured_) record_stream_stats(stats_);
+            delete[] ring_;
+            while (head_)
+            {
+                Block * next = head_->next.load(std::memory_order_relaxed);
+                delete head_;
+                head_ = next;
+            }
+        }
+
+        // Name and depth of the stream (0: unbounded), before the processes start and the first write
+        void configure(const std::string & name, unsigned int depth)
+        {
+            stats_.name = name;
+            stats_.depth = depth;
+            configured_ = true;
+            if (depth > 0)
+            {
+                delete[] ring_;
+                ring_ = new T[depth];
+                wpos_ = rpos_ = 0;
+                delete head_;
+                head_ = tail_ = nullptr;
+            }
+        }
+
+        // Producer
+        void write(const T & value)
+        {
+            uint64_t n = pushed_.load(std::memory_order_relaxed);
+            if (!can_write(n))
+            {
+                stats_.write_stalls++;
+                wait_for([&]() { return can_write(n); }, stats_.name, "write (full)");
+            }
+            push(n, value);
+        }
+        bool write_nb(const T & value)
+        {
+            uint64_t n = pushed_.load(std::memory_order_relaxed);
+            if (!can_write(n)) return false;
+            push(n, value);
+            return true;
+        }
+        void operator<<(const T & value) { write(value); }
+
+        // Consumer
+        T read()
+        {
+            uint64_t n = popped_.load(std::memory_order_relaxed);
+            if (!can_read(n))
+            {
+                stats_.read_stalls++;
+                wait_for([&]() { return can_read(n); }, stats_.name, "read (empty)");
+            }
+            return pop(n);
+        }
+        void read(T & value) { value = read(); }
+        bool read_nb(T & value)
+        {
+            uint64_t n = popped_.load(std::memory_order_relaxed);
+            if (!can_read(n)) return false;
+            value = pop(n);
+            return true;
+        }
+        void operator>>(T & value) { value = read(); }
+
+        bool empty() const { return size() == 0; }
+        bool full() const { return stats_.depth && size() >= stats_.depth; }
+        size_t size() const { return pushed_.load(std::memory_order_acquire) - popped_.load(std::memory_order_acquire); }
+
+      private:
+        struct Block {
+            T data[BLOCK];
+            std::atomic<Block *> next{nullptr};
+        };
+
+        bool can_write(uint64_t n) const { return !stats_.depth || n - popped_.load(std::memory_order_acquire) < stats_.depth; }
+        bool can_read(uint64_t n) const { return pushed_.load(std::memory_order_acquire) != n; }
+
+        // Ring: the producer writes a slot only once the consumer has read it (can_write).
+        // Blocks: the producer links a new block before publishing its first element, the
+        // consumer frees a block when it moves to the next one (the producer has already left it)
+        void push(uint64_t n, const T & value)
+        {
+            if (ring_)
+            {
+                ring_[wpos_] = value;
+                if (++wpos_ == stats_.depth) wpos_ = 0;
+            }
+            else
+            {
+                if (n % BLOCK == 0 && n > 0)
+                {
+                    Block * b = new Block;
+                    tail_->next.store(b, std::memory_order_release);
+                    tail_ = b;
+                }
+                tail_->data[n % BLOCK] = value;
+            }
+            pushed_.store(n + 1, std::memory_order_release);
+            stats_.writes++;
+            stats_.high_water = std::max<uint64_t>(stats_.high_water, n + 1 - popped_.load(std::memory_order_acquire));
+        }
+        T pop(uint64_t n)
+        {
+            T value;
+            if (ring_)
+            {
+                value = ring_[rpos_];
+                if (++rpos_ == stats_.depth) rpos_ = 0;
+            }
+            else
+            {
+                if (n % BLOCK == 0 && n > 0)
+                {
+                    Block * b = head_->next.load(std::memory_order_acquire);
+                    delete head_;
+                    head_ = b;
+                }
+                value = head_->data[n % BLOCK];
+            }
+            popped_.store(n + 1, std::memory_order_release);
+            return value;
+        }
+
+        T * ring_ = nullptr;       // depth slots of a configured stream
+        unsigned int wpos_ = 0;    // next slot to write (producer side)
+        unsigned int rpos_ = 0;    // next slot to read (consumer side)
+        Block * head_; // consumer side
+        Block * tail_; // producer side
+        std::atomic<uint64_t> pushed_{0}, popped_{0};
+        // Written by the producer (writes, high-water, write stalls) or the consumer (read stalls)
+        StreamStats stats_;
+        bool configured_ = false;
+    };
+
+    // Processes of a dataflow region, one thread each; join() waits for all of them
+    class Region {
+      public:
+        Region() {}
+        Region(const Region &) = delete;
+        Region & operator=(const Region &) = delete;
+        ~Region() { join(); }
+
+        template<typename F>
+        void spawn(F && process) { threads_.emplace_back(std::forward<F>(process)); }
+
+        void join()
+        {
+            for (std::thread & t : threads_) t.join();
+            threads_.clear();
+        }
+
+      private:
+        std::vector<std::thread> threads_;
+    };
+
+} // namespace
+
+#endif
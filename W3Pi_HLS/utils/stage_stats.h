@@ -0,0 +1,269 @@
+#ifndef STAGE_STATS_H
+#define STAGE_STATS_H
+
+/**************************************************
+ * Per-stage counters and timing of the event processing
+ *
+ * The reference, the emulators and the C-simulation of the kernels record, per event:
+ *  - W3P_STATS_COUNT(name, value): a count (candidates after a selection, triplets built...)
+ *  - W3P_STATS_CLOCK(clock) starts a clock, W3P_STATS_LAP(clock, name) records the time since
+ *    the start or the previous lap as stage name, and restarts the clock
+ *  - W3P_STATS_ONLY(code): code that only computes inputs of the counters
+ * Without -DW3P_STAGE_STATS (and always under __SYNTHESIS__) the macros are empty and their
+ * arguments are not evaluated: the instrumentation can stay in the code at no cost.
+ *
+ * With -DW3P_STAGE_STATS each thread fills its own histograms, without locks: counts in bins
+ * of one unit up to NBINS-2 (the last bin is the overflow), times in bins of powers of two of
+ * the clock ticks (rdtsc on x86, steady_clock ns otherwise). The histograms of a thread are
+ * merged into the totals when it exits, and stats() merges them with those of the running
+ * threads, so it must be called when these are idle (e.g. after joining them). The totals are
+ * printed by print_stats() (quantiles are the lower edges of their bins) and written as JSON
+ * by write_stats_json().
+ **************************************************/
+
+#if defined(W3P_STAGE_STATS) && !defined(__SYNTHESIS__)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define W3P_STATS_RDTSC 1
+#else
+#define W3P_STATS_RDTSC 0
+#endif
+
+namespace w3p_stats {
+
+    inline uint64_t ticks()
+    {
+#if W3P_STATS_RDTSC
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    struct Histogram {
+        static constexpr unsigned int NBINS = 258;
+        bool log = false;          // bins of powers of two (times) instead of units (counts)
+        uint64_t n = 0, sum = 0, max = 0;
+        uint64_t bins[NBINS] = {};
+
+        static unsigned int bin(uint64_t value, bool log)
+        {
+            if (log) return value ? 64 - __builtin_clzll(value) : 0;   // bin b: [2^(b-1), 2^b)
+            return value < NBINS - 1 ? value : NBINS - 1;
+        }
+        // Lower edge of bin b
+        uint64_t low(unsigned int b) const { return log ? (b ? uint64_t(1) << (b - 1) : 0) : b; }
+
+        void fill(uint64_t value)
+        {
+            n++;
+            sum += value;
+            max = std::max(max, value);
+            bins[bin(value, log)]++;
+        }
+        void merge(const Histogram & o)
+        {
+            n += o.n;
+            sum += o.sum;
+            max = std::max(max, o.max);
+            for (unsigned int b = 0; b < NBINS; b++) bins[b] += o.bins[b];
+        }
+        double mean() const { return n ? double(sum) / n : 0; }
+        // Lower edge of the bin of the q quantile
+        uint64_t quantile(double q) const
+        {
+            uint64_t seen = 0;
+            for (unsigned int b = 0; b < NBINS; b++)
+            {
+                seen += bins[b];
+                if (seen > q * n) return low(b);
+            }
+            return max;
+        }
+    };
+
+    struct Recorder;
+
+    // Names of the counters and stages, in the order of their first use
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::string> names;
+        std::vector<bool> log;
+        std::map<std::string, Histogram> retired;     // merged from the threads that exited
+        std::set<Recorder *> live;
+        uint64_t tick0 = ticks();
+        std::chrono::steady_clock::time_point time0 = std::chrono::steady_clock::now();
+    };
+    inline Registry & registry()
+    {
+        static Registry r;
+        return r;
+    }
+
+    inline unsigned int probe(const char * name, bool log)
+    {
+        Registry & r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (unsigned int i = 0; i < r.names.size(); i++)
+            if (r.names[i] == name) return i;
+        r.names.push_back(name);
+        r.log.push_back(log);
+        return r.names.size() - 1;
+    }
+
+    // Histograms of one thread, by probe
+    struct Recorder {
+        std::vector<Histogram> histograms;
+
+        Recorder()
+        {
+            Registry & r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.live.insert(this);
+        }
+        ~Recorder()
+        {
+            Registry & r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            merge_into(r, r.retired);
+            r.live.erase(this);
+        }
+
+        void fill(unsigned int id, bool log, uint64_t value)
+        {
+            if (id >= histograms.size()) histograms.resize(id + 1);
+            Histogram & h = histograms[id];
+            h.log = log;
+            h.fill(value);
+        }
+
+        // Caller holds the registry mutex
+        void merge_into(const Registry & r, std::map<std::string, Histogram> & out) const
+        {
+            for (unsigned int i = 0; i < histograms.size(); i++)
+            {
+                if (!histograms[i].n) continue;
+                Histogram & h = out[r.names[i]];
+                h.log = r.log[i];
+                h.merge(histograms[i]);
+            }
+        }
+    };
+    inline Recorder & recorder()
+    {
+        thread_local Recorder r;
+        return r;
+    }
+
+    // Clock of W3P_STATS_CLOCK/W3P_STATS_LAP
+    struct Clock {
+        uint64_t last = ticks();
+        uint64_t lap() { uint64_t now = ticks(), d = now - last; last = now; return d; }
+    };
+
+    // Totals of all the threads, by name
+    inline std::map<std::string, Histogram> stats()
+    {
+        Registry & r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        std::map<std::string, Histogram> out = r.retired;
+        for (const Recorder * rec : r.live) rec->merge_into(r, out);
+        return out;
+    }
+
+    // Clock ticks per ns, measured since the start of the program
+    inline double ticks_per_ns()
+    {
+#if W3P_STATS_RDTSC
+        const Registry & r = registry();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - r.time0).count();
+        return ns > 0 ? (ticks() - r.tick0) / ns : 1;
+#else
+        return 1;
+#endif
+    }
+
+    inline void print_stats(FILE * out = stdout)
+    {
+        std::map<std::string, Histogram> all = stats();
+        double tpn = ticks_per_ns();
+        fprintf(out, "%-32s %10s %10s %10s %10s %10s\n", "counter", "events", "mean", "p50", "p99", "max");
+        for (const auto & it : all)
+            if (!it.second.log)
+                fprintf(out, "%-32s %10llu %10.2f %10llu %10llu %10llu\n", it.first.c_str(), (unsigned long long) it.second.n, it.second.mean(),
+                        (unsigned long long) it.second.quantile(0.5), (unsigned long long) it.second.quantile(0.99), (unsigned long long) it.second.max);
+        fprintf(out, "%-32s %10s %10s %10s %10s %10s\n", "stage (ns)", "events", "mean", "p50", "p99", "max");
+        for (const auto & it : all)
+            if (it.second.log)
+                fprintf(out, "%-32s %10llu %10.1f %10.0f %10.0f %10.0f\n", it.first.c_str(), (unsigned long long) it.second.n, it.second.mean() / tpn,
+                        it.second.quantile(0.5) / tpn, it.second.quantile(0.99) / tpn, it.second.max / tpn);
+    }
+
+    // {"clock": ..., "ticks_per_ns": ..., "counters": {name: {...}}, "stages": {name: {...}}}, with
+    // the non-empty bins as [lower edge, events] (ticks for the stages)
+    inline bool write_stats_json(const std::string & name)
+    {
+        FILE * out = fopen(name.c_str(), "w");
+        if (!out) return false;
+        std::map<std::string, Histogram> all = stats();
+        fprintf(out, "{\"clock\": \"%s\", \"ticks_per_ns\": %.4f", W3P_STATS_RDTSC ? "rdtsc" : "steady_clock", ticks_per_ns());
+        for (int log = 0; log < 2; log++)
+        {
+            fprintf(out, ",\n \"%s\": {", log ? "stages" : "counters");
+            const char * sep = "";
+            for (const auto & it : all)
+            {
+                const Histogram & h = it.second;
+                if (h.log != bool(log)) continue;
+                fprintf(out, "%s\n  \"%s\": {\"events\": %llu, \"sum\": %llu, \"mean\": %.3f, \"max\": %llu, \"bins\": [", sep, it.first.c_str(),
+                        (unsigned long long) h.n, (unsigned long long) h.sum, h.mean(), (unsigned long long) h.max);
+                const char * bsep = "";
+                for (unsigned int b = 0; b < Histogram::NBINS; b++)
+                    if (h.bins[b])
+                    {
+                        fprintf(out, "%s[%llu, %llu]", bsep, (unsigned long long) h.low(b), (unsigned long long) h.bins[b]);
+                        bsep = ", ";
+                    }
+                fprintf(out, "]}");
+                sep = ",";
+            }
+            fprintf(out, "\n }");
+        }
+        fprintf(out, "\n}\n");
+        fclose(out);
+        return true;
+    }
+
+} // namespace w3p_stats
+
+#define W3P_STATS_COUNT(name, value) do { \
+        static const unsigned int w3p_stats_id_ = w3p_stats::probe(name, false); \
+        w3p_stats::recorder().fill(w3p_stats_id_, false, (value)); \
+    } while (0)
+#define W3P_STATS_CLOCK(clock) w3p_stats::Clock clock
+#define W3P_STATS_LAP(clock, name) do { \
+        static const unsigned int w3p_stats_id_ = w3p_stats::probe(name, true); \
+        w3p_stats::recorder().fill(w3p_stats_id_, true, clock.lap()); \
+    } while (0)
+#define W3P_STATS_ONLY(...) __VA_ARGS__
+
+#else
+
+#define W3P_STATS_COUNT(name, value) do {} while (0)
+#define W3P_STATS_CLOCK(clock) do {} while (0)
+#define W3P_STATS_LAP(clock, name) do {} while (0)
+#define W3P_STATS_ONLY(...)
+
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef TRIPLET_MASS_H
+#define TRIPLET_MASS_H
+
+#include "w3p_types.h"
+#include "coscosh_lut.h"
+#include <cmath>
+#include <cstdint>
+
+/**************************************************
+ * Fixed-point invariant mass of three massless candidates
+ *
+ *   m^2 = sum_{i<j} 2 pT_i pT_j (cosh(deta_ij) - cos(dphi_ij))
+ *
+ * cos and cosh are read from lookup tables indexed by the hardware |dphi| and |deta|,
+ * in units of 1/COSCOSH_LSB. The tables are generated at compile time (coscosh_lut.h),
+ * and the mass window is applied on m^2, so no float, square root or trigonometric
+ * function is synthesized.
+ *
+ * The functions are templated on the Puppi type, so that event_processor and
+ * streamer_event_processor (each with its own data.h) share them: P needs hwPt, hwEta,
+ * hwPhi, INT_PI, INT_2PI, ETAPHI_LSB and ETA_CUT, and the tables cover the full |deta|
+ * range of two candidates with |hwEta| <= ETA_CUT.
+ **************************************************/
+
+#define COSCOSH_LSB 256    // LUT precision
+#define MASS_MIN 50        // [GeV]
+#define MASS_MAX 110       // [GeV]
+
+typedef w3p_int<10> cos_t;          // cos(dphi)*COSCOSH_LSB, in [-256, 256]
+typedef w3p_uint<14> cosh_t;        // cosh(deta)*COSCOSH_LSB, up to cosh(4.8)*256 = 15617
+typedef w3p_ufixed<44,40> mass2_t;  // m^2*COSCOSH_LSB/2 [GeV^2]
+
+// Lookup tables indexed by |dphi| and |deta|
+template<typename P>
+struct TripletMassLut {
+    static constexpr int COS_SIZE = P::INT_PI + 1;             // |dphi| in [0, pi]
+    static constexpr int COSH_SIZE = 2*int(P::ETA_CUT) + 2;    // |deta| in [0, 2*ETA_CUT]
+    static constexpr coscosh::Table<int16_t, COS_SIZE> COS = coscosh::makeTable<int16_t, COS_SIZE>(P::ETAPHI_LSB, COSCOSH_LSB, false);
+    static constexpr coscosh::Table<uint16_t, COSH_SIZE> COSH = coscosh::makeTable<uint16_t, COSH_SIZE>(P::ETAPHI_LSB, COSCOSH_LSB, true);
+};
+template<typename P> constexpr coscosh::Table<int16_t, TripletMassLut<P>::COS_SIZE> TripletMassLut<P>::COS;
+template<typename P> constexpr coscosh::Table<uint16_t, TripletMassLut<P>::COSH_SIZE> TripletMassLut<P>::COSH;
+
+// pT_i*pT_j*(cosh(deta) - cos(dphi)), i.e. the pair contribution to m^2*COSCOSH_LSB/2
+template<typename P>
+inline mass2_t pair_mass2(const P & a, const P & b)
+{
+    #pragma HLS inline
+
+    // dPhi with protections against values above pi
+    auto dphi = a.hwPhi - b.hwPhi;
+    if (dphi > P::INT_PI)
+        dphi -= P::INT_2PI;
+    else if (dphi < -P::INT_PI)
+        dphi += P::INT_2PI;
+    auto deta = a.hwEta - b.hwEta;
+
+    // LUT indexes, clipped to the table sizes (only reached by candidates beyond ETA_CUT)
+    int iphi = dphi < 0 ? -dphi.to_int() : dphi.to_int();
+    int ieta = deta < 0 ? -deta.to_int() : deta.to_int();
+    if (iphi >= TripletMassLut<P>::COS_SIZE) iphi = TripletMassLut<P>::COS_SIZE - 1;
+    if (ieta >= TripletMassLut<P>::COSH_SIZE) ieta = TripletMassLut<P>::COSH_SIZE - 1;
+
+    cos_t cosdphi = TripletMassLut<P>::COS.v[iphi];
+    cosh_t coshdeta = TripletMassLut<P>::COSH.v[ieta];
+    return a.hwPt * b.hwPt * (coshdeta - cosdphi);
+}
+
+// m^2*COSCOSH_LSB/2 of the triplet
+template<typename P>
+inline mass2_t triplet_mass2(const P & p0, const P & p1, const P & p2)
+{
+    #pragma HLS inline
+    return pair_mass2(p0, p1) + pair_mass2(p0, p2) + pair_mass2(p1, p2);
+}
+
+// MASS_MIN <= m <= MASS_MAX
+template<typename P>
+inline bool triplet_mass_window(const P & p0, const P & p1, const P & p2)
+{
+    #pragma HLS inline
+    mass2_t m2 = triplet_mass2(p0, p1, p2);
+    return (m2 >= MASS_MIN*MASS_MIN*COSCOSH_LSB/2) && (m2 <= MASS_MAX*MASS_MAX*COSCOSH_LSB/2);
+}
+
+// Triplet selections of filter_triplets: sum of the charges = +/-1, pT >= 15/4/3 GeV, mass window
+template<typename P>
+inline bool triplet_selection(const P & p0, const P & p1, const P & p2)
+{
+    #pragma HLS inline
+    int charge = p0.charge() + p1.charge() + p2.charge();
+    return (charge == 1 || charge == -1) &&
+           (p0.hwPt >= 15) && (p1.hwPt >= 4) && (p2.hwPt >= 3) &&
+           triplet_mass_window(p0, p1, p2);
+}
+
+// Mass in GeV (printout and validation only)
+inline float floatMass(mass2_t m2) { return std::sqrt(m2.to_float() * 2 / COSCOSH_LSB); }
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef W3P_STREAM_H
+#define W3P_STREAM_H
+
+#include "hls_stream.h"
+
+/**************************************************
+ * Streams used by the W3Pi dataflow kernels
+ *
+ * By default w3p_stream is hls::stream. Compiling with -DW3P_THREADED_DATAFLOW (C-simulation
+ * only, link with -pthread) switches it to the bounded stream of spsc_stream.h, with the same
+ * interface, and the dataflow regions of the kernels run each process in its own thread
+ * (w3p_dataflow::Region) instead of one after the other. Then the streams between processes
+ * are configured with the depth of their HLS stream pragma (2 by default in HLS), so deadlocks
+ * and streams too shallow show up as in hardware, and their occupancy and stalls are recorded.
+ * Streams that are not configured (the ports of the top functions, filled by the testbenches
+ * before the call) are unbounded and not recorded.
+ **************************************************/
+
+#ifdef W3P_THREADED_DATAFLOW
+
+#ifdef __SYNTHESIS__
+#error "W3P_THREADED_DATAFLOW is only meant for C-simulation"
+#endif
+
+#include "spsc_stream.h"
+
+template<typename T> using w3p_stream = w3p_dataflow::stream<T>;
+
+#else
+
+template<typename T> using w3p_stream = hls::stream<T>;
+
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef W3P_TYPES_H
+#define W3P_TYPES_H
+
+#include "ap_int.h"
+#include "ap_fixed.h"
+
+/**************************************************
+ * Arbitrary precision types used by the W3Pi kernels
+ *
+ * By default these are the Vitis HLS ap_types. Compiling with -DW3P_NATIVE_TYPES switches
+ * them to the bit-exact native-integer implementation of native_types.h, so that the same
+ * kernel sources build as a fast CPU emulator (C-simulation and replay only).
+ **************************************************/
+
+#ifdef W3P_NATIVE_TYPES
+
+#ifdef __SYNTHESIS__
+#error "W3P_NATIVE_TYPES is only meant for C-simulation"
+#endif
+
+#include "native_types.h"
+
+template<int W> using w3p_int = native::int_t<W>;
+template<int W> using w3p_uint = native::uint_t<W>;
+template<int W, int I, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP> using w3p_fixed = native::fixed_t<W,I,Q,O>;
+template<int W, int I, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP> using w3p_ufixed = native::ufixed_t<W,I,Q,O>;
+
+#else
+
+template<int W> using w3p_int = ap_int<W>;
+template<int W> using w3p_uint = ap_uint<W>;
+template<int W, int I, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP> using w3p_fixed = ap_fixed<W,I,Q,O>;
+template<int W, int I, ap_q_mode Q = AP_TRN, ap_o_mode O = AP_WRAP> using w3p_ufixed = ap_ufixed<W,I,Q,O>;
+
+#endif
+
+#endif